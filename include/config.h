@@ -1,6 +1,7 @@
 #ifndef CONFIG_H
 #define CONFIG_H
 
+#include <cstddef>  // size_t
 #include <cstdint>  // 整数型定義
 
 // ────────────────────── 設定 ──────────────────────
@@ -13,6 +14,36 @@
 // FPS表示を行うかどうか
 #define FPS_DISPLAY_ENABLED 0
 
+// 処理区間ごとの時間分布を計測するかどうか（メニュー画面とシリアル 'p' で確認）
+#define FRAME_PROFILER_ENABLED 0
+
+// センサー取得を別コアのタスクで行うかどうか（0 にすると loop() 内で逐次取得）
+#define DUAL_CORE_ACQUISITION_ENABLED 1
+
+// 転送用の第2バッファを確保し、DMA 転送と次のウィジェット・次フレームの描画を重ねるかどうか
+#define DOUBLE_BUFFER_ENABLED 1
+
+// 大きな数値表示の数字を起動時にキャンバスと同じ画素形式で描いておき、変化した桁だけを転写するかどうか
+#define VALUE_GLYPH_CACHE_ENABLED 1
+
+// ゲージの目盛・ラベルなどの静的な部分を背景レイヤーへ一度だけ描き、消去と再表示をその複写で行うかどうか
+#define GAUGE_BACKGROUND_LAYER_ENABLED 1
+
+// mainCanvas の画素形式（0: RGB565、4 / 8: パレット形式で描き、転送時に RGB565 へ展開してメモリを 1/4・1/2 にする）
+#define CANVAS_PALETTE_BITS 0
+
+// SD カードへセッションログを記録するかどうか（カードが無ければ自動で無効）
+#define SESSION_LOG_ENABLED 1
+
+// 最大値と直近の低油圧イベントを内蔵フラッシュへ保存し、起動時に復元するかどうか（パーティションが無ければ自動で無効）
+#define PERSISTENT_STORE_ENABLED 1
+
+// G と油圧の分布（油圧マップ）を記録し、メニューの次のページとシリアル 'h' で確認するかどうか
+#define OIL_STARVATION_MAP_ENABLED 1
+
+// 油圧を 1 段のカルマンフィルタで推定するかどうか（0 にすると移動平均と表示側 EMA の 2 段）
+#define OIL_PRESSURE_ESTIMATOR_ENABLED 1
+
 // ── センサー接続可否（0 にするとその項目は常に 0 表示） ──
 #define SENSOR_OIL_PRESSURE_PRESENT 1
 #define SENSOR_WATER_TEMP_PRESENT 1
@@ -52,6 +83,17 @@ constexpr float OIL_PRESSURE_DISCONNECT_THRESHOLD = 0.25f;
 // 油圧の平滑化係数
 // レスポンス向上のため平滑化係数を大きめに
 constexpr float OIL_PRESSURE_SMOOTHING_ALPHA = 0.3f;
+// 油圧の推定器 (OIL_PRESSURE_ESTIMATOR_ENABLED) の設計値
+// 測定雑音の標準偏差 [bar]。エンジン脈動を含めた停車中のばらつき
+constexpr float OIL_PRESSURE_NOISE_BAR = 0.05f;
+// 真値のゆらぎ [bar/√s]。大きいほど定常時の追従が速く、表示のばらつきが増える。
+// 0.066 で定常時の群遅延が従来の 2 段（約 47ms）と同程度になる
+constexpr float OIL_PRESSURE_DRIFT_BAR_PER_SQRT_S = 0.066f;
+// イノベーションが定常時の標準偏差のこの倍数を同じ向きに連続して超えたら段差とみなす
+constexpr float ESTIMATOR_STEP_GATE_SIGMA = 3.0f;
+constexpr int ESTIMATOR_STEP_CONFIRM_SAMPLES = 2;
+// 水温・油温表示の平滑化係数
+constexpr float TEMP_SMOOTHING_ALPHA = 0.1f;
 
 // ── 水温メーター設定 ──
 // 水温メーター下限と上限を80℃〜120℃に設定
@@ -93,14 +135,94 @@ constexpr unsigned long FPS_INTERVAL_MS = 1000UL;
 // 最大60FPSに制御するためのフレーム間隔 [us]
 constexpr unsigned long FRAME_INTERVAL_US = 1000000UL / 60;
 
+// ── ジョブの締め切り (DeadlineScheduler) ──
+// 入力処理は同じ周期の描画より先に終える [us]
+constexpr unsigned long INPUT_JOB_DEADLINE_US = 2000;
+// 照度による輝度更新 [us]
+constexpr unsigned long AMBIENT_LIGHT_JOB_DEADLINE_US = 100000;
+// 次のジョブまでこれ以上空くときは FreeRTOS へ CPU を返す [us]（tick は 1ms）
+constexpr unsigned long SCHEDULER_YIELD_MIN_US = 1000;
+
+// ── ADS1x15 変換器（外部 I2C: SDA=9, SCL=8） ──
+enum class AdcChip : uint8_t
+{
+  Ads1015,  // 12bit、1600SPS で使用
+  Ads1115,  // 16bit、860SPS で使用
+};
+
+struct AdcConverterConfig
+{
+  uint8_t address;  // 0x48〜0x4B（ADDR ピンの接続先）
+  AdcChip chip;
+};
+
+// 接続する変換器（最大 4 台）。センサーは記述子の adcDevice でこの並びの番号を指す
+constexpr AdcConverterConfig ADC_CONVERTERS[] = {
+    {0x48, AdcChip::Ads1015},
+};
+constexpr uint8_t ADC_CONVERTER_COUNT = sizeof(ADC_CONVERTERS) / sizeof(ADC_CONVERTERS[0]);
+constexpr uint8_t ADC_DEVICE_MAIN = 0;
+
 // ── ADS1015 のチャンネル定義 ──
 constexpr uint8_t ADC_CH_WATER_TEMP = 1;
 constexpr uint8_t ADC_CH_OIL_PRESSURE = 2;
 constexpr uint8_t ADC_CH_OIL_TEMP = 0;
 
+// 温度の変換要求間隔 [ms]。500ms ごとに取得する
+constexpr uint32_t TEMP_SAMPLE_INTERVAL_MS = 500;
+
 // サンプリング数設定
 constexpr int PRESSURE_SAMPLE_SIZE = 5;
 constexpr int WATER_TEMP_SAMPLE_SIZE = 2;  // 500ms間隔×2サンプルで約1秒平均
 constexpr int OIL_TEMP_SAMPLE_SIZE = 2;    // 500ms間隔×2サンプルで約1秒平均
 
+// ── センサー取得タスク ──
+// 描画ループ (Arduino の loop はコア1) と別のコアで取得する
+constexpr int SENSOR_TASK_CORE = 0;
+constexpr int SENSOR_TASK_PRIORITY = 2;
+constexpr uint32_t SENSOR_TASK_STACK_SIZE = 4096;
+// 取得周期 [ms]。60FPS の 1 フレームに約 4 回取得する
+constexpr uint32_t SENSOR_TASK_INTERVAL_MS = 4;
+// コア間キューの容量（2 のべき乗）
+constexpr size_t SENSOR_QUEUE_CAPACITY = 32;
+
+// ── 加速度 (IMU FIFO) ──
+// IMU の出力レート [Hz]。取得周期ごとに FIFO からまとめて読み出す（4ms で 3〜4 サンプル、1 フレームで約 13 サンプル）
+constexpr float IMU_FIFO_ODR_HZ = 800.0f;
+// 水平 G のローパスフィルタのカットオフ周波数 [Hz]。車体振動の折り返しを抑える
+constexpr float G_FILTER_CUTOFF_HZ = 20.0f;
+
+// ── セッションログ (SD カード) ──
+// CoreS3 の microSD は LCD と SPI バスを共有する
+constexpr int SD_SPI_SCK_PIN = 36;
+constexpr int SD_SPI_MISO_PIN = 35;
+constexpr int SD_SPI_MOSI_PIN = 37;
+constexpr int SD_SPI_CS_PIN = 4;
+constexpr uint32_t SD_SPI_FREQUENCY = 25000000;
+// 1 ブロック (512 バイト) の書き込みに見込む時間。次の描画までこれだけ空いているときだけ書き込む [us]
+constexpr unsigned long SESSION_LOG_WRITE_BUDGET_US = 4000;
+// 空き時間が無くてもこの時間を過ぎたら書き込む [us]
+constexpr unsigned long SESSION_LOG_DEADLINE_US = 100000;
+// ファイルを flush するブロック間隔
+constexpr uint32_t SESSION_LOG_SYNC_BLOCKS = 64;
+// ブロック数に達しなくても、書き込み途中のブロックを含めてこの間隔でファイルを flush する [ms]
+constexpr unsigned long SESSION_LOG_SYNC_INTERVAL_MS = 1000;
+// ファイルの同期（FAT の更新）に見込む時間。ブロックの書き込みとは別に、これだけ空いているときだけ同期する [us]
+constexpr unsigned long SESSION_LOG_SYNC_BUDGET_US = 12000;
+// 空き時間が無くてもこの時間を過ぎたら同期する [us]
+constexpr unsigned long SESSION_LOG_SYNC_DEADLINE_US = 1000000;
+
+// ── 永続ストア ──
+// 保存に使うデータパーティションの名前（partitions.csv）
+constexpr const char *PERSISTENT_STORE_PARTITION = "gaugestore";
+// RAM の値をフラッシュへ反映する間隔。この間の変化は 1 件の記録にまとめる [ms]
+constexpr unsigned long PERSISTENT_STORE_INTERVAL_MS = 2000;
+// 記録 1 件 (32 バイト) の書き込みに見込む時間 [us]
+constexpr unsigned long PERSISTENT_STORE_WRITE_BUDGET_US = 1000;
+// 空き時間が無くてもこの時間を過ぎたら書き込む [us]
+constexpr unsigned long PERSISTENT_STORE_DEADLINE_US = 1000000;
+// 油圧がこの値未満のまま PERSISTENT_STORE_STOPPED_MS 続いたらエンジン停止中とみなし、セクタの消去を許す [bar]
+constexpr float PERSISTENT_STORE_STOPPED_PRESSURE_BAR = 0.5f;
+constexpr unsigned long PERSISTENT_STORE_STOPPED_MS = 10000;
+
 #endif  // CONFIG_H
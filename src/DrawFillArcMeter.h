@@ -5,9 +5,14 @@
 
 #include <algorithm>
 #include <cmath>
+#include <cstdio>
 #include <cstring>
 #include <limits>
 
+#include "modules/canvas_palette.h"
+#include "modules/dirty_region.h"
+#include "modules/glyph_cache.h"
+
 // std::clamp が利用できない環境向けの簡易版
 template <typename T>
 static inline T clampValue(T val, T low, T high)
@@ -17,30 +22,227 @@ static inline T clampValue(T val, T low, T high)
   return val;
 }
 
-void drawFillArcMeter(M5Canvas &canvas, float value, float minValue, float maxValue, float threshold,
-                      uint16_t overThresholdColor, const char *unit, const char *label,
+// ────────────────────── ゲージ仕様 ──────────────────────
+constexpr int GAUGE_RADIUS = 70;       // 半円メーターの半径
+constexpr int GAUGE_ARC_WIDTH = 10;    // 弧の幅
+constexpr int GAUGE_MAX_TICKS = 64;    // 目盛線の最大数
+constexpr int GAUGE_MAX_LABELS = 16;   // 目盛ラベルの最大数
+constexpr int GAUGE_FONT0_CHAR_W = 6;  // Font0 の1文字幅
+constexpr int GAUGE_VALUE_WIDTH = 75;  // 数値表示欄の幅
+
+// ゲージの設定値（起動時に一度だけ GaugeSpec へ展開する）
+struct GaugeConfig
+{
+  float minValue;
+  float maxValue;
+  float threshold;
+  uint16_t overThresholdColor;
+  const char *unit;
+  const char *label;
+  float tickStep;       // 目盛の間隔（細かい目盛り）
+  float majorTickStep;  // 数字を表示する目盛間隔（負なら旧仕様）
+  float labelStart;     // ラベル描画を開始する値
+  int x;
+  int y;
+  bool isTemperature;  // 199℃以上をセンサー異常として扱うか
+};
+
+// 目盛線の端点
+struct GaugeTick
+{
+  int16_t x1;
+  int16_t y1;
+  int16_t x2;
+  int16_t y2;
+};
+
+// 目盛ラベルの描画位置と文字列
+struct GaugeLabel
+{
+  int16_t x;
+  int16_t y;
+  char text[6];
+};
+
+// 描画時に三角関数や文字列比較を行わないよう、座標を事前計算したゲージ仕様
+struct GaugeSpec
+{
+  float minValue;
+  float maxValue;
+  float threshold;
+  uint16_t overThresholdColor;  // キャンバスの色（canvasColor() 済み）
+  bool isTemperature;
+  int x;
+  int y;
+  int centerX;
+  int centerY;
+  int valueBaseX;
+  int valueCenterY;    // 数値表示の縦方向の中心
+  float angleScale;    // 値1あたりの角度
+  float redZoneAngle;  // レッドゾーン開始角度
+  int tickCount;
+  GaugeTick ticks[GAUGE_MAX_TICKS];
+  int labelCount;
+  GaugeLabel labels[GAUGE_MAX_LABELS];
+  char caption[30];  // "OIL.P / x100kPa" のような単位付きメーター名
+  int16_t captionX;
+  int16_t captionY;
+};
+
+// 値をメーター上の角度へ変換する
+static inline auto gaugeValueToAngle(const GaugeSpec &spec, float value) -> float
+{
+  return -270.0F + ((value - spec.minValue) * spec.angleScale);
+}
+
+// ────────────────────── ゲージ仕様の構築 ──────────────────────
+// 起動時に一度だけ呼び、目盛とラベルの座標を計算しておく
+GaugeSpec buildGaugeSpec(const GaugeConfig &config)
+{
+  GaugeSpec spec = {};
+  spec.minValue = config.minValue;
+  spec.maxValue = config.maxValue;
+  spec.threshold = config.threshold;
+  spec.overThresholdColor = canvasColor(config.overThresholdColor);
+  spec.isTemperature = config.isTemperature;
+  spec.x = config.x;
+  spec.y = config.y;
+
+  // 左端を 1px 固定しつつ数値表示位置は従来通りに保つ
+  spec.centerX = config.x + 1 + GAUGE_RADIUS;  // 半径 70px を考慮した中心X座標
+  spec.centerY = config.y + 90 - 10;           // スプライト内の中心Y座標
+  spec.valueBaseX = config.x + 160;            // 数値表示位置
+  spec.valueCenterY = spec.centerY + GAUGE_RADIUS - 20;
+  spec.angleScale = 270.0F / (config.maxValue - config.minValue);
+  spec.redZoneAngle = gaugeValueToAngle(spec, config.threshold);
+
+  int tickCount = static_cast<int>((config.maxValue - config.minValue) / config.tickStep) + 1;
+  tickCount = std::min(tickCount, GAUGE_MAX_TICKS);
+  for (int i = 0; i < tickCount; ++i)
+  {
+    float scaledValue = config.minValue + (config.tickStep * i);
+    float angle = 270 - ((270.0 / (tickCount - 1)) * i);  // 開始位置のロジックを維持
+    float rad = angle * (M_PI / 180.0);
+    float cosA = cosf(rad);
+    float sinA = sinf(rad);
+
+    // 主要目盛かどうかを判定（majorTickStep が負なら従来と同じ判定）
+    bool isMajorTick;
+    if (config.majorTickStep < 0)
+    {
+      isMajorTick = (fmod(scaledValue, 1.0f) == 0.0f);
+    }
+    else
+    {
+      float diff = fmod(scaledValue - config.labelStart, config.majorTickStep);
+      isMajorTick = (scaledValue >= config.labelStart) &&
+                    (fabsf(diff) < 0.01f || fabsf(diff - config.majorTickStep) < 0.01f);
+    }
+
+    // 主要目盛は長めの線、細かい目盛は短めの線
+    int innerRadius = isMajorTick ? (GAUGE_RADIUS - GAUGE_ARC_WIDTH - 10) : (GAUGE_RADIUS - GAUGE_ARC_WIDTH - 8);
+    int outerRadius = isMajorTick ? (GAUGE_RADIUS - GAUGE_ARC_WIDTH - 5) : (GAUGE_RADIUS - GAUGE_ARC_WIDTH - 7);
+
+    GaugeTick &tick = spec.ticks[i];
+    tick.x1 = static_cast<int16_t>(spec.centerX + (cosA * innerRadius));
+    tick.y1 = static_cast<int16_t>(spec.centerY - (sinA * innerRadius));
+    tick.x2 = static_cast<int16_t>(spec.centerX + (cosA * outerRadius));
+    tick.y2 = static_cast<int16_t>(spec.centerY - (sinA * outerRadius));
+
+    if (isMajorTick && spec.labelCount < GAUGE_MAX_LABELS)
+    {
+      GaugeLabel &label = spec.labels[spec.labelCount++];
+      int labelX = static_cast<int>(spec.centerX + (cosA * (GAUGE_RADIUS - GAUGE_ARC_WIDTH - 15)));
+      int labelY = static_cast<int>(spec.centerY - (sinA * (GAUGE_RADIUS - GAUGE_ARC_WIDTH - 15)));
+      snprintf(label.text, sizeof(label.text), "%.0f", scaledValue);
+      int textWidth = static_cast<int>(strlen(label.text)) * GAUGE_FONT0_CHAR_W;
+      label.x = static_cast<int16_t>(labelX - (textWidth / 2));
+      label.y = static_cast<int16_t>(labelY - 4);
+    }
+  }
+  spec.tickCount = tickCount;
+
+  // 単位とメーター名
+  snprintf(spec.caption, sizeof(spec.caption), "%s / %s", config.label, config.unit);
+  int captionWidth = static_cast<int>(strlen(spec.caption)) * GAUGE_FONT0_CHAR_W;
+  spec.captionX = static_cast<int16_t>(spec.centerX + 8 - (captionWidth / 2));
+  spec.captionY = static_cast<int16_t>(spec.centerY + GAUGE_RADIUS + 12);
+  return spec;
+}
+
+// ────────────────────── ゲージの静的な部分 ──────────────────────
+// 値 0 のバー（背景色の弧）・レッドゾーン・目盛・ラベル・メーター名を描く。背景レイヤーを作るときに一度だけ呼ぶ
+// （背景レイヤーが無い場合は静的描画のたびに呼ぶ）。更新領域は記録しない
+void drawGaugeFace(M5Canvas &canvas, const GaugeSpec &spec)
+{
+  const int RADIUS = GAUGE_RADIUS;
+  const int ARC_WIDTH = GAUGE_ARC_WIDTH;
+
+  canvas.fillArc(spec.centerX, spec.centerY, RADIUS - ARC_WIDTH, RADIUS, -270, 0, canvasColor(0x18E3));
+
+  // レッドゾーンの背景を描画
+  // 背景グレーと 1px の隙間を空け常に赤で表示する
+  canvas.fillArc(spec.centerX, spec.centerY,
+                 RADIUS - ARC_WIDTH - 9,  // 内側半径
+                 RADIUS - ARC_WIDTH - 4,  // 外側半径
+                 spec.redZoneAngle, 0,
+                 canvasColor(COLOR_RED));  // レッドゾーンは常に赤表示
+
+  // 事前計算済みの目盛り線とラベルを描画
+  for (int i = 0; i < spec.tickCount; ++i)
+  {
+    const GaugeTick &tick = spec.ticks[i];
+    canvas.drawLine(tick.x1, tick.y1, tick.x2, tick.y2, canvasColor(COLOR_WHITE));
+  }
+
+  canvas.setTextFont(1);
+  canvas.setFont(&fonts::Font0);
+  canvas.setTextColor(canvasColor(COLOR_WHITE), canvasColor(COLOR_BLACK));
+  for (int i = 0; i < spec.labelCount; ++i)
+  {
+    const GaugeLabel &label = spec.labels[i];
+    canvas.setCursor(label.x, label.y);
+    canvas.print(label.text);
+  }
+
+  // 単位とメーター名を表示
+  canvas.setCursor(spec.captionX, spec.captionY);
+  canvas.print(spec.caption);
+}
+
+// ────────────────────── ゲージ描画 ──────────────────────
+void drawFillArcMeter(M5Canvas &canvas, const GaugeSpec &spec, float value,
                       float &previousValue,  // 前回描画した値
-                      float tickStep,        // 目盛の間隔（細かい目盛り）
                       bool isUseDecimal,     // 小数点を表示するかどうか
-                      int x, int y, bool drawStatic,
-                      float majorTickStep = -1.0f,  // 数字を表示する目盛間隔（負なら旧仕様）
-                      float labelStart = 0.0f)      // ラベル描画を開始する値
+                      bool drawStatic,
+                      GlyphField *valueField = nullptr,         // 数字グリフのキャッシュで描く数値欄
+                      const M5Canvas *background = nullptr)  // drawGaugeFace() 済みの背景レイヤー
 {
-  // 左端を 1px 固定しつつ数値表示位置は従来通りに保つ
-  const int GAUGE_LEFT = x + 1;                    // 円メーターの左端
-  const int CENTER_X_CORRECTED = GAUGE_LEFT + 70;  // 半径 70px を考慮した中心X座標
-  const int VALUE_BASE_X = x + 160;                // 数値表示位置
-  const int CENTER_Y_CORRECTED = y + 90 - 10;      // スプライト内の中心Y座標
-  const int RADIUS = 70;                           // 半円メーターの半径
-  const int ARC_WIDTH = 10;                        // 弧の幅
-
-  const uint16_t BACKGROUND_COLOR = COLOR_BLACK;  // 背景色
-  const uint16_t ACTIVE_COLOR = COLOR_WHITE;      // 現在の値の色
-  const uint16_t INACTIVE_COLOR = 0x18E3;         // メーター全体の背景色
-  const uint16_t TEXT_COLOR = COLOR_WHITE;        // テキストの色
+  const int CENTER_X_CORRECTED = spec.centerX;
+  const int CENTER_Y_CORRECTED = spec.centerY;
+  const int RADIUS = GAUGE_RADIUS;
+  const int ARC_WIDTH = GAUGE_ARC_WIDTH;
+  const float minValue = spec.minValue;
+  const float maxValue = spec.maxValue;
+
+  const uint16_t BACKGROUND_COLOR = canvasColor(COLOR_BLACK);  // 背景色
+  const uint16_t ACTIVE_COLOR = canvasColor(COLOR_WHITE);      // 現在の値の色
+  const uint16_t INACTIVE_COLOR = canvasColor(0x18E3);         // メーター全体の背景色
+  const uint16_t TEXT_COLOR = canvasColor(COLOR_WHITE);        // テキストの色
+  const int GAUGE_W = 160;                        // ゲージ全体の幅
+  const int GAUGE_H = 170;                        // ゲージ全体の高さ
+
+  // バーの弧を塗り、更新領域として記録する
+  auto fillBarArc = [&](float startAngle, float endAngle, uint16_t color)
+  {
+    canvas.fillArc(CENTER_X_CORRECTED, CENTER_Y_CORRECTED, RADIUS - ARC_WIDTH, RADIUS, startAngle, endAngle, color);
+    frameDirtyRegions.markArc(CENTER_X_CORRECTED, CENTER_Y_CORRECTED, RADIUS - ARC_WIDTH, RADIUS, startAngle,
+                              endAngle);
+  };
+
 
   // 温度が199℃以上ならセンサー異常として扱う
-  if (strcmp(unit, "Celsius") == 0 && value >= 199.0f)
+  if (spec.isTemperature && value >= 199.0f)
   {
     value = 0.0f;
   }
@@ -53,54 +255,49 @@ void drawFillArcMeter(M5Canvas &canvas, float value, float minValue, float maxVa
     clampedValue = maxValue;
 
   // 初回は全体を描画してキャッシュを初期化
-  if (drawStatic || std::isnan(previousValue))
+  if (drawStatic)
   {
-    canvas.fillArc(CENTER_X_CORRECTED, CENTER_Y_CORRECTED, RADIUS - ARC_WIDTH, RADIUS, -270, 0, INACTIVE_COLOR);
+    // 静的部分を描き直す場合はゲージ全体を転送対象にする。背景レイヤーがあれば 1 回の複写で済ませる
+    restoreCanvasRect(canvas, background, spec.x, spec.y, GAUGE_W, GAUGE_H, BACKGROUND_COLOR);
+    if (background == nullptr)
+    {
+      drawGaugeFace(canvas, spec);
+    }
+    frameDirtyRegions.markRect(spec.x, spec.y, GAUGE_W, GAUGE_H);
     // 初期値を0にして次の処理でバーを全描画
     // 温度や油圧の初期表示を0とするため
     previousValue = 0.0f;
   }
-
-  if (drawStatic)
+  else if (std::isnan(previousValue))
   {
-    // レッドゾーンの背景を描画
-    // 背景グレーと 1px の隙間を空け常に赤で表示する
-    float redZoneStartAngle = -270 + ((threshold - minValue) / (maxValue - minValue) * 270.0);
-    canvas.fillArc(CENTER_X_CORRECTED, CENTER_Y_CORRECTED,
-                   RADIUS - ARC_WIDTH - 9,  // 内側半径
-                   RADIUS - ARC_WIDTH - 4,  // 外側半径
-                   redZoneStartAngle, 0,
-                   COLOR_RED);  // レッドゾーンは常に赤表示
+    fillBarArc(-270, 0, INACTIVE_COLOR);
+    previousValue = 0.0f;
   }
 
   // 前回値との比較で変更部分のみ更新
   float prevValue = std::isnan(previousValue) ? minValue : clampValue(previousValue, minValue, maxValue);
-  float prevAngle = -270 + ((prevValue - minValue) / (maxValue - minValue) * 270.0);
-  float currAngle = -270 + ((clampedValue - minValue) / (maxValue - minValue) * 270.0);
-  float thresholdAngle = -270 + ((threshold - minValue) / (maxValue - minValue) * 270.0);
+  float prevAngle = gaugeValueToAngle(spec, prevValue);
+  float currAngle = gaugeValueToAngle(spec, clampedValue);
 
-  bool prevOver = prevValue >= threshold;
-  bool currOver = clampedValue >= threshold;
+  bool prevOver = prevValue >= spec.threshold;
+  bool currOver = clampedValue >= spec.threshold;
 
   if (currOver)
   {
     if (!prevOver)
     {
       // レッドゾーンに入ったのでバー全体を赤く塗り替える
-      canvas.fillArc(CENTER_X_CORRECTED, CENTER_Y_CORRECTED, RADIUS - ARC_WIDTH, RADIUS, -270, currAngle,
-                     overThresholdColor);
+      fillBarArc(-270, currAngle, spec.overThresholdColor);
     }
     else if (currAngle > prevAngle)
     {
       // 増加分のみ赤で更新
-      canvas.fillArc(CENTER_X_CORRECTED, CENTER_Y_CORRECTED, RADIUS - ARC_WIDTH, RADIUS, prevAngle, currAngle,
-                     overThresholdColor);
+      fillBarArc(prevAngle, currAngle, spec.overThresholdColor);
     }
     else if (currAngle < prevAngle)
     {
       // 減少分を消去
-      canvas.fillArc(CENTER_X_CORRECTED, CENTER_Y_CORRECTED, RADIUS - ARC_WIDTH, RADIUS, currAngle, prevAngle,
-                     INACTIVE_COLOR);
+      fillBarArc(currAngle, prevAngle, INACTIVE_COLOR);
     }
   }
   else
@@ -108,91 +305,27 @@ void drawFillArcMeter(M5Canvas &canvas, float value, float minValue, float maxVa
     if (prevOver)
     {
       // レッドゾーンから戻ったので白色で描き直す
-      canvas.fillArc(CENTER_X_CORRECTED, CENTER_Y_CORRECTED, RADIUS - ARC_WIDTH, RADIUS, -270, currAngle, ACTIVE_COLOR);
+      fillBarArc(-270, currAngle, ACTIVE_COLOR);
       if (prevAngle > currAngle)
       {
-        canvas.fillArc(CENTER_X_CORRECTED, CENTER_Y_CORRECTED, RADIUS - ARC_WIDTH, RADIUS, currAngle, prevAngle,
-                       INACTIVE_COLOR);
+        fillBarArc(currAngle, prevAngle, INACTIVE_COLOR);
       }
     }
     else
     {
       if (currAngle > prevAngle)
       {
-        canvas.fillArc(CENTER_X_CORRECTED, CENTER_Y_CORRECTED, RADIUS - ARC_WIDTH, RADIUS, prevAngle, currAngle,
-                       ACTIVE_COLOR);
+        fillBarArc(prevAngle, currAngle, ACTIVE_COLOR);
       }
       else if (currAngle < prevAngle)
       {
-        canvas.fillArc(CENTER_X_CORRECTED, CENTER_Y_CORRECTED, RADIUS - ARC_WIDTH, RADIUS, currAngle, prevAngle,
-                       INACTIVE_COLOR);
+        fillBarArc(currAngle, prevAngle, INACTIVE_COLOR);
       }
     }
   }
 
   previousValue = clampedValue;
 
-  if (drawStatic)
-  {
-    // 目盛ラベルと目盛り線を描画
-    int tickCount = static_cast<int>((maxValue - minValue) / tickStep) + 1;
-    for (float i = 0; i <= tickCount - 1; i += 1)
-    {
-      float scaledValue = minValue + (tickStep * i);
-      float angle = 270 - ((270.0 / (tickCount - 1)) * i);  // 開始位置のロジックを維持
-      float rad = radians(angle);
-
-      // 主要目盛かどうかを判定（majorTickStep が負なら従来と同じ判定）
-      bool isMajorTick;
-      if (majorTickStep < 0)
-      {
-        isMajorTick = (fmod(scaledValue, 1.0f) == 0.0f);
-      }
-      else
-      {
-        float diff = fmod(scaledValue - labelStart, majorTickStep);
-        isMajorTick = (scaledValue >= labelStart) && (fabsf(diff) < 0.01f || fabsf(diff - majorTickStep) < 0.01f);
-      }
-
-      // 主要目盛は長めの線、細かい目盛は短めの線を描画
-      int innerRadius = isMajorTick ? (RADIUS - ARC_WIDTH - 10) : (RADIUS - ARC_WIDTH - 8);
-      int outerRadius = isMajorTick ? (RADIUS - ARC_WIDTH - 5) : (RADIUS - ARC_WIDTH - 7);
-
-      int lineX1 = CENTER_X_CORRECTED + (cosf(rad) * innerRadius);
-      int lineY1 = CENTER_Y_CORRECTED - (sinf(rad) * innerRadius);
-      int lineX2 = CENTER_X_CORRECTED + (cosf(rad) * outerRadius);
-      int lineY2 = CENTER_Y_CORRECTED - (sinf(rad) * outerRadius);
-
-      canvas.drawLine(lineX1, lineY1, lineX2, lineY2, COLOR_WHITE);
-
-      bool drawLabel = isMajorTick;
-
-      if (drawLabel)
-      {
-        int labelX = CENTER_X_CORRECTED + (cosf(rad) * (RADIUS - ARC_WIDTH - 15));
-        int labelY = CENTER_Y_CORRECTED - (sinf(rad) * (RADIUS - ARC_WIDTH - 15));
-
-        char labelText[6];
-        snprintf(labelText, sizeof(labelText), "%.0f", scaledValue);
-
-        canvas.setTextFont(1);
-        canvas.setFont(&fonts::Font0);
-        canvas.setTextColor(TEXT_COLOR, BACKGROUND_COLOR);
-        canvas.setCursor(labelX - (canvas.textWidth(labelText) / 2), labelY - 4);
-        canvas.print(labelText);
-      }
-    }
-
-    // 単位とメーター名を表示
-    char combinedLabel[30];
-    snprintf(combinedLabel, sizeof(combinedLabel), "%s / %s", label, unit);
-    canvas.setFont(&fonts::Font0);
-    int labelX = CENTER_X_CORRECTED + 8;
-    int labelY = CENTER_Y_CORRECTED + RADIUS + 12;
-    canvas.setCursor(labelX - (canvas.textWidth(combinedLabel) / 2), labelY);
-    canvas.print(combinedLabel);
-  }
-
   // 値を右下に表示
   char valueText[10];
   if (isUseDecimal)
@@ -204,12 +337,29 @@ void drawFillArcMeter(M5Canvas &canvas, float value, float minValue, float maxVa
     snprintf(valueText, sizeof(valueText), "%.0f", round(value));
   }
 
-  int valueX = VALUE_BASE_X;  // 数字は固定位置に表示
-  int valueY = CENTER_Y_CORRECTED + RADIUS - 20;
+  int valueX = spec.valueBaseX;  // 数字は固定位置に表示
+  int valueY = spec.valueCenterY;
+
+  if (valueField != nullptr)
+  {
+    if (drawStatic)
+    {
+      valueField->invalidate();
+    }
+    // 変化した桁だけを複写する。キャッシュに無い文字はフォントで描く
+    if (valueField->draw(canvas, valueText))
+    {
+      return;
+    }
+  }
 
   canvas.setFont(&FreeSansBold24pt7b);
-  // 数字描画領域のみを毎回黒で塗りつぶす
-  canvas.fillRect(valueX - 75, valueY - canvas.fontHeight() / 2 - 2, 75, canvas.fontHeight() + 4, BACKGROUND_COLOR);
+  canvas.setTextColor(TEXT_COLOR, BACKGROUND_COLOR);
+  // 数字描画領域のみを毎回背景へ戻す
+  restoreCanvasRect(canvas, background, valueX - GAUGE_VALUE_WIDTH, valueY - canvas.fontHeight() / 2 - 2,
+                    GAUGE_VALUE_WIDTH, canvas.fontHeight() + 4, BACKGROUND_COLOR);
+  frameDirtyRegions.markRect(valueX - GAUGE_VALUE_WIDTH, valueY - canvas.fontHeight() / 2 - 2, GAUGE_VALUE_WIDTH,
+                             canvas.fontHeight() + 4);
   canvas.setCursor(valueX - canvas.textWidth(valueText), valueY - (canvas.fontHeight() / 2));
   canvas.print(valueText);
 }
@@ -2,31 +2,272 @@
 #include <WiFi.h>  // WiFi 無効化用
 #include <Wire.h>
 
+#include <algorithm>
+
 #include "config.h"
 #include "modules/backlight.h"
+#include "modules/canvas_palette.h"
+#include "modules/deadline_scheduler.h"
 #include "modules/display.h"
+#include "modules/frame_profiler.h"
+#include "modules/persistent_store.h"
 #include "modules/racing_indicator.h"
 #include "modules/racing_mode.h"
 #include "modules/sensor.h"
+#include "modules/session_log.h"
+#include "modules/starvation_map.h"
 
 // ── FPS 計測用 ──
-unsigned long lastFpsSecond = 0;  // 直近1秒判定用
 int fpsFrameCounter = 0;
 int currentFps = 0;
-unsigned long lastDebugPrint = 0;   // デバッグ表示用タイマー
-unsigned long lastFrameTimeUs = 0;  // 前回フレーム開始時刻
-bool isMenuVisible = false;         // メニュー表示中かどうか
-static bool wasTouched = false;     // 前回タッチされていたか
+unsigned long lastDebugPrint = 0;  // デバッグ表示用タイマー
+unsigned long frameStartUs = 0;    // 現在フレームの開始時刻
+bool isMenuVisible = false;        // メニュー表示中かどうか
+static bool wasTouched = false;    // 前回タッチされていたか
+// メニューの概要ページに続くページ。タップごとに順に表示し、最後のページの次はメーターへ戻る
+static void (*const MENU_EXTRA_PAGES[])() = {
+#if OIL_STARVATION_MAP_ENABLED
+    drawOilMapScreen,  // G と油圧の分布
+#endif
+#if FRAME_PROFILER_ENABLED
+    drawProfileScreen,  // 区間ごとの処理時間
+#endif
+    nullptr,
+};
+constexpr int MENU_EXTRA_PAGE_COUNT = (sizeof(MENU_EXTRA_PAGES) / sizeof(MENU_EXTRA_PAGES[0])) - 1;
+static int menuPage = 0;  // 表示中のメニューのページ（0: 概要）
+// 入力・描画・ログなどを周期と締め切りに従って実行する
+static DeadlineScheduler jobScheduler(micros);
+// ── フレーム処理時間計測用（待機を除いた 1 フレームの処理時間） ──
+static unsigned long frameWorkTotalUs = 0;
+static unsigned long frameWorkMaxUs = 0;
+static unsigned long frameWorkCount = 0;
 
 // ────────────────────── デバッグ情報表示 ──────────────────────
 static void printSensorDebugInfo()
 {
-  float pressure = calculateAverage(oilPressureSamples);
-  float water = calculateAverage(waterTemperatureSamples);
-  float oil = calculateAverage(oilTemperatureSamples);
   // 水平Gと各センサー値をシリアルに表示
-  Serial.printf("G: %.2f%s, Oil.P: %.2f bar, Water.T: %.1f C, Oil.T: %.1f C\n", currentGForce, currentGDirection, pressure,
-                water, oil);
+  Serial.printf("G: %.2f (peak %.2f)%s", currentGForce, currentGForcePeak, currentGDirection);
+  sensorChannels.forEach(
+      [](auto &channel)
+      {
+        bool isPressure = channel.SPEC.unit == SensorUnit::Bar;
+        Serial.printf(isPressure ? ", %s: %.2f bar" : ", %s: %.1f C", channel.SPEC.label, channel.estimate().toFloat());
+      });
+  Serial.println();
+}
+
+// 各チャンネルの推定段の群遅延（定常状態）を表示する
+static void printSensorGroupDelay()
+{
+  sensorChannels.forEach(
+      [](auto &channel)
+      {
+        Serial.printf("[Sensor] %s: group delay %.1f ms\n", channel.SPEC.label, channel.groupDelayMs());
+      });
+}
+
+// ────────────────────── ジョブ ──────────────────────
+// タッチ・サンプル反映・レーシングモード判定。描画より先に実行する
+static void inputJob()
+{
+  frameStartUs = micros();
+  PROFILE_FRAME_BEGIN();
+  PROFILE_STAGE_BEGIN(Input);
+
+  // タッチ・ALS・PMIC は IMU と同じ内部 I2C を使うため、取得タスクと排他する。
+  // 画面全体の転送は時間がかかるので、排他は I2C を触る処理の間だけにとどめ、描画はその外で行う
+  lockInternalI2c();
+  M5.update();
+  bool touched = M5.Touch.getCount() > 0;
+  unlockInternalI2c();
+
+  if (touched && !wasTouched)
+  {
+    if (isMenuVisible && menuPage < MENU_EXTRA_PAGE_COUNT)
+    {
+      MENU_EXTRA_PAGES[menuPage++]();
+    }
+    else
+    {
+      isMenuVisible = !isMenuVisible;
+      menuPage = 0;
+      if (isMenuVisible)
+      {
+        forceStopRacingMode();  // 詳細画面ではレーシングモードを解除
+        syncSessionLog();       // 走行の区切りなので記録をファイルへ確定させる
+        drawMenuScreen();
+        // メニュー表示中は輝度を最大にする
+        lockInternalI2c();
+        applyBrightnessMode(BrightnessMode::Day);
+        unlockInternalI2c();
+      }
+      else
+      {
+        resetGaugeState();
+        // メニュー終了後は元の輝度に戻す
+        lockInternalI2c();
+#if SENSOR_AMBIENT_LIGHT_PRESENT
+        if (isRacingMode)
+        {
+          applyBrightnessMode(BrightnessMode::Day);
+        }
+        else
+        {
+          updateBacklightLevel();
+        }
+#else
+        applyBrightnessMode(getRacingPrevBrightnessMode());
+#endif
+        unlockInternalI2c();
+      }
+    }
+  }
+  wasTouched = touched;
+
+  // 取得済みのサンプルを描画用の値へ反映
+  drainSensorSamples();
+
+  // レーシングモードの開始・終了で輝度（PMIC）を切り替える
+  bool wasRacing = isRacingMode;
+  lockInternalI2c();
+  updateRacingMode(millis(), currentGForcePeak);
+  unlockInternalI2c();
+  if (wasRacing && !isRacingMode)
+  {
+    // 走行が終わったら記録をファイルへ確定させる
+    syncSessionLog();
+  }
+  PROFILE_STAGE_END(Input);
+}
+
+// ゲージ描画と転送
+static void renderJob()
+{
+  if (!isMenuVisible)
+  {
+    PROFILE_STAGE_BEGIN(Gauge);
+    updateGauges();
+    PROFILE_STAGE_END(Gauge);
+  }
+
+  // 描画中に完了した ADC 変換を回収し、次の変換を開始しておく
+  serviceAdcScheduler();
+  PROFILE_FRAME_END();
+
+  unsigned long frameWorkUs = micros() - frameStartUs;
+  frameWorkTotalUs += frameWorkUs;
+  frameWorkMaxUs = std::max(frameWorkMaxUs, frameWorkUs);
+  frameWorkCount++;
+  fpsFrameCounter++;
+}
+
+#if !DUAL_CORE_ACQUISITION_ENABLED
+// 油圧・G の取得（水温・油温は取得処理の中で TEMP_SAMPLE_INTERVAL_MS ごとに要求する）
+static void sensorJob() { acquireSensorData(); }
+#endif
+
+#if SENSOR_AMBIENT_LIGHT_PRESENT
+// 照度に応じた輝度更新。メニュー表示中とレーシングモード中は固定する
+static void ambientLightJob()
+{
+  if (isMenuVisible || isRacingMode)
+  {
+    return;
+  }
+  lockInternalI2c();
+  updateBacklightLevel();
+  unlockInternalI2c();
+}
+#endif
+
+// 書き込み待ちのログブロックを SD へ書き込む。次の描画に食い込まない空き時間にだけ実行される
+static void sessionLogJob() { serviceSessionLog(); }
+// ログファイルの同期。ブロックの書き込みより重いため、別の予算で収まる空き時間にだけ実行される
+static void sessionLogSyncJob() { serviceSessionLogSync(); }
+
+// 最大値と低油圧イベントをフラッシュへ反映（1 回に 1 操作）
+static void persistentStoreJob() { servicePersistentStore(isMenuVisible); }
+
+// FPS 集計とシリアル出力
+static void statusJob()
+{
+  unsigned long now = millis();
+  currentFps = fpsFrameCounter;
+#if DEBUG_MODE_ENABLED
+  Serial.printf("FPS:%d\n", currentFps);
+#endif
+  fpsFrameCounter = 0;
+
+#if FRAME_PROFILER_ENABLED || OIL_STARVATION_MAP_ENABLED
+  // シリアルから 1 文字のコマンドを受け取る
+  int command = (Serial.available() > 0) ? Serial.read() : -1;
+#endif
+#if FRAME_PROFILER_ENABLED
+  // 'p': 区間ごとの時間分布
+  if (command == 'p')
+  {
+    printFrameProfile();
+  }
+#endif
+#if OIL_STARVATION_MAP_ENABLED
+  // 'h': G と油圧の分布 (CSV)
+  if (command == 'h')
+  {
+    printStarvationMap();
+  }
+#endif
+
+#if DEBUG_MODE_ENABLED
+  // FPS更新とは別にデータを出力
+  printSensorDebugInfo();
+  Serial.printf("Sensor queue: age %lu ms, dropped %u\n", millis() - lastSensorSampleMs,
+                static_cast<unsigned>(sensorQueueDropCount()));
+  // フレーム処理時間（DOUBLE_BUFFER_ENABLED の有無で比較する）
+  Serial.printf("Frame work: avg %lu us, max %lu us (overlap %s)\n",
+                frameWorkTotalUs / (frameWorkCount > 0 ? frameWorkCount : 1), frameWorkMaxUs,
+                isDisplayTransferOverlapped() ? "on" : "off");
+  frameWorkTotalUs = 0;
+  frameWorkMaxUs = 0;
+  frameWorkCount = 0;
+  // 1フレームあたりの ADC 通信時間を表示
+  unsigned long frames = (now - lastDebugPrint) * 1000UL / FRAME_INTERVAL_US;
+  Serial.printf("ADC I2C: %lu us/frame\n", consumeAdcBusTimeUs() / (frames > 0 ? frames : 1));
+  // 直近フレームと累計の SPI 転送量を表示
+  Serial.printf("SPI push: %lu bytes/frame, total %lu bytes\n", static_cast<unsigned long>(lastFramePushedBytes),
+                static_cast<unsigned long>(totalPushedBytes));
+  // ジョブごとの締め切り超過と飛ばした周期
+  for (int i = 0; i < jobScheduler.jobCount(); ++i)
+  {
+    const DeadlineScheduler::JobStats &stats = jobScheduler.stats(i);
+    Serial.printf("Job %s: runs %lu, miss %lu (worst +%lu us), skip %lu\n", jobScheduler.jobName(i),
+                  static_cast<unsigned long>(stats.runs), static_cast<unsigned long>(stats.misses),
+                  stats.worstLatenessUs, static_cast<unsigned long>(stats.skips));
+  }
+  jobScheduler.resetStats();
+  lastDebugPrint = now;
+#endif
+}
+
+// 周期と締め切りを登録する。同じ周期のジョブは締め切りが近いものから実行される
+static void registerJobs()
+{
+  jobScheduler.addJob("input", inputJob, FRAME_INTERVAL_US, INPUT_JOB_DEADLINE_US);
+  jobScheduler.addJob("render", renderJob, FRAME_INTERVAL_US, FRAME_INTERVAL_US);
+#if !DUAL_CORE_ACQUISITION_ENABLED
+  jobScheduler.addJob("sensor", sensorJob, SENSOR_TASK_INTERVAL_MS * 1000UL, SENSOR_TASK_INTERVAL_MS * 1000UL);
+#endif
+#if SENSOR_AMBIENT_LIGHT_PRESENT
+  jobScheduler.addJob("als", ambientLightJob, ALS_MEASUREMENT_INTERVAL_MS * 1000UL, AMBIENT_LIGHT_JOB_DEADLINE_US);
+#endif
+  jobScheduler.addJob("log", sessionLogJob, FRAME_INTERVAL_US, SESSION_LOG_DEADLINE_US, SESSION_LOG_WRITE_BUDGET_US);
+  jobScheduler.addJob("logsync", sessionLogSyncJob, FRAME_INTERVAL_US, SESSION_LOG_SYNC_DEADLINE_US,
+                      SESSION_LOG_SYNC_BUDGET_US);
+#if PERSISTENT_STORE_ENABLED
+  jobScheduler.addJob("store", persistentStoreJob, PERSISTENT_STORE_INTERVAL_MS * 1000UL, PERSISTENT_STORE_DEADLINE_US,
+                      PERSISTENT_STORE_WRITE_BUDGET_US);
+#endif
+  jobScheduler.addJob("status", statusJob, FPS_INTERVAL_MS * 1000UL, FPS_INTERVAL_MS * 1000UL);
 }
 
 // ────────────────────── setup() ──────────────────────
@@ -55,19 +296,19 @@ void setup()
   display.setColorDepth(DISPLAY_COLOR_DEPTH);
   display.setBrightness(BACKLIGHT_DAY);
 
-  mainCanvas.setColorDepth(DISPLAY_COLOR_DEPTH);
+  // 描画先の画素形式（パレット形式なら転送時に RGB565 へ展開する）
+  mainCanvas.setColorDepth(CANVAS_COLOR_DEPTH);
   mainCanvas.setTextSize(1);
-  // スプライトを PSRAM ではなく DMA メモリに確保
-  mainCanvas.setPsram(false);
-  // スプライト用の DMA を初期化
-  mainCanvas.initDMA();
-  mainCanvas.createSprite(LCD_WIDTH, LCD_HEIGHT);
+
+  // ゲージ画面の部品ごとのスプライト、メニュー用の全画面バッファ、転送と描画を重ねるための第2バッファ
+  initDisplayBuffers();
 
   M5.Lcd.clear();
   M5.Lcd.fillScreen(COLOR_BLACK);
 
   // M5.Speaker.begin();  // スピーカーを使用しないため無効化
   M5.Imu.begin();  // IMU を使用
+  initImuFifo();
   btStop();
 
   pinMode(9, INPUT_PULLUP);
@@ -75,20 +316,17 @@ void setup()
   Wire.begin(9, 8);
 
 #if !DEMO_MODE_ENABLED
-  // デモモードでなければADS1015を初期化し、失敗時は画面にエラーを表示
-  if (!adsConverter.begin())
+  // デモモードでなければ ADS1x15 を初期化し、応答しない変換器があれば画面にエラーを表示
+  if (!initAdcConverters())
   {
-    Serial.println("[ADS1015] init failed… all analog values will be 0");
+    Serial.println("[ADS1x15] init failed… analog values on missing converters will be 0");
     M5.Lcd.setTextSize(2);
     M5.Lcd.setTextColor(COLOR_RED);
     M5.Lcd.setCursor(0, 0);
-    M5.Lcd.println("ADS1015 init failed");
+    M5.Lcd.println("ADS1x15 init failed");
     M5.Lcd.println("Check wiring");
   }
-  else
-  {
-    adsConverter.setDataRate(RATE_ADS1015_1600SPS);
-  }
+  initAdcScheduler();
 #endif
 
 #if SENSOR_AMBIENT_LIGHT_PRESENT
@@ -102,87 +340,38 @@ void setup()
   // 初回起動時に照度を取得して輝度を決定
   updateBacklightLevel();
 #endif
-}
 
-// ────────────────────── loop() ──────────────────────
-void loop()
-{
-  static unsigned long lastAlsMeasurementTime = 0;
-  unsigned long nowUs = micros();
-  // 前のフレームから16.6ms未満なら待機
-  if (lastFrameTimeUs != 0 && nowUs - lastFrameTimeUs < FRAME_INTERVAL_US)
-  {
-    delayMicroseconds(FRAME_INTERVAL_US - (nowUs - lastFrameTimeUs));
-    nowUs = micros();
-  }
-  lastFrameTimeUs = nowUs;
-  unsigned long now = millis();
-
-  M5.update();
+  initSessionLog();
+  // 前回までの最大値と低油圧イベントを読み込む（最初のフレームを描く前に済ませる）
+  initPersistentStore();
 
-  if (!isMenuVisible && !isRacingMode && now - lastAlsMeasurementTime >= ALS_MEASUREMENT_INTERVAL_MS)
-  {
-    updateBacklightLevel();
-    lastAlsMeasurementTime = now;
-  }
-
-  bool touched = M5.Touch.getCount() > 0;
-  if (touched && !wasTouched)
-  {
-    isMenuVisible = !isMenuVisible;
-    if (isMenuVisible)
-    {
-      forceStopRacingMode();  // 詳細画面ではレーシングモードを解除
-      drawMenuScreen();
-      // メニュー表示中は輝度を最大にする
-      applyBrightnessMode(BrightnessMode::Day);
-    }
-    else
-    {
-      resetGaugeState();
-      // メニュー終了後は元の輝度に戻す
-#if SENSOR_AMBIENT_LIGHT_PRESENT
-      if (isRacingMode)
-      {
-        applyBrightnessMode(BrightnessMode::Day);
-      }
-      else
-      {
-        updateBacklightLevel();
-      }
-#else
-      applyBrightnessMode(getRacingPrevBrightnessMode());
+#if DEBUG_MODE_ENABLED
+  printSensorGroupDelay();
 #endif
-    }
-  }
-  wasTouched = touched;
-
-  acquireSensorData();
 
-  updateRacingMode(now, currentGForce);
+#if DUAL_CORE_ACQUISITION_ENABLED
+  // 全センサーの初期化が済んでから取得タスクを起動する
+  startSensorTask();
+#endif
+  registerJobs();
+}
 
-  if (!isMenuVisible)
+// ────────────────────── loop() ──────────────────────
+// 実行するジョブが無ければ次のジョブまで CPU を手放す
+void loop()
+{
+  if (jobScheduler.runOnce())
   {
-    updateGauges();
+    return;
   }
-
-  fpsFrameCounter++;
-  if (now - lastFpsSecond >= FPS_INTERVAL_MS)
+  unsigned long idleUs = jobScheduler.timeUntilNextReleaseUs();
+  if (idleUs >= SCHEDULER_YIELD_MIN_US)
   {
-    currentFps = fpsFrameCounter;
-#if DEBUG_MODE_ENABLED
-    Serial.printf("FPS:%d\n", currentFps);
-#endif
-    fpsFrameCounter = 0;
-    lastFpsSecond = now;
+    // 待機中はアイドルタスクが WAITI で停止するため、空回りより消費電力と発熱が小さい
+    vTaskDelay(pdMS_TO_TICKS(idleUs / 1000UL));
   }
-
-#if DEBUG_MODE_ENABLED
-  if (now - lastDebugPrint >= 1000UL)
+  else
   {
-    // FPS更新とは別に1秒ごとにデータを出力
-    printSensorDebugInfo();
-    lastDebugPrint = now;
+    delayMicroseconds(idleUs);
   }
-#endif
 }
@@ -0,0 +1,196 @@
+#include "adc_scheduler.h"
+
+AdcScheduler::AdcScheduler(AdcDevice &device, MicrosFn microsFn) : device(&device), nowUs(microsFn) {}
+
+void AdcScheduler::attach(AdcDevice &newDevice, MicrosFn microsFn)
+{
+  device = &newDevice;
+  nowUs = microsFn;
+  // 旧デバイスで進行中だった変換と結果は破棄する
+  state = State::Idle;
+  muxChannel = ADC_NO_CHANNEL;
+  activeChannel = ADC_NO_CHANNEL;
+  for (uint8_t ch = 0; ch < ADC_CHANNEL_COUNT; ++ch)
+  {
+    requested[ch] = false;
+    hasResult[ch] = false;
+  }
+}
+
+void AdcScheduler::setHomeChannel(uint8_t channel)
+{
+  homeChannel = (channel < ADC_CHANNEL_COUNT) ? channel : ADC_NO_CHANNEL;
+}
+
+void AdcScheduler::requestChannel(uint8_t channel)
+{
+  if (channel < ADC_CHANNEL_COUNT)
+  {
+    requested[channel] = true;
+  }
+}
+
+auto AdcScheduler::takeResult(uint8_t channel, int16_t &raw) -> bool
+{
+  if (channel >= ADC_CHANNEL_COUNT || !hasResult[channel])
+  {
+    return false;
+  }
+  raw = results[channel];
+  hasResult[channel] = false;
+  return true;
+}
+
+auto AdcScheduler::consumeBusTimeUs() -> unsigned long
+{
+  unsigned long spent = busTimeUs;
+  busTimeUs = 0;
+  return spent;
+}
+
+// ────────────────────── 次の変換対象を選ぶ ──────────────────────
+// 要求済みチャンネルを巡回順に優先し、無ければホームチャンネルへ戻る
+auto AdcScheduler::selectNextChannel() -> uint8_t
+{
+  for (uint8_t i = 0; i < ADC_CHANNEL_COUNT; ++i)
+  {
+    uint8_t ch = (requestCursor + i) % ADC_CHANNEL_COUNT;
+    if (requested[ch])
+    {
+      requestCursor = (ch + 1) % ADC_CHANNEL_COUNT;
+      return ch;
+    }
+  }
+  return homeChannel;
+}
+
+void AdcScheduler::startOn(uint8_t channel)
+{
+  unsigned long t0 = nowUs();
+  device->startConversion(channel);
+  unsigned long t1 = nowUs();
+  busTimeUs += t1 - t0;
+  conversionStartUs = t1;
+}
+
+// ────────────────────── 状態機械 ──────────────────────
+void AdcScheduler::poll()
+{
+  if (device == nullptr)
+  {
+    return;
+  }
+  if (state != State::Idle)
+  {
+    if (nowUs() - conversionStartUs < device->minConversionUs())
+    {
+      return;  // 変換が終わり得ない間はバスを使わない
+    }
+    unsigned long t0 = nowUs();
+    bool ready = device->isConversionReady();
+    unsigned long t1 = nowUs();
+    busTimeUs += t1 - t0;
+
+    if (!ready)
+    {
+      if (t1 - conversionStartUs < CONVERSION_TIMEOUT_US)
+      {
+        return;  // まだ変換中。次の tick で再確認する
+      }
+      // 応答が無いので今回の変換は諦め、次のチャンネルへ進む
+      requested[activeChannel] = false;
+      state = State::Idle;
+      muxChannel = ADC_NO_CHANNEL;
+    }
+    else
+    {
+      t0 = nowUs();
+      int16_t raw = device->readConversionResult();
+      busTimeUs += nowUs() - t0;
+
+      if (state == State::Settling)
+      {
+        // 捨て変換が終わったので同じチャンネルで本変換を開始
+        startOn(activeChannel);
+        state = State::Converting;
+        return;
+      }
+
+      results[activeChannel] = raw;
+      hasResult[activeChannel] = true;
+      requested[activeChannel] = false;
+      state = State::Idle;
+    }
+  }
+
+  uint8_t next = selectNextChannel();
+  if (next == ADC_NO_CHANNEL)
+  {
+    return;
+  }
+
+  bool switching = next != muxChannel;
+  activeChannel = next;
+  muxChannel = next;
+  startOn(next);
+  state = (switching && discardAfterSwitch) ? State::Settling : State::Converting;
+}
+
+// ────────────────────── AdcBank ──────────────────────
+void AdcBank::attach(uint8_t index, AdcDevice &device, MicrosFn microsFn)
+{
+  if (index >= ADC_MAX_DEVICES)
+  {
+    return;
+  }
+  schedulers[index].attach(device, microsFn);
+  if (index >= count)
+  {
+    count = index + 1;
+  }
+}
+
+void AdcBank::setHomeChannel(uint8_t device, uint8_t channel)
+{
+  if (device < count)
+  {
+    schedulers[device].setHomeChannel(channel);
+  }
+}
+
+void AdcBank::requestChannel(uint8_t device, uint8_t channel)
+{
+  if (device < count)
+  {
+    schedulers[device].requestChannel(channel);
+  }
+}
+
+auto AdcBank::takeResult(uint8_t device, uint8_t channel, int16_t &raw) -> bool
+{
+  return device < count && schedulers[device].takeResult(channel, raw);
+}
+
+void AdcBank::poll()
+{
+  if (count == 0)
+  {
+    return;
+  }
+  // 完了した変換器から回収して次の変換を始めるため、待ち時間はほかの変換器の変換と重なる
+  for (uint8_t i = 0; i < count; ++i)
+  {
+    schedulers[(pollCursor + i) % count].poll();
+  }
+  pollCursor = (pollCursor + 1) % count;
+}
+
+auto AdcBank::consumeBusTimeUs() -> unsigned long
+{
+  unsigned long spent = 0;
+  for (uint8_t i = 0; i < count; ++i)
+  {
+    spent += schedulers[i].consumeBusTimeUs();
+  }
+  return spent;
+}
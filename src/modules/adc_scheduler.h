@@ -0,0 +1,130 @@
+#ifndef ADC_SCHEDULER_H
+#define ADC_SCHEDULER_H
+
+#include <cstdint>
+
+// ADC チャンネル数（ADS1x15 のシングルエンド入力）
+constexpr uint8_t ADC_CHANNEL_COUNT = 4;
+// チャンネル未指定を表す値
+constexpr uint8_t ADC_NO_CHANNEL = 0xFF;
+// 同じバスに置ける ADS1x15 の数（ADDR ピンで 0x48〜0x4B）
+constexpr uint8_t ADC_MAX_DEVICES = 4;
+
+// ────────────────────── ADC デバイス抽象 ──────────────────────
+// 実機では ADS1x15、ホストテストでは疑似 ADC が実装する
+class AdcDevice
+{
+ public:
+  virtual ~AdcDevice() = default;
+  // 指定チャンネルの単発変換を開始する（完了を待たずに戻る）
+  virtual void startConversion(uint8_t channel) = 0;
+  // 変換が完了しているかどうか
+  virtual auto isConversionReady() -> bool = 0;
+  // 直近の変換結果を取得する
+  virtual auto readConversionResult() -> int16_t = 0;
+  // 変換に必ず掛かる時間 [us]。この間は完了確認のバスアクセスを省く（0 なら毎回確認する）
+  virtual auto minConversionUs() const -> unsigned long { return 0; }
+};
+
+// ────────────────────── ノンブロッキング変換スケジューラ ──────────────────────
+// 変換を開始したらすぐ戻り、後続の poll() で結果を回収する状態機械。
+// 常時変換するホームチャンネル（油圧）と、要求時のみ変換するチャンネル（温度）を巡回する。
+class AdcScheduler
+{
+ public:
+  using MicrosFn = unsigned long (*)();
+
+  // デバイス未接続の状態。attach() するまで poll() は何もしない
+  AdcScheduler() = default;
+  AdcScheduler(AdcDevice &device, MicrosFn microsFn);
+
+  // 変換元と時計を差し替える（トレース再生用）。進行中の変換は破棄する
+  void attach(AdcDevice &newDevice, MicrosFn microsFn);
+
+  // 常時変換するチャンネルを設定する（ADC_NO_CHANNEL で無効）
+  void setHomeChannel(uint8_t channel);
+  // 指定チャンネルの変換を1回要求する
+  void requestChannel(uint8_t channel);
+  // マルチプレクサ切替直後の変換を捨てるかどうか
+  void setDiscardAfterSwitch(bool discard) { discardAfterSwitch = discard; }
+
+  // 状態機械を1ステップ進める。変換待ちでブロックしない
+  void poll();
+
+  // 新しい変換結果があれば取得して true を返す
+  auto takeResult(uint8_t channel, int16_t &raw) -> bool;
+
+  // 変換中かどうか
+  auto isBusy() const -> bool { return state != State::Idle; }
+
+  // 前回取得以降に I2C 通信へ費やした時間 [us] を返してリセットする
+  auto consumeBusTimeUs() -> unsigned long;
+
+ private:
+  enum class State : uint8_t
+  {
+    Idle,        // 変換していない
+    Settling,    // マルチプレクサ切替直後の捨て変換中
+    Converting,  // 有効な変換中
+  };
+
+  // 変換完了待ちの打ち切り時間 [us]（ADC 未接続時に状態機械が止まらないように）
+  static constexpr unsigned long CONVERSION_TIMEOUT_US = 5000;
+
+  auto selectNextChannel() -> uint8_t;
+  void startOn(uint8_t channel);
+
+  AdcDevice *device = nullptr;
+  MicrosFn nowUs = nullptr;
+  State state = State::Idle;
+  uint8_t homeChannel = ADC_NO_CHANNEL;
+  uint8_t activeChannel = ADC_NO_CHANNEL;
+  uint8_t muxChannel = ADC_NO_CHANNEL;  // 最後に選択したマルチプレクサ
+  uint8_t requestCursor = 0;            // 要求チャンネルの巡回位置
+  bool discardAfterSwitch = true;
+  unsigned long conversionStartUs = 0;
+  unsigned long busTimeUs = 0;
+
+  bool requested[ADC_CHANNEL_COUNT] = {};
+  bool hasResult[ADC_CHANNEL_COUNT] = {};
+  int16_t results[ADC_CHANNEL_COUNT] = {};
+};
+
+// ────────────────────── 複数の変換器 ──────────────────────
+// 同じ I2C バス上の ADS1x15 ごとにスケジューラを持ち、変換を並行させる。
+// poll() は全変換器を 1 ステップずつ進め、開始位置を毎回ずらして回収順を公平にする
+class AdcBank
+{
+ public:
+  using MicrosFn = AdcScheduler::MicrosFn;
+
+  // index 番の変換器を接続（差し替え）する。変換器の数は接続した最大の番号 + 1
+  void attach(uint8_t index, AdcDevice &device, MicrosFn microsFn);
+  auto deviceCount() const -> uint8_t { return count; }
+
+  void setHomeChannel(uint8_t device, uint8_t channel);
+  void requestChannel(uint8_t device, uint8_t channel);
+  auto takeResult(uint8_t device, uint8_t channel, int16_t &raw) -> bool;
+
+  void poll();
+  // 全変換器の I2C 通信時間の合計 [us] を返してリセットする
+  auto consumeBusTimeUs() -> unsigned long;
+
+  // 変換は各変換器で並行し、バスは開始・完了確認・読み出しの 3 回だけ使う。
+  // 合計サンプル数 [/s] は変換器の数に比例し、バスが埋まるとそこで頭打ちになる
+  static constexpr auto modelSamplesPerSecond(uint8_t devices, unsigned long conversionUs, unsigned long busOpUs)
+      -> float
+  {
+    float perDevice = 1.0e6F / static_cast<float>(conversionUs + (3 * busOpUs));
+    float busLimit = 1.0e6F / static_cast<float>(3 * busOpUs);
+    float total = perDevice * static_cast<float>(devices);
+    return (total < busLimit) ? total : busLimit;
+  }
+
+ private:
+  AdcScheduler schedulers[ADC_MAX_DEVICES];
+  uint8_t count = 0;
+  uint8_t pollCursor = 0;
+};
+
+#endif  // ADC_SCHEDULER_H
@@ -2,33 +2,20 @@
 
 #include <M5CoreS3.h>
 
-#include <algorithm>
-#include <cstring>
-
 #include "display.h"
+#include "streaming_stats.h"
 
 // ────────────────────── グローバル変数 ──────────────────────
 // 現在の輝度モード
 BrightnessMode currentBrightnessMode = BrightnessMode::Day;
-// ALS サンプルバッファ
-int luxSamples[MEDIAN_BUFFER_SIZE] = {};
-int luxSampleIndex = 0;  // 次に書き込むインデックス
+// 直近 MEDIAN_BUFFER_SIZE 回の ALS サンプルの中央値
+static SlidingMedian<int, MEDIAN_BUFFER_SIZE> luxMedian;
 
 // 直近取得した照度値
 int latestLux = 0;
 // 中央値フィルタ適用後の照度値
 int medianLuxValue = 0;
 
-// ────────────────────── 中央値計算 ──────────────────────
-// サンプル配列から中央値を計算する
-static auto calculateMedian(const int *samples) -> int
-{
-  int sortedSamples[MEDIAN_BUFFER_SIZE];
-  memcpy(sortedSamples, samples, sizeof(sortedSamples));
-  std::nth_element(sortedSamples, sortedSamples + MEDIAN_BUFFER_SIZE / 2, sortedSamples + MEDIAN_BUFFER_SIZE);
-  return sortedSamples[MEDIAN_BUFFER_SIZE / 2];
-}
-
 // 指定された輝度モードを適用
 void applyBrightnessMode(BrightnessMode mode)
 {
@@ -52,11 +39,8 @@ void updateBacklightLevel()
 
   int currentLux = CoreS3.Ltr553.getAlsValue();
   latestLux = currentLux;
-  // サンプルをリングバッファへ格納
-  luxSamples[luxSampleIndex] = currentLux;
-  luxSampleIndex = (luxSampleIndex + 1) % MEDIAN_BUFFER_SIZE;
-
-  int medianLux = calculateMedian(luxSamples);
+  luxMedian.push(currentLux);
+  int medianLux = luxMedian.median();
   medianLuxValue = medianLux;
 
   // デバッグモードでは照度を出力
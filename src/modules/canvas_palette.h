@@ -0,0 +1,216 @@
+#ifndef CANVAS_PALETTE_H
+#define CANVAS_PALETTE_H
+
+#include <M5GFX.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "config.h"
+
+// ────────────────────── キャンバスの画素形式 ──────────────────────
+// CANVAS_PALETTE_BITS が 0 なら mainCanvas は RGB565 のまま描く。4 / 8 ならパレット番号で描き、
+// パネルへ送る直前に RGB565 へ展開する。キャンバスへ描く色は必ず canvasColor() を通す
+// （パネルへ直接描く M5.Lcd などは RGB565 のまま）
+
+static_assert(CANVAS_PALETTE_BITS == 0 || CANVAS_PALETTE_BITS == 4 || CANVAS_PALETTE_BITS == 8,
+              "CANVAS_PALETTE_BITS は 0, 4, 8 のいずれか");
+static_assert(DISPLAY_COLOR_DEPTH == 16, "パネルへは RGB565 で送る");
+
+// 画面で使う色。4bit でも収まるよう 16 色以内に保つ（ヒートマップの階調もここから最も近い色を選ぶ）
+constexpr uint16_t CANVAS_PALETTE[] = {
+    COLOR_BLACK,
+    COLOR_WHITE,
+    COLOR_RED,
+    COLOR_GRAY,
+    0x18E3,                // メーター・油温バーの背景
+    rgb565(80, 80, 80),    // メニューの枠
+    rgb565(24, 24, 24),    // ヒートマップの空セル
+    rgb565(0, 0, 85),      // ヒートマップの階調（黒 → 青 → 赤 → 黄）
+    rgb565(0, 0, 170),
+    rgb565(0, 0, 255),
+    rgb565(85, 0, 170),
+    rgb565(170, 0, 85),
+    rgb565(255, 85, 0),
+    COLOR_ORANGE,
+    COLOR_YELLOW,
+};
+constexpr int CANVAS_PALETTE_SIZE = sizeof(CANVAS_PALETTE) / sizeof(CANVAS_PALETTE[0]);
+static_assert(CANVAS_PALETTE_SIZE <= 16, "4bit パレットに収める");
+
+// RGB565 の各成分を 8bit へ戻す
+constexpr auto rgb565Red(uint16_t c) -> uint8_t { return static_cast<uint8_t>((c >> 8) & 0xF8); }
+constexpr auto rgb565Green(uint16_t c) -> uint8_t { return static_cast<uint8_t>((c >> 3) & 0xFC); }
+constexpr auto rgb565Blue(uint16_t c) -> uint8_t { return static_cast<uint8_t>((c << 3) & 0xF8); }
+
+// パレットのうち最も近い色の番号（一致する色があればその番号）
+constexpr auto nearestPaletteIndex(uint16_t rgb) -> uint8_t
+{
+  int best = 0;
+  int32_t bestDistance = INT32_MAX;
+  for (int i = 0; i < CANVAS_PALETTE_SIZE; ++i)
+  {
+    int32_t dr = rgb565Red(rgb) - rgb565Red(CANVAS_PALETTE[i]);
+    int32_t dg = rgb565Green(rgb) - rgb565Green(CANVAS_PALETTE[i]);
+    int32_t db = rgb565Blue(rgb) - rgb565Blue(CANVAS_PALETTE[i]);
+    int32_t distance = (dr * dr) + (dg * dg) + (db * db);
+    if (distance < bestDistance)
+    {
+      best = i;
+      bestDistance = distance;
+    }
+  }
+  return static_cast<uint8_t>(best);
+}
+
+// キャンバスへ描くときの色の値（RGB565 またはパレット番号）
+constexpr auto canvasColor(uint16_t rgb) -> uint16_t
+{
+#if CANVAS_PALETTE_BITS
+  return nearestPaletteIndex(rgb);
+#else
+  return rgb;
+#endif
+}
+
+// ────────────────────── 画素の読み書き ──────────────────────
+// 1 行分を詰めて保持するバッファの画素操作。4bit は 1 バイトに 2 画素（左の画素が上位）
+template <int BITS>
+struct CanvasPixels
+{
+  static_assert(BITS == 4 || BITS == 8 || BITS == 16, "対応する画素形式は 4, 8, 16bit");
+
+  static constexpr auto rowBytes(int width) -> size_t { return ((static_cast<size_t>(width) * BITS) + 7) / 8; }
+
+  static auto read(const uint8_t *row, int x) -> uint16_t
+  {
+    if constexpr (BITS == 16)
+    {
+      uint16_t value;
+      memcpy(&value, row + (x * 2), sizeof(value));
+      return value;
+    }
+    if constexpr (BITS == 8)
+    {
+      return row[x];
+    }
+    return (x & 1) ? (row[x / 2] & 0x0F) : (row[x / 2] >> 4);
+  }
+
+  static void write(uint8_t *row, int x, uint16_t value)
+  {
+    if constexpr (BITS == 16)
+    {
+      memcpy(row + (x * 2), &value, sizeof(value));
+    }
+    else if constexpr (BITS == 8)
+    {
+      row[x] = static_cast<uint8_t>(value);
+    }
+    else
+    {
+      uint8_t &b = row[x / 2];
+      b = (x & 1) ? static_cast<uint8_t>((b & 0xF0) | (value & 0x0F)) : static_cast<uint8_t>((b & 0x0F) | (value << 4));
+    }
+  }
+
+  // count 画素を複写する。4bit で左端の偶奇が揃わない場合だけ 1 画素ずつ詰め直す
+  static void copy(uint8_t *destRow, int destX, const uint8_t *sourceRow, int sourceX, int count)
+  {
+    if constexpr (BITS >= 8)
+    {
+      memcpy(destRow + (destX * (BITS / 8)), sourceRow + (sourceX * (BITS / 8)), count * (BITS / 8));
+    }
+    else
+    {
+      copyNibbles(destRow, destX, sourceRow, sourceX, count);
+    }
+  }
+
+  // パレット番号の行を、表 lut で RGB565（パネルのバイト順）へ展開する
+  static void expand(const uint8_t *row, int x, int count, const lgfx::swap565_t *lut, uint16_t *out)
+  {
+    for (int i = 0; i < count; ++i)
+    {
+      out[i] = lut[read(row, x + i)].raw;
+    }
+  }
+
+ private:
+  static void copyNibbles(uint8_t *destRow, int destX, const uint8_t *sourceRow, int sourceX, int count)
+  {
+    if (((destX ^ sourceX) & 1) != 0)
+    {
+      for (int i = 0; i < count; ++i)
+      {
+        write(destRow, destX + i, read(sourceRow, sourceX + i));
+      }
+      return;
+    }
+    int i = 0;
+    if ((destX & 1) != 0 && count > 0)
+    {
+      write(destRow, destX, read(sourceRow, sourceX));
+      i = 1;
+    }
+    int pairs = (count - i) / 2;
+    memcpy(destRow + ((destX + i) / 2), sourceRow + ((sourceX + i) / 2), pairs);
+    i += pairs * 2;
+    if (i < count)
+    {
+      write(destRow, destX + i, read(sourceRow, sourceX + i));
+    }
+  }
+};
+
+// mainCanvas の画素形式
+#if CANVAS_PALETTE_BITS == 4
+constexpr auto CANVAS_COLOR_DEPTH = lgfx::palette_4bit;
+#elif CANVAS_PALETTE_BITS == 8
+constexpr auto CANVAS_COLOR_DEPTH = lgfx::palette_8bit;
+#else
+constexpr auto CANVAS_COLOR_DEPTH = DISPLAY_COLOR_DEPTH;
+#endif
+constexpr int CANVAS_BITS_PER_PIXEL = (CANVAS_PALETTE_BITS != 0) ? CANVAS_PALETTE_BITS : DISPLAY_COLOR_DEPTH;
+using CanvasFormat = CanvasPixels<CANVAS_BITS_PER_PIXEL>;
+
+// background の矩形を canvas の同じ位置へ複写して消去する。両者は同じ大きさ・画素形式であること。
+// background が無い（nullptr または未確保）場合は fallbackColor（canvasColor() の値）で塗る
+inline void restoreCanvasRect(M5Canvas &canvas, const M5Canvas *background, int x, int y, int w, int h,
+                              uint16_t fallbackColor)
+{
+  if (background == nullptr || background->getBuffer() == nullptr)
+  {
+    canvas.fillRect(x, y, w, h, fallbackColor);
+    return;
+  }
+  int left = std::max(x, 0);
+  int top = std::max(y, 0);
+  int right = std::min(x + w, canvas.width());
+  int bottom = std::min(y + h, canvas.height());
+  if (right <= left || bottom <= top)
+  {
+    return;
+  }
+  const size_t rowBytes = CanvasFormat::rowBytes(canvas.width());
+  uint8_t *dest = static_cast<uint8_t *>(canvas.getBuffer());
+  const uint8_t *source = static_cast<const uint8_t *>(background->getBuffer());
+  for (int row = top; row < bottom; ++row)
+  {
+    CanvasFormat::copy(dest + (row * rowBytes), left, source + (row * rowBytes), left, right - left);
+  }
+}
+
+// パレット形式のキャンバスへ CANVAS_PALETTE を設定する（createSprite の後に呼ぶ）
+inline void applyCanvasPalette(M5Canvas &canvas)
+{
+  for (int i = 0; i < CANVAS_PALETTE_SIZE; ++i)
+  {
+    canvas.setPaletteColor(i, rgb565Red(CANVAS_PALETTE[i]), rgb565Green(CANVAS_PALETTE[i]),
+                           rgb565Blue(CANVAS_PALETTE[i]));
+  }
+}
+
+#endif  // CANVAS_PALETTE_H
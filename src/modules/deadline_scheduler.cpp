@@ -0,0 +1,131 @@
+#include "deadline_scheduler.h"
+
+auto DeadlineScheduler::addJob(const char *name, JobFn run, unsigned long periodUs, unsigned long deadlineUs,
+                               unsigned long budgetUs) -> int
+{
+  if (count == MAX_JOBS || run == nullptr || periodUs == 0)
+  {
+    return INVALID_JOB;
+  }
+  Job &job = jobs[count];
+  job.name = name;
+  job.run = run;
+  job.periodUs = periodUs;
+  job.deadlineUs = deadlineUs;
+  job.budgetUs = budgetUs;
+  // 登録直後に最初の周期を開始する
+  job.releaseUs = nowUs();
+  job.stats = JobStats();
+  return count++;
+}
+
+void DeadlineScheduler::resetStats()
+{
+  for (int i = 0; i < count; ++i)
+  {
+    jobs[i].stats = JobStats();
+  }
+}
+
+// ────────────────────── ジョブの選択 ──────────────────────
+// 周期が始まっているジョブのうち締め切りが最も近いものを選ぶ。同じ締め切りなら登録順
+auto DeadlineScheduler::selectJob(unsigned long now) const -> int
+{
+  int selected = INVALID_JOB;
+  long selectedSlack = 0;
+  for (int i = 0; i < count; ++i)
+  {
+    const Job &job = jobs[i];
+    if (!isAtOrAfter(now, job.releaseUs) || !fitsBeforeOtherJobs(i, now))
+    {
+      continue;
+    }
+    long slack = static_cast<long>(job.releaseUs + job.deadlineUs - now);
+    if (selected == INVALID_JOB || slack < selectedSlack)
+    {
+      selected = i;
+      selectedSlack = slack;
+    }
+  }
+  return selected;
+}
+
+// 想定実行時間を持つジョブは、他のジョブの次の開始までに収まるときだけ実行する。
+// ただし自分の締め切りを過ぎたら、取り残されないよう収まらなくても実行する
+auto DeadlineScheduler::fitsBeforeOtherJobs(int id, unsigned long now) const -> bool
+{
+  const Job &job = jobs[id];
+  if (job.budgetUs == 0 || isAtOrAfter(now, job.releaseUs + job.deadlineUs))
+  {
+    return true;
+  }
+  for (int i = 0; i < count; ++i)
+  {
+    // まだ始まっていない他のジョブの開始時刻が、実行見込みの終了より前に来るなら見送る
+    unsigned long release = jobs[i].releaseUs;
+    if (i != id && !isAtOrAfter(now, release) && !isAtOrAfter(release, now + job.budgetUs))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+// ────────────────────── 実行 ──────────────────────
+auto DeadlineScheduler::runOnce() -> bool
+{
+  int id = selectJob(nowUs());
+  if (id == INVALID_JOB)
+  {
+    return false;
+  }
+  Job &job = jobs[id];
+  job.run();
+  finishJob(job, nowUs());
+  return true;
+}
+
+void DeadlineScheduler::finishJob(Job &job, unsigned long finishedUs)
+{
+  job.stats.runs++;
+  unsigned long deadline = job.releaseUs + job.deadlineUs;
+  if (!isAtOrAfter(deadline, finishedUs))
+  {
+    unsigned long lateness = finishedUs - deadline;
+    job.stats.misses++;
+    if (lateness > job.stats.worstLatenessUs)
+    {
+      job.stats.worstLatenessUs = lateness;
+    }
+  }
+
+  // 周期の位相を保ったまま次の開始時刻へ進める。
+  // 1 周期以上遅れた場合は溜まった分をまとめて実行せず、次に来る開始時刻まで飛ばす
+  job.releaseUs += job.periodUs;
+  while (isAtOrAfter(finishedUs, job.releaseUs + job.periodUs))
+  {
+    job.releaseUs += job.periodUs;
+    job.stats.skips++;
+  }
+}
+
+auto DeadlineScheduler::timeUntilNextReleaseUs() const -> unsigned long
+{
+  unsigned long now = nowUs();
+  unsigned long nearest = 0;
+  bool found = false;
+  for (int i = 0; i < count; ++i)
+  {
+    if (isAtOrAfter(now, jobs[i].releaseUs))
+    {
+      continue;
+    }
+    unsigned long wait = jobs[i].releaseUs - now;
+    if (!found || wait < nearest)
+    {
+      nearest = wait;
+      found = true;
+    }
+  }
+  return nearest;
+}
@@ -0,0 +1,69 @@
+#ifndef DEADLINE_SCHEDULER_H
+#define DEADLINE_SCHEDULER_H
+
+#include <cstdint>
+
+// ────────────────────── 協調型デッドラインスケジューラ ──────────────────────
+// 周期と締め切りを宣言したジョブを、実行可能なものの中で締め切りが最も近い順に 1 つずつ実行する。
+// ジョブは途中で中断されないため、各ジョブは短時間で戻ること。
+// 時刻は micros() 相当の時計から取得し、32bit の一周（約 71 分）をまたいでも比較できるよう差分で扱う
+class DeadlineScheduler
+{
+ public:
+  using JobFn = void (*)();
+  using MicrosFn = unsigned long (*)();
+
+  static constexpr int MAX_JOBS = 8;
+  static constexpr int INVALID_JOB = -1;
+
+  // ジョブごとの実行統計
+  struct JobStats
+  {
+    uint32_t runs = 0;                  // 実行回数
+    uint32_t misses = 0;                // 締め切りまでに終わらなかった回数
+    uint32_t skips = 0;                 // 遅れにより飛ばした周期の数
+    unsigned long worstLatenessUs = 0;  // 締め切りからの最大超過 [us]
+  };
+
+  explicit DeadlineScheduler(MicrosFn microsFn) : nowUs(microsFn) {}
+
+  // ジョブを登録し、識別番号を返す（満杯なら INVALID_JOB）。
+  // deadlineUs は各周期の開始からの締め切り、budgetUs は想定実行時間（0 なら制約なし）。
+  // budgetUs を持つジョブは、他のジョブの開始時刻までに終わる見込みがあるときだけ実行する
+  auto addJob(const char *name, JobFn run, unsigned long periodUs, unsigned long deadlineUs,
+              unsigned long budgetUs = 0) -> int;
+
+  // 実行可能なジョブを 1 つ実行する。実行した場合 true
+  auto runOnce() -> bool;
+  // 次のジョブの周期開始までの時間 [us]。実行可能なジョブが残っていても未来の開始時刻だけを見る
+  auto timeUntilNextReleaseUs() const -> unsigned long;
+
+  auto jobCount() const -> int { return count; }
+  auto jobName(int id) const -> const char * { return jobs[id].name; }
+  auto stats(int id) const -> const JobStats & { return jobs[id].stats; }
+  void resetStats();
+
+ private:
+  struct Job
+  {
+    const char *name;
+    JobFn run;
+    unsigned long periodUs;
+    unsigned long deadlineUs;
+    unsigned long budgetUs;
+    unsigned long releaseUs;  // 現在の周期の開始時刻
+    JobStats stats;
+  };
+
+  // a が b 以降の時刻か（一周をまたいでも正しく比較する）
+  static auto isAtOrAfter(unsigned long a, unsigned long b) -> bool { return static_cast<long>(a - b) >= 0; }
+  auto selectJob(unsigned long now) const -> int;
+  auto fitsBeforeOtherJobs(int id, unsigned long now) const -> bool;
+  void finishJob(Job &job, unsigned long finishedUs);
+
+  MicrosFn nowUs;
+  Job jobs[MAX_JOBS] = {};
+  int count = 0;
+};
+
+#endif  // DEADLINE_SCHEDULER_H
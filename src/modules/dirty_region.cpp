@@ -0,0 +1,160 @@
+#include "dirty_region.h"
+
+#include <algorithm>
+#include <cmath>
+
+DirtyRegionTracker frameDirtyRegions(LCD_WIDTH, LCD_HEIGHT);
+
+// ────────────────────── 矩形演算 ──────────────────────
+static auto rectArea(const DirtyRect &r) -> int32_t { return static_cast<int32_t>(r.w) * r.h; }
+
+static auto unionRect(const DirtyRect &a, const DirtyRect &b) -> DirtyRect
+{
+  int left = std::min(a.x, b.x);
+  int top = std::min(a.y, b.y);
+  int right = std::max(a.x + a.w, b.x + b.w);
+  int bottom = std::max(a.y + a.h, b.y + b.h);
+  return {static_cast<int16_t>(left), static_cast<int16_t>(top), static_cast<int16_t>(right - left),
+          static_cast<int16_t>(bottom - top)};
+}
+
+// 重なっているか辺で接しているか
+static auto touches(const DirtyRect &a, const DirtyRect &b) -> bool
+{
+  return a.x <= b.x + b.w && b.x <= a.x + a.w && a.y <= b.y + b.h && b.y <= a.y + a.h;
+}
+
+// 統合した場合に増える余分な画素数
+static auto mergeWaste(const DirtyRect &a, const DirtyRect &b) -> int32_t
+{
+  return rectArea(unionRect(a, b)) - rectArea(a) - rectArea(b);
+}
+
+DirtyRegionTracker::DirtyRegionTracker(int screenWidth, int screenHeight)
+    : screenWidth(screenWidth), screenHeight(screenHeight)
+{
+}
+
+void DirtyRegionTracker::markRect(int x, int y, int w, int h)
+{
+  // 画面内にクリップ
+  int left = std::max(x, 0);
+  int top = std::max(y, 0);
+  int right = std::min(x + w, screenWidth);
+  int bottom = std::min(y + h, screenHeight);
+  if (right <= left || bottom <= top)
+  {
+    return;
+  }
+  add({static_cast<int16_t>(left), static_cast<int16_t>(top), static_cast<int16_t>(right - left),
+       static_cast<int16_t>(bottom - top)});
+}
+
+void DirtyRegionTracker::markArc(int centerX, int centerY, int innerRadius, int outerRadius, float startAngle,
+                                 float endAngle)
+{
+  if (endAngle < startAngle)
+  {
+    std::swap(startAngle, endAngle);
+  }
+
+  // 両端の角度における内外周の点を含める
+  float minX = centerX;
+  float maxX = centerX;
+  float minY = centerY;
+  float maxY = centerY;
+  bool first = true;
+  auto include = [&](float angleDeg, int radius)
+  {
+    float rad = angleDeg * static_cast<float>(M_PI) / 180.0F;
+    float px = centerX + (cosf(rad) * radius);
+    float py = centerY + (sinf(rad) * radius);
+    if (first)
+    {
+      minX = maxX = px;
+      minY = maxY = py;
+      first = false;
+      return;
+    }
+    minX = std::min(minX, px);
+    maxX = std::max(maxX, px);
+    minY = std::min(minY, py);
+    maxY = std::max(maxY, py);
+  };
+  include(startAngle, innerRadius);
+  include(startAngle, outerRadius);
+  include(endAngle, innerRadius);
+  include(endAngle, outerRadius);
+
+  // 範囲内に含まれる上下左右の頂点は外周で最大となる
+  for (float axis = std::ceil(startAngle / 90.0F) * 90.0F; axis < endAngle; axis += 90.0F)
+  {
+    include(axis, outerRadius);
+  }
+
+  // 丸め誤差分として 1px 広げる
+  int left = static_cast<int>(std::floor(minX)) - 1;
+  int top = static_cast<int>(std::floor(minY)) - 1;
+  int right = static_cast<int>(std::ceil(maxX)) + 2;
+  int bottom = static_cast<int>(std::ceil(maxY)) + 2;
+  markRect(left, top, right - left, bottom - top);
+}
+
+auto DirtyRegionTracker::byteCount() const -> uint32_t
+{
+  uint32_t pixels = 0;
+  for (int i = 0; i < rectCount; ++i)
+  {
+    pixels += rectArea(rects[i]);
+  }
+  return pixels * (DISPLAY_COLOR_DEPTH / 8);
+}
+
+// ────────────────────── 矩形の追加と統合 ──────────────────────
+void DirtyRegionTracker::add(DirtyRect r)
+{
+  // 接する矩形や統合しても無駄の少ない矩形を吸収し、連鎖的に統合する
+  bool merged = true;
+  while (merged)
+  {
+    merged = false;
+    for (int i = 0; i < rectCount; ++i)
+    {
+      if (touches(r, rects[i]) || mergeWaste(r, rects[i]) <= MERGE_SLACK_PIXELS)
+      {
+        r = unionRect(r, rects[i]);
+        rects[i] = rects[--rectCount];
+        merged = true;
+        break;
+      }
+    }
+  }
+
+  if (rectCount == MAX_RECTS)
+  {
+    mergeClosestPair();
+  }
+  rects[rectCount++] = r;
+}
+
+void DirtyRegionTracker::mergeClosestPair()
+{
+  int bestA = 0;
+  int bestB = 1;
+  int32_t bestWaste = INT32_MAX;
+  for (int a = 0; a < rectCount; ++a)
+  {
+    for (int b = a + 1; b < rectCount; ++b)
+    {
+      int32_t waste = mergeWaste(rects[a], rects[b]);
+      if (waste < bestWaste)
+      {
+        bestWaste = waste;
+        bestA = a;
+        bestB = b;
+      }
+    }
+  }
+  rects[bestA] = unionRect(rects[bestA], rects[bestB]);
+  rects[bestB] = rects[--rectCount];
+}
@@ -0,0 +1,77 @@
+#ifndef DIRTY_REGION_H
+#define DIRTY_REGION_H
+
+#include <cstdint>
+
+#include "config.h"
+
+// 画面上の矩形領域
+struct DirtyRect
+{
+  int16_t x;
+  int16_t y;
+  int16_t w;
+  int16_t h;
+};
+
+// ────────────────────── 更新領域トラッカー ──────────────────────
+// 描画処理が書き換えた領域を記録し、転送時に統合済みの矩形一覧を返す
+class DirtyRegionTracker
+{
+ public:
+  // 保持する矩形の最大数。超えた場合は面積増加が最小となる組を統合する
+  static constexpr int MAX_RECTS = 8;
+  // 統合による余分な転送がこの画素数以下なら、転送回数を減らすため統合する
+  static constexpr int32_t MERGE_SLACK_PIXELS = 512;
+
+  DirtyRegionTracker(int screenWidth, int screenHeight);
+
+  // 記録を空にし、以降の座標を width x height の描画先（ウィジェットのスプライトなど）の座標として扱う
+  void setBounds(int width, int height)
+  {
+    screenWidth = width;
+    screenHeight = height;
+    rectCount = 0;
+  }
+
+  // 矩形領域を更新済みとして記録する（画面外は切り捨てる）
+  void markRect(int x, int y, int w, int h);
+  // fillArc と同じ角度指定（度・時計回り、0 が右）の扇形領域を記録する
+  void markArc(int centerX, int centerY, int innerRadius, int outerRadius, float startAngle, float endAngle);
+  // 画面全体を更新済みとして記録する
+  void markAll() { markRect(0, 0, screenWidth, screenHeight); }
+  void clear() { rectCount = 0; }
+
+  auto isEmpty() const -> bool { return rectCount == 0; }
+  auto count() const -> int { return rectCount; }
+  auto rect(int index) const -> const DirtyRect & { return rects[index]; }
+  // 記録済み領域の転送バイト数
+  auto byteCount() const -> uint32_t;
+  // 記録済みの矩形のいずれかが指定の矩形と重なるか（このフレームで上書きされたかの判定に使う）
+  auto overlaps(int x, int y, int w, int h) const -> bool
+  {
+    for (int i = 0; i < rectCount; ++i)
+    {
+      const DirtyRect &r = rects[i];
+      if (r.x < x + w && x < r.x + r.w && r.y < y + h && y < r.y + r.h)
+      {
+        return true;
+      }
+    }
+    return false;
+  }
+
+ private:
+  void add(DirtyRect r);
+  void mergeClosestPair();
+
+  int screenWidth;
+  int screenHeight;
+  int rectCount = 0;
+  DirtyRect rects[MAX_RECTS] = {};
+};
+
+// フレーム単位で描画処理が共有するトラッカー
+extern DirtyRegionTracker frameDirtyRegions;
+
+#endif  // DIRTY_REGION_H
@@ -1,34 +1,101 @@
 #include "display.h"
 
+#include <esp_heap_caps.h>
+
 #include <algorithm>
 #include <cmath>
 #include <cstdio>
+#include <cstring>
 #include <limits>
 
 #include "DrawFillArcMeter.h"
 #include "backlight.h"
+#include "canvas_palette.h"
+#include "dirty_region.h"
+#include "display_list.h"
 #include "fps_display.h"
+#include "frame_profiler.h"
+#include "glyph_cache.h"
 #include "low_warning.h"
 #include "racing_indicator.h"
 #include "sensor.h"
+#include "starvation_map.h"
+#include "streaming_stats.h"
 
 // ────────────────────── グローバル変数 ──────────────────────
 M5GFX display;
 M5Canvas mainCanvas(&display);
 
+// ────────────────────── ウィジェット ──────────────────────
+// ゲージ画面の部品はそれぞれ自分の大きさのスプライトへ描き、変化した領域だけを自分の画面位置へ転送する。
+// 部品の間の余白（上部バーとゲージの間、画面下端）はバッファを持たず、パネル上で黒のまま残す
+constexpr int TOPBAR_H = 50;
+constexpr int TOPBAR_VALUE_WIDTH = 85;  // 上部バー右端の油温の数値欄の幅
+constexpr int GAUGE_Y = 60;
+constexpr int GAUGE_W = 160;
+constexpr int GAUGE_H = 170;
+constexpr int FPS_W = 30;
+constexpr int FPS_H = 8;
+
+struct Widget
+{
+  Widget(int x, int y, int w, int h) : canvas(&display), x(x), y(y), w(w), h(h) {}
+
+  M5Canvas canvas;
+  int16_t x;  // 画面上の左上
+  int16_t y;
+  int16_t w;
+  int16_t h;
+};
+
+static Widget topBarWidget(0, 0, LCD_WIDTH, TOPBAR_H);
+static Widget pressureWidget(0, GAUGE_Y, GAUGE_W, GAUGE_H);  // 低油圧警告とレーシング中表示を含む
+static Widget waterWidget(GAUGE_W, GAUGE_Y, GAUGE_W, GAUGE_H);
+static Widget fpsWidget(0, LCD_HEIGHT - FPS_H, FPS_W, FPS_H);
+static Widget *const gaugeScreenWidgets[] = {&topBarWidget, &pressureWidget, &waterWidget, &fpsWidget};
+
+// ゲージの静的な部分だけを描いた背景レイヤー（ゲージのスプライトと同じ大きさ）。
+// 警告表示などの消去と、メニューから戻ったときの再表示はここからの複写で行う
+static M5Canvas pressureBackground;
+static M5Canvas waterBackground;
+
+// 確保済みの背景レイヤー。無ければ nullptr（従来どおり黒で塗り、静的な部分を描き直す）
+static auto gaugeBackground(const M5Canvas &layer) -> const M5Canvas *
+{
+  return (layer.getBuffer() != nullptr && layer.width() > 0) ? &layer : nullptr;
+}
+
 static bool pressureGaugeInitialized = false;
 static bool waterGaugeInitialized = false;
 
-float recordedMaxOilPressure = 0.0F;
-float recordedMaxWaterTemp = 0.0F;
-int recordedMaxOilTempTop = 0;
+// 起動またはセンサー異常からの最大値（メニューに表示）
+static PeakHold<float> recordedMaxOilPressure;
+static PeakHold<float> recordedMaxWaterTemp;
+static PeakHold<int> recordedMaxOilTempTop;
 // 前回の油圧測定時刻
 static unsigned long lastPressureCheckMs = 0;
 
+// 転送量の計測値
+uint32_t lastFramePushedBytes = 0;
+uint32_t totalPushedBytes = 0;
+
 // 前回描画したゲージ値
 static float prevPressureValue = std::numeric_limits<float>::quiet_NaN();
 static float prevWaterTempValue = std::numeric_limits<float>::quiet_NaN();
 
+// ゲージ仕様（目盛やラベル座標は起動時に一度だけ計算する）。座標は各ゲージのスプライト内
+static const GaugeSpec pressureGaugeSpec = buildGaugeSpec(
+    {0.0f, MAX_OIL_PRESSURE_METER, 8.0f, COLOR_RED, "x100kPa", "OIL.P", 0.5f, -1.0f, 0.0f, 0, 0, false});
+static const GaugeSpec waterGaugeSpec =
+    buildGaugeSpec({WATER_TEMP_METER_MIN, WATER_TEMP_METER_MAX, 110.0f, COLOR_RED, "Celsius", "WATER.T", 1.0f, 5.0f,
+                    WATER_TEMP_METER_MIN, 0, 0, true});
+
+// 大きな数値表示の数字グリフと、それを使う数値欄（initDisplayBuffers() で配置する）
+static DigitGlyphCache valueGlyphs;
+static GlyphField pressureValueField;
+static GlyphField waterValueField;
+static GlyphField oilTempValueField;
+
 struct DisplayCache
 {
   float pressureAvg;
@@ -39,6 +106,17 @@ struct DisplayCache
                   std::numeric_limits<float>::quiet_NaN(), INT16_MIN};
 
 // ────────────────────── 油温バー描画 ──────────────────────
+// 上部バーのスプライトには前回までの内容が残っているため、目盛・ラベル・見出しの静的な部分は最初に一度だけ描き、
+// 以降はバーの伸び縮みした範囲と、変わった数字・MAX 欄だけを描き直す
+struct TopBarState
+{
+  bool isStaticDrawn = false;
+  int barWidth = 0;      // 描画済みのバーの幅
+  bool isAlert = false;  // バーを赤で描いているか
+  int maxOilTemp = -1;   // 描画済みの MAX 欄（-1: 未描画）
+};
+static TopBarState topBarState;
+
 void drawOilTemperatureTopBar(M5Canvas& canvas, float oilTemp, int maxOilTemp)
 {
   constexpr int MIN_TEMP = 80;
@@ -50,8 +128,38 @@ void drawOilTemperatureTopBar(M5Canvas& canvas, float oilTemp, int maxOilTemp)
   constexpr int W = 210;
   constexpr int H = 20;
   constexpr float RANGE = MAX_TEMP - MIN_TEMP;
+  constexpr int ALERT_X = static_cast<int>(W * (ALERT_TEMP - MIN_TEMP) / RANGE);  // 警告線のバー内の位置
+  constexpr int CAPTION_Y = Y + H + 4;
+  static constexpr char CAPTION[] = "OIL.T / Celsius,  MAX:";
+  const uint16_t BAR_BACKGROUND = canvasColor(0x18E3);
 
-  canvas.fillRect(X + 1, Y + 1, W - 2, H - 2, 0x18E3);
+  canvas.setTextSize(1);
+  canvas.setTextColor(canvasColor(COLOR_WHITE));
+  canvas.setFont(&fonts::Font0);
+
+  auto drawAlertLine = [&]() { canvas.drawLine(X + ALERT_X, Y, X + ALERT_X, Y + H - 2, canvasColor(COLOR_GRAY)); };
+
+  if (!topBarState.isStaticDrawn)
+  {
+    canvas.fillScreen(canvasColor(COLOR_BLACK));
+    canvas.fillRect(X + 1, Y + 1, W - 2, H - 2, BAR_BACKGROUND);
+    const int marks[] = {80, 90, 100, 110, 120, 130};
+    for (int m : marks)
+    {
+      int tx = X + static_cast<int>(W * (m - MIN_TEMP) / RANGE);
+      canvas.drawPixel(tx, Y - 2, canvasColor(COLOR_WHITE));
+      canvas.setCursor(tx - 10, Y - 14);
+      canvas.printf("%d", m);
+    }
+    drawAlertLine();
+    canvas.setCursor(X, CAPTION_Y);
+    canvas.print(CAPTION);
+    // 静的な部分を描いたときだけ帯全体を転送対象にする
+    frameDirtyRegions.markRect(0, 0, LCD_WIDTH, TOPBAR_H);
+    oilTempValueField.invalidate();
+    topBarState = {};
+    topBarState.isStaticDrawn = true;
+  }
 
   float drawTemp = oilTemp;
   if (drawTemp >= 199.0F)
@@ -60,56 +168,339 @@ void drawOilTemperatureTopBar(M5Canvas& canvas, float oilTemp, int maxOilTemp)
     drawTemp = 0.0F;
   }
 
+  // バーは目盛の範囲に収め、130℃ を超えても数値欄へはみ出さない
+  int barWidth = 0;
   if (drawTemp >= MIN_TEMP)
   {
-    int barWidth = static_cast<int>(W * (drawTemp - MIN_TEMP) / RANGE);
-    uint16_t barColor = (drawTemp >= ALERT_TEMP) ? COLOR_RED : COLOR_WHITE;
-    canvas.fillRect(X, Y, barWidth, H, barColor);
+    barWidth = std::min(static_cast<int>(W * (drawTemp - MIN_TEMP) / RANGE), W);
   }
+  bool isAlert = drawTemp >= ALERT_TEMP;
 
-  const int marks[] = {80, 90, 100, 110, 120, 130};
-  canvas.setTextSize(1);
-  canvas.setTextColor(COLOR_WHITE);
-  canvas.setFont(&fonts::Font0);
+  // バー内の [from, to) をバーの色で塗る、または背景へ戻す（背景は上下左右 1px 内側だけ灰色）
+  auto fillBar = [&](int from, int to, uint16_t color)
+  {
+    canvas.fillRect(X + from, Y, to - from, H, color);
+    frameDirtyRegions.markRect(X + from, Y, to - from, H);
+  };
+  auto clearBar = [&](int from, int to)
+  {
+    canvas.fillRect(X + from, Y, to - from, H, canvasColor(COLOR_BLACK));
+    int innerFrom = std::max(from, 1);
+    int innerTo = std::min(to, W - 1);
+    if (innerTo > innerFrom)
+    {
+      canvas.fillRect(X + innerFrom, Y + 1, innerTo - innerFrom, H - 2, BAR_BACKGROUND);
+    }
+    frameDirtyRegions.markRect(X + from, Y, to - from, H);
+  };
+
+  // 円弧メーターと同様に、前回の幅との差分だけを描く。色が変わるときはバー全体を塗り替える
+  int previousWidth = topBarState.barWidth;
+  uint16_t barColor = isAlert ? canvasColor(COLOR_RED) : canvasColor(COLOR_WHITE);
+  int changedFrom = std::min(barWidth, previousWidth);
+  int changedTo = std::max(barWidth, previousWidth);
+  if (isAlert != topBarState.isAlert && barWidth > 0)
+  {
+    changedFrom = 0;
+    fillBar(0, barWidth, barColor);
+  }
+  else if (barWidth > previousWidth)
+  {
+    fillBar(previousWidth, barWidth, barColor);
+  }
+  if (barWidth < previousWidth)
+  {
+    clearBar(barWidth, previousWidth);
+  }
+  if (changedTo > changedFrom && ALERT_X >= changedFrom && ALERT_X < changedTo)
+  {
+    // 警告線はバーの上に重ねて描く
+    drawAlertLine();
+  }
+  topBarState.barWidth = barWidth;
+  topBarState.isAlert = isAlert;
 
-  for (int m : marks)
+  if (maxOilTemp != topBarState.maxOilTemp)
   {
-    int tx = X + static_cast<int>(W * (m - MIN_TEMP) / RANGE);
-    canvas.drawPixel(tx, Y - 2, COLOR_WHITE);
-    canvas.setCursor(tx - 10, Y - 14);
-    canvas.printf("%d", m);
-    if (m == ALERT_TEMP) canvas.drawLine(tx, Y, tx, Y + H - 2, COLOR_GRAY);
+    // MAX 欄（3 桁、異常値でも 4 桁まで）だけを塗り直す
+    int fieldX = X + canvas.textWidth(CAPTION);
+    int fieldW = canvas.textWidth("0000");
+    canvas.fillRect(fieldX, CAPTION_Y, fieldW, canvas.fontHeight(), canvasColor(COLOR_BLACK));
+    canvas.setCursor(fieldX, CAPTION_Y);
+    canvas.printf("%03d", maxOilTemp);
+    frameDirtyRegions.markRect(fieldX, CAPTION_Y, fieldW, canvas.fontHeight());
+    topBarState.maxOilTemp = maxOilTemp;
   }
 
-  canvas.setCursor(X, Y + H + 4);
-  canvas.printf("OIL.T / Celsius,  MAX:%03d", maxOilTemp);
   // snprintf でバッファサイズを指定し、
   // 安全に文字列化する
   int displayOilTemp = oilTemp >= 199.0F ? 0 : static_cast<int>(oilTemp);
   char tempStr[8];
   snprintf(tempStr, sizeof(tempStr), "%d", displayOilTemp);
+  // 変化した桁だけを複写する
+  if (oilTempValueField.draw(canvas, tempStr))
+  {
+    return;
+  }
+  // グリフのキャッシュが使えない場合は数値欄を塗り直してフォントで描く
+  constexpr int VALUE_RIGHT = LCD_WIDTH - 1;
+  constexpr int VALUE_TOP = 2;
   canvas.setFont(&FreeSansBold24pt7b);
-  canvas.drawRightString(tempStr, LCD_WIDTH - 1, 2);
+  canvas.fillRect(VALUE_RIGHT - TOPBAR_VALUE_WIDTH, VALUE_TOP, TOPBAR_VALUE_WIDTH, canvas.fontHeight(),
+                  canvasColor(COLOR_BLACK));
+  frameDirtyRegions.markRect(VALUE_RIGHT - TOPBAR_VALUE_WIDTH, VALUE_TOP, TOPBAR_VALUE_WIDTH, canvas.fontHeight());
+  canvas.drawRightString(tempStr, VALUE_RIGHT, VALUE_TOP);
+}
+
+// ────────────────────── 更新領域の転送 ──────────────────────
+// DMA 転送中の画素を保持する第2バッファ。確保できなければ同期転送になる。
+// 大きさは最大のウィジェット分で、これを超える転送（メニューの全画面など）は同期転送で送る。
+// ウィジェットごとの転送は前の転送の後ろへ続けて詰め、空きが無くなったときだけ完了を待って先頭へ戻る
+constexpr size_t TRANSFER_BUFFER_PIXELS = static_cast<size_t>(GAUGE_W) * GAUGE_H;
+static_assert(TRANSFER_BUFFER_PIXELS >= static_cast<size_t>(LCD_WIDTH) * TOPBAR_H, "上部バーが一度に送れること");
+static uint16_t *transferBuffer = nullptr;
+static bool isTransferInFlight = false;
+static size_t transferUsedPixels = 0;  // 前回の完了待ち以降に転送へ渡した画素数（次に詰める位置）
+static bool areWidgetSpritesReady = false;  // ゲージ画面の部品のスプライトがすべて確保できたか
+#if CANVAS_PALETTE_BITS
+// パレット番号 → パネルのバイト順の RGB565
+static lgfx::swap565_t transferPalette[1 << CANVAS_PALETTE_BITS];
+#endif
+
+// ゲージの静的な部分を背景レイヤーへ描く。複写元として読むだけなので PSRAM に置く
+static void buildGaugeBackground(M5Canvas &layer, const GaugeSpec &spec)
+{
+  layer.setColorDepth(CANVAS_COLOR_DEPTH);
+  layer.setPsram(true);
+  if (layer.createSprite(GAUGE_W, GAUGE_H) == nullptr)
+  {
+    Serial.println("[Display] gauge background allocation failed, redrawing static parts instead");
+    return;
+  }
+#if CANVAS_PALETTE_BITS
+  applyCanvasPalette(layer);
+#endif
+  layer.fillScreen(canvasColor(COLOR_BLACK));
+  drawGaugeFace(layer, spec);
+}
+
+// ゲージ画面の部品のスプライトを確保する。起動時に一度だけ呼び、以降は解放しない。
+// 1 つでも確保できなければ false を返し、ゲージ画面は描かない
+static auto createWidgetSprites() -> bool
+{
+  bool isComplete = true;
+  for (Widget *widget : gaugeScreenWidgets)
+  {
+#if !FPS_DISPLAY_ENABLED
+    if (widget == &fpsWidget)
+    {
+      continue;
+    }
+#endif
+    widget->canvas.setColorDepth(CANVAS_COLOR_DEPTH);
+    widget->canvas.setTextSize(1);
+    // 描画と転送の速さが要るため DMA 可能な内部 RAM に確保
+    widget->canvas.setPsram(false);
+    if (widget->canvas.createSprite(widget->w, widget->h) == nullptr)
+    {
+      Serial.printf("[Display] widget sprite %dx%d allocation failed\n", widget->w, widget->h);
+      isComplete = false;
+      continue;
+    }
+#if CANVAS_PALETTE_BITS
+    applyCanvasPalette(widget->canvas);
+#endif
+    widget->canvas.fillScreen(canvasColor(COLOR_BLACK));
+  }
+  return isComplete;
+}
+
+// メニュー系の画面の描画先。表示のたびに確保し直すと内部 RAM が断片化するため、起動時に一度だけ PSRAM に確保する。
+// 描くのは画面を開いたときの 1 回だけなので、PSRAM の遅さはフレーム時間に影響しない
+static void createMainCanvas()
+{
+  mainCanvas.setPsram(true);
+  if (mainCanvas.createSprite(LCD_WIDTH, LCD_HEIGHT) == nullptr)
+  {
+    Serial.println("[Display] main canvas allocation failed, menu screens are disabled");
+    return;
+  }
+#if CANVAS_PALETTE_BITS
+  applyCanvasPalette(mainCanvas);
+#endif
+}
+
+void initDisplayBuffers()
+{
+  areWidgetSpritesReady = createWidgetSprites();
+  createMainCanvas();
+
+#if GAUGE_BACKGROUND_LAYER_ENABLED
+  buildGaugeBackground(pressureBackground, pressureGaugeSpec);
+  buildGaugeBackground(waterBackground, waterGaugeSpec);
+#endif
+
+#if CANVAS_PALETTE_BITS
+  for (int i = 0; i < CANVAS_PALETTE_SIZE; ++i)
+  {
+    transferPalette[i] = lgfx::swap565_t(rgb565Red(CANVAS_PALETTE[i]), rgb565Green(CANVAS_PALETTE[i]),
+                                         rgb565Blue(CANVAS_PALETTE[i]));
+  }
+#endif
+#if DOUBLE_BUFFER_ENABLED
+  transferBuffer =
+      static_cast<uint16_t *>(heap_caps_malloc(TRANSFER_BUFFER_PIXELS * sizeof(uint16_t), MALLOC_CAP_DMA));
+  if (transferBuffer == nullptr)
+  {
+    Serial.println("[Display] double buffer allocation failed, using synchronous push");
+  }
+#endif
+#if VALUE_GLYPH_CACHE_ENABLED
+  // 数値はすべて黒地に白の FreeSansBold24pt7b。確保できなければ従来どおりフォントで描く
+  if (valueGlyphs.build(&FreeSansBold24pt7b, canvasColor(COLOR_WHITE), canvasColor(COLOR_BLACK)))
+  {
+    int halfCell = valueGlyphs.cellHeight() / 2;
+    pressureValueField = GlyphField(valueGlyphs, pressureGaugeSpec.valueBaseX,
+                                    pressureGaugeSpec.valueCenterY - halfCell, GAUGE_VALUE_WIDTH);
+    waterValueField =
+        GlyphField(valueGlyphs, waterGaugeSpec.valueBaseX, waterGaugeSpec.valueCenterY - halfCell, GAUGE_VALUE_WIDTH);
+    oilTempValueField = GlyphField(valueGlyphs, LCD_WIDTH - 1, 2, TOPBAR_VALUE_WIDTH);
+  }
+  else
+  {
+    Serial.println("[Display] glyph cache allocation failed, drawing values with the font");
+  }
+#endif
+}
+
+auto isDisplayTransferOverlapped() -> bool { return transferBuffer != nullptr; }
+
+// 前フレームの DMA 転送完了を待ち、バスを解放する
+void waitDisplayTransfer()
+{
+  if (isTransferInFlight)
+  {
+    display.waitDMA();
+    display.endWrite();
+    isTransferInFlight = false;
+  }
+  transferUsedPixels = 0;
+}
+
+// 更新領域を第2バッファへ詰めて複製し、完了を待たずに DMA 転送する。
+// 転送中の画素の後ろに空きがあれば待たずに詰めるため、前のウィジェットの転送中に次のウィジェットの複製が進む。
+// パネルへの SPI バスは 1 本なので、DMA の開始そのものは前の転送の終わりを待つ。
+// 描画は常に canvas 上で続けるため、前フレームの内容を引き継ぐ差分描画はそのまま成立する
+static void pushDirtyRegionsOverlapped(M5Canvas &canvas, int originX, int originY, size_t pixels)
+{
+  if (transferUsedPixels + pixels > TRANSFER_BUFFER_PIXELS)
+  {
+    waitDisplayTransfer();
+  }
+
+  if (!isTransferInFlight)
+  {
+    display.startWrite();
+  }
+  const uint8_t *source = static_cast<const uint8_t *>(canvas.getBuffer());
+  const size_t SOURCE_ROW_BYTES = CanvasFormat::rowBytes(canvas.width());
+  size_t offset = transferUsedPixels;
+  for (int i = 0; i < frameDirtyRegions.count(); ++i)
+  {
+    const DirtyRect &r = frameDirtyRegions.rect(i);
+    uint16_t *packed = transferBuffer + offset;
+    for (int row = 0; row < r.h; ++row)
+    {
+      const uint8_t *sourceRow = source + ((r.y + row) * SOURCE_ROW_BYTES);
+#if CANVAS_PALETTE_BITS
+      // パレット番号をここで初めて RGB565 へ展開する
+      CanvasFormat::expand(sourceRow, r.x, r.w, transferPalette, packed + (row * r.w));
+#else
+      memcpy(packed + (row * r.w), sourceRow + (r.x * sizeof(uint16_t)), r.w * sizeof(uint16_t));
+#endif
+    }
+    // キャンバスはパネルと同じバイト順で保持しているため変換なしで送る
+    display.pushImageDMA(originX + r.x, originY + r.y, r.w, r.h, reinterpret_cast<const lgfx::swap565_t *>(packed));
+    offset += static_cast<size_t>(r.w) * r.h;
+  }
+  // endWrite は次回の waitDisplayTransfer() まで遅らせ、転送中に次のウィジェットやフレームを描画する
+  transferUsedPixels = offset;
+  isTransferInFlight = true;
+}
+
+// canvas に記録された更新領域のみを、canvas の画面位置 (originX, originY) を基準に転送し、転送量を集計する
+static void pushDirtyRegions(M5Canvas &canvas, int originX, int originY)
+{
+  PROFILE_STAGE(Push);
+  if (canvas.getBuffer() == nullptr)
+  {
+    // 確保できなかったスプライトは転送せず、記録した更新領域だけを捨てる
+    frameDirtyRegions.clear();
+    return;
+  }
+  uint32_t bytes = frameDirtyRegions.byteCount();
+  if (transferBuffer != nullptr && bytes <= TRANSFER_BUFFER_PIXELS * sizeof(uint16_t))
+  {
+    pushDirtyRegionsOverlapped(canvas, originX, originY, bytes / sizeof(uint16_t));
+  }
+  else
+  {
+    // 第2バッファに収まらない場合も、転送中の DMA を待ってからバスを使う
+    waitDisplayTransfer();
+    for (int i = 0; i < frameDirtyRegions.count(); ++i)
+    {
+      const DirtyRect &r = frameDirtyRegions.rect(i);
+      display.setClipRect(originX + r.x, originY + r.y, r.w, r.h);
+      canvas.pushSprite(originX, originY);
+    }
+    display.clearClipRect();
+  }
+  frameDirtyRegions.clear();
+
+  lastFramePushedBytes += bytes;
+  totalPushedBytes += bytes;
+}
+
+// 以降の描画で記録する更新領域をウィジェット内の座標にする
+static void beginWidget(const Widget &widget) { frameDirtyRegions.setBounds(widget.w, widget.h); }
+
+// ウィジェットの変化した領域だけを、その画面位置へ転送する
+static void flushWidget(Widget &widget)
+{
+  if (!frameDirtyRegions.isEmpty())
+  {
+    pushDirtyRegions(widget.canvas, widget.x, widget.y);
+  }
+}
+
+// メニュー系の画面は mainCanvas 全体を転送する
+static void pushMainCanvas()
+{
+  lastFramePushedBytes = 0;
+  frameDirtyRegions.setBounds(LCD_WIDTH, LCD_HEIGHT);
+  frameDirtyRegions.markAll();
+  pushDirtyRegions(mainCanvas, 0, 0);
 }
 
 // ────────────────────── 画面更新＋ログ ──────────────────────
 void renderDisplayAndLog(float pressureAvg, float waterTempAvg, float oilTemp, int16_t maxOilTemp)
 {
-  const int TOPBAR_Y = 0;
-  const int TOPBAR_H = 50;
-  const int GAUGE_H = 170;
-
   // 水温は0.05度以上、油温は0.1度以上、油圧は0.05bar以上変化したら更新する
   bool oilChanged = std::isnan(displayCache.oilTemp) || fabs(oilTemp - displayCache.oilTemp) >= 0.1F ||
                     (maxOilTemp != displayCache.maxOilTemp);
   bool pressureChanged = std::isnan(displayCache.pressureAvg) || fabs(pressureAvg - displayCache.pressureAvg) >= 0.05F;
   bool waterChanged = std::isnan(displayCache.waterTempAvg) || fabs(waterTempAvg - displayCache.waterTempAvg) >= 0.05F;
 
-  mainCanvas.setTextColor(COLOR_WHITE);
+  // 各ウィジェットは描き終えた時点で自分の更新領域だけを転送する
+  lastFramePushedBytes = 0;
+  if (!areWidgetSpritesReady)
+  {
+    return;
+  }
 
+  beginWidget(topBarWidget);
   if (oilChanged)
   {
-    mainCanvas.fillRect(0, TOPBAR_Y, LCD_WIDTH, TOPBAR_H, COLOR_BLACK);
     if (oilTemp >= 199.0F)
     {
       // センサー異常時は最大値も 0 扱いにする
@@ -119,66 +510,68 @@ void renderDisplayAndLog(float pressureAvg, float waterTempAvg, float oilTemp, i
     {
       maxOilTemp = std::max<float>(oilTemp, maxOilTemp);
     }
-    drawOilTemperatureTopBar(mainCanvas, oilTemp, maxOilTemp);
+    drawOilTemperatureTopBar(topBarWidget.canvas, oilTemp, maxOilTemp);
     displayCache.oilTemp = oilTemp;
     displayCache.maxOilTemp = maxOilTemp;
   }
+  flushWidget(topBarWidget);
 
+  // 油圧ゲージには低油圧警告とレーシング中表示が重なる
+  M5Canvas &pressureCanvas = pressureWidget.canvas;
+  const M5Canvas *pressureFace = gaugeBackground(pressureBackground);
+  beginWidget(pressureWidget);
   if (pressureChanged || !pressureGaugeInitialized)
   {
-    if (!pressureGaugeInitialized)
-    {
-      mainCanvas.fillRect(0, 60, 160, GAUGE_H, COLOR_BLACK);
-    }
     bool isUseDecimal = pressureAvg < 9.95F;
-    drawFillArcMeter(mainCanvas, pressureAvg, 0.0f, MAX_OIL_PRESSURE_METER, 8.0f, COLOR_RED, "x100kPa", "OIL.P",
-                     prevPressureValue, 0.5f, isUseDecimal, 0, 60, !pressureGaugeInitialized);
+    drawFillArcMeter(pressureCanvas, pressureGaugeSpec, pressureAvg, prevPressureValue, isUseDecimal,
+                     !pressureGaugeInitialized, &pressureValueField, pressureFace);
     pressureGaugeInitialized = true;
     displayCache.pressureAvg = pressureAvg;
   }
 
-  if (waterChanged || !waterGaugeInitialized)
+  bool warnChanged = false;
+  bool isWarnShowing =
+      drawLowPressureWarning(pressureCanvas, currentGForce, currentGForcePeak, pressureAvg, warnChanged, pressureFace);
+  if (warnChanged)
   {
-    if (!waterGaugeInitialized)
-    {
-      mainCanvas.fillRect(160, 60, 160, GAUGE_H, COLOR_BLACK);
-    }
-    drawFillArcMeter(mainCanvas, waterTempAvg, WATER_TEMP_METER_MIN, WATER_TEMP_METER_MAX, 110.0f, COLOR_RED, "Celsius",
-                     "WATER.T", prevWaterTempValue, 1.0f, false, 160, 60, !waterGaugeInitialized, 5.0f,
-                     WATER_TEMP_METER_MIN);
-    waterGaugeInitialized = true;
-    displayCache.waterTempAvg = waterTempAvg;
+    // 警告の表示・消去で数値欄の一部が上書きされるため、次に描くときは全桁を描き直す
+    pressureValueField.invalidate();
   }
-
-  bool warnChanged = false;
-  bool isWarnShowing = drawLowPressureWarning(mainCanvas, currentGForce, pressureAvg, warnChanged);
   if (warnChanged && !isWarnShowing)
   {
     // 警告が消えたら油圧ゲージを再描画して元に戻す
     bool isUseDecimal = pressureAvg < 9.95F;
-    drawFillArcMeter(mainCanvas, pressureAvg, 0.0f, MAX_OIL_PRESSURE_METER, 8.0f, COLOR_RED, "x100kPa", "OIL.P",
-                     prevPressureValue, 0.5f, isUseDecimal, 0, 60, false);
+    drawFillArcMeter(pressureCanvas, pressureGaugeSpec, pressureAvg, prevPressureValue, isUseDecimal, false,
+                     &pressureValueField, pressureFace);
   }
-  bool fpsChanged = false;
-#if FPS_DISPLAY_ENABLED
-  // FPS表示が有効な場合のみ描画する
-  fpsChanged = drawFpsOverlay();
-#endif
-  bool racingChanged = drawRacingIndicator(mainCanvas);
+  drawRacingIndicator(pressureCanvas, pressureFace);
+  flushWidget(pressureWidget);
 
-  // 値が更新されたときのみスプライトを転送する
-  if (oilChanged || pressureChanged || waterChanged || fpsChanged || warnChanged || racingChanged)
+  beginWidget(waterWidget);
+  if (waterChanged || !waterGaugeInitialized)
   {
-    mainCanvas.pushSprite(0, 0);
+    drawFillArcMeter(waterWidget.canvas, waterGaugeSpec, waterTempAvg, prevWaterTempValue, false,
+                     !waterGaugeInitialized, &waterValueField, gaugeBackground(waterBackground));
+    waterGaugeInitialized = true;
+    displayCache.waterTempAvg = waterTempAvg;
   }
+  flushWidget(waterWidget);
+
+#if FPS_DISPLAY_ENABLED
+  // FPS表示が有効な場合のみ描画する
+  beginWidget(fpsWidget);
+  drawFpsOverlay(fpsWidget.canvas);
+  flushWidget(fpsWidget);
+#endif
 }
 
 // ────────────────────── メーター描画更新 ──────────────────────
 void updateGauges()
 {
-  static float smoothWaterTemp = std::numeric_limits<float>::quiet_NaN();
-  static float smoothOilTemp = std::numeric_limits<float>::quiet_NaN();
-  static float smoothOilPressure = std::numeric_limits<float>::quiet_NaN();
+  // 平均・平滑化・制限は固定小数点で行い、描画の直前に float へ戻す
+  auto &oilPressure = sensorChannel<SensorChannelId::OilPressure>();
+  auto &waterTemp = sensorChannel<SensorChannelId::WaterTemp>();
+  auto &oilTemp = sensorChannel<SensorChannelId::OilTemp>();
   unsigned long nowMs = millis();
   if (lastPressureCheckMs == 0)
   {
@@ -187,73 +580,96 @@ void updateGauges()
   unsigned long deltaMs = nowMs - lastPressureCheckMs;
   lastPressureCheckMs = nowMs;
 
-  float pressureAvg = calculateAverage(oilPressureSamples);
-  pressureAvg = std::min(pressureAvg, MAX_OIL_PRESSURE_DISPLAY);
-  if (pressureAvg >= 11.0F || oilPressureOverVoltage)
+  // ショート・センサー異常時は 0 として扱い、最大値もリセット
+  bool hasFault = false;
+  auto pressureAvg = oilPressure.displayTarget(hasFault);
+  bool pressureFault = hasFault;
+  if (hasFault)
   {
-    // ショートエラー時は 0 として扱い、最大値もリセット
-    pressureAvg = 0.0F;
-    recordedMaxOilPressure = 0.0F;
+    recordedMaxOilPressure.reset();
   }
-  float targetWaterTemp = calculateAverage(waterTemperatureSamples);
-  if (targetWaterTemp >= 199.0F)
+  auto targetWaterTemp = waterTemp.displayTarget(hasFault);
+  if (hasFault)
   {
-    // 199℃以上ならセンサー異常として扱い0を返す
-    targetWaterTemp = 0.0F;
-    recordedMaxWaterTemp = 0.0F;
+    recordedMaxWaterTemp.reset();
   }
-
-  float targetOilTemp = calculateAverage(oilTemperatureSamples);
-  if (targetOilTemp >= 199.0F)
+  auto targetOilTemp = oilTemp.displayTarget(hasFault);
+  if (hasFault)
   {
-    // 199℃以上はセンサー異常として 0 扱いにする
-    targetOilTemp = 0.0F;
-    recordedMaxOilTempTop = 0;
+    recordedMaxOilTempTop.reset();
   }
 
-  if (std::isnan(smoothWaterTemp))
+  float waterTempValue = waterTemp.smooth(targetWaterTemp).toFloat();
+  float oilTempValue = oilTemp.smooth(targetOilTemp).toFloat();
+  float pressureValue = oilPressure.smooth(pressureAvg).toFloat();
+#if OIL_STARVATION_MAP_ENABLED
+  // 油圧が正常に取れているフレームだけ、G と表示中の油圧の分布へ加える
+  if (oilPressure.SPEC.present && !pressureFault)
   {
-    smoothWaterTemp = targetWaterTemp;
-  }
-  if (std::isnan(smoothOilTemp))
-  {
-    smoothOilTemp = targetOilTemp;
-  }
-  if (std::isnan(smoothOilPressure))
-  {
-    smoothOilPressure = pressureAvg;
+    starvationMap.record(currentGForce, currentGDirection, pressureValue);
   }
+#endif
 
-  smoothWaterTemp += 0.1F * (targetWaterTemp - smoothWaterTemp);
-  smoothOilTemp += 0.1F * (targetOilTemp - smoothOilTemp);
-  smoothOilPressure += OIL_PRESSURE_SMOOTHING_ALPHA * (pressureAvg - smoothOilPressure);
+  recordedMaxOilPressure.update(pressureAvg.toFloat());
+  recordedMaxWaterTemp.update(waterTempValue);
+  int maxOilTempTop = recordedMaxOilTempTop.update(targetOilTemp.toInt());
+  renderDisplayAndLog(pressureValue, waterTempValue, oilTempValue, maxOilTempTop);
+}
 
-  float oilTempValue = smoothOilTemp;
-  float pressureValue = smoothOilPressure;
-#if !SENSOR_OIL_TEMP_PRESENT
-  // センサーが無い場合は常に 0 表示
-  oilTempValue = 0.0F;
-#endif
+void recordedMaxValues(float &maxOilPressure, float &maxWaterTemp, int &maxOilTemp)
+{
+  maxOilPressure = recordedMaxOilPressure.value();
+  maxWaterTemp = recordedMaxWaterTemp.value();
+  maxOilTemp = recordedMaxOilTempTop.value();
+}
 
-  recordedMaxOilPressure = std::max(recordedMaxOilPressure, pressureAvg);
-  recordedMaxWaterTemp = std::max(recordedMaxWaterTemp, smoothWaterTemp);
-  recordedMaxOilTempTop = std::max(recordedMaxOilTempTop, static_cast<int>(targetOilTemp));
-  renderDisplayAndLog(pressureValue, smoothWaterTemp, oilTempValue, recordedMaxOilTempTop);
+void restoreRecordedMaxValues(float maxOilPressure, float maxWaterTemp, int maxOilTemp)
+{
+  recordedMaxOilPressure.reset();
+  recordedMaxOilPressure.update(maxOilPressure);
+  recordedMaxWaterTemp.reset();
+  recordedMaxWaterTemp.update(maxWaterTemp);
+  recordedMaxOilTempTop.reset();
+  recordedMaxOilTempTop.update(maxOilTemp);
 }
 
 // ────────────────────── メニュー画面描画 ──────────────────────
-void drawMenuScreen()
+// メニューで値が変わる欄
+enum class MenuField : uint8_t
 {
-  mainCanvas.fillScreen(COLOR_BLACK);
-  mainCanvas.setFont(&fonts::FreeSansBold12pt7b);
-  mainCanvas.setTextSize(1);
-  mainCanvas.setTextColor(COLOR_WHITE);
+  WaterTempMax,
+  OilTempMax,
+  OilPressureMax,
+  WarnDetail,  // 直近の低油圧イベント
+  WarnUnit,    // イベントの油圧の単位（イベントがあるときだけ）
+  WarnNone,    // イベントが無いとき
+  LuxLatest,
+  LuxMedian,
+  Count,
+};
+
+// 記録する命令の数。センサーの有無で変わるのは値の欄か Disabled かだけで、数は構成によらない。
+// 行を増やしたらここも増やす（ホストのテストで記録した数と照合する）
+// 内訳: 背景と枠 2、値の行 5 行 × 見出しと値（または Disabled）2、OIL.P WARN の見出しと 3 つの欄 4、案内 1
+constexpr size_t MENU_VALUE_LINES = 5;
+constexpr size_t MENU_LAYOUT_OPS = 2 + (2 * MENU_VALUE_LINES) + 4 + 1;
+// 枠・見出し・案内と値の欄の位置。最初にメニューを開いたときに一度だけ記録する
+static DisplayList<MENU_LAYOUT_OPS> menuLayout;
+static bool isMenuLayoutTruncated = false;  // 容量を超えて記録できなかった命令があるか
+
+static void recordMenuLayout()
+{
+  const lgfx::IFont *labelFont = &fonts::FreeSansBold12pt7b;
+  const lgfx::IFont *smallFont = &fonts::Font0;
+  auto fieldOf = [](MenuField field) { return static_cast<int>(field); };
 
   // フラットデザインの枠を描く
-  constexpr uint16_t BORDER_COLOR = rgb565(80, 80, 80);
+  constexpr uint16_t BORDER_COLOR = canvasColor(rgb565(80, 80, 80));
   // センサー無効時に表示する文字列
-  constexpr char DISABLED_STR[] = "Disabled";
-  mainCanvas.drawRect(0, 0, LCD_WIDTH, LCD_HEIGHT, BORDER_COLOR);
+  static constexpr char DISABLED_STR[] = "Disabled";
+  menuLayout.clear();
+  menuLayout.fillScreen(canvasColor(COLOR_BLACK));
+  menuLayout.drawRect(0, 0, LCD_WIDTH, LCD_HEIGHT, BORDER_COLOR);
 
   // 画面高さに合わせて行間を自動計算し、下にはみ出さないようにする
   constexpr int MENU_TOP_MARGIN = 20;     // 上端の余白
@@ -266,128 +682,180 @@ void drawMenuScreen()
   constexpr int MENU_LINES = 5;  // 表示行数
 #endif
   const int lineHeight = (LCD_HEIGHT - MENU_TOP_MARGIN - MENU_BOTTOM_MARGIN) / MENU_LINES;  // 行間
+  const int right = LCD_WIDTH - 10;                                                         // 値の右端位置
 
-  int y = MENU_TOP_MARGIN;
-  char valStr[8];  // 数値表示用バッファ
-
-  // 最高水温を表示
-  mainCanvas.setCursor(10, y);
-  mainCanvas.print("WATER.T MAX:");
-#if SENSOR_WATER_TEMP_PRESENT
-  // 小数点を表示しない
-  snprintf(valStr, sizeof(valStr), "%6.0f", recordedMaxWaterTemp);
-  mainCanvas.drawRightString(valStr, LCD_WIDTH - 10, y);
-#else
-  // センサー無効時は Disabled と表示
-  mainCanvas.drawRightString(DISABLED_STR, LCD_WIDTH - 10, y);
-#endif
+  // 見出しと値の欄（センサー無効時は Disabled を固定で表示）
+  auto addValueLine = [&](int y, const char *label, bool isPresent, MenuField field)
+  {
+    menuLayout.text(labelFont, 10, y, canvasColor(COLOR_WHITE), label);
+    if (isPresent)
+    {
+      menuLayout.field(labelFont, right, y, canvasColor(COLOR_WHITE), fieldOf(field));
+    }
+    else
+    {
+      menuLayout.rightText(mainCanvas, labelFont, right, y, canvasColor(COLOR_WHITE), DISABLED_STR);
+    }
+  };
 
+  int y = MENU_TOP_MARGIN;
+  addValueLine(y, "WATER.T MAX:", sensorChannelSpec(SensorChannelId::WaterTemp).present, MenuField::WaterTempMax);
   y += lineHeight;
-  // 最高油温を表示
-  mainCanvas.setCursor(10, y);
-  mainCanvas.print("OIL.T MAX:");
-#if SENSOR_OIL_TEMP_PRESENT
-  snprintf(valStr, sizeof(valStr), "%6d", recordedMaxOilTempTop);
-  mainCanvas.drawRightString(valStr, LCD_WIDTH - 10, y);
-#else
-  // センサー無効時は Disabled と表示
-  mainCanvas.drawRightString(DISABLED_STR, LCD_WIDTH - 10, y);
-#endif
-
+  addValueLine(y, "OIL.T MAX:", sensorChannelSpec(SensorChannelId::OilTemp).present, MenuField::OilTempMax);
   y += lineHeight;
-  // 最高油圧を表示
-  mainCanvas.setCursor(10, y);
-  mainCanvas.print("OIL.P MAX:");
-#if SENSOR_OIL_PRESSURE_PRESENT
-  snprintf(valStr, sizeof(valStr), "%6.1f", recordedMaxOilPressure);
-  mainCanvas.drawRightString(valStr, LCD_WIDTH - 10, y);
-#else
-  // センサー無効時は Disabled と表示
-  mainCanvas.drawRightString(DISABLED_STR, LCD_WIDTH - 10, y);
-#endif
+  addValueLine(y, "OIL.P MAX:", sensorChannelSpec(SensorChannelId::OilPressure).present, MenuField::OilPressureMax);
 
   y += lineHeight;
   // 直近の低油圧イベント情報を2行で表示
-  mainCanvas.setCursor(10, y);
-  mainCanvas.print("OIL.P WARN:");
+  menuLayout.text(labelFont, 10, y, canvasColor(COLOR_WHITE), "OIL.P WARN:");
   y += lineHeight;
-  if (lastLowEventDuration > 0.0F)
   {
-    // 方向, G値, 継続秒数, 油圧をカンマ区切りで作成（カンマ後にスペースを入れる）
-    char detailStr[40];
-    snprintf(detailStr, sizeof(detailStr), "%s, %.1fG, %.1fs, %.1f", lastLowEventDir, lastLowEventG, lastLowEventDuration,
-             lastLowEventPressure);
-
-    const int right = LCD_WIDTH - 10;  // 右端位置
-    // 詳細文字列の幅と高さを測定（通常フォント）
-    mainCanvas.setFont(&fonts::FreeSansBold12pt7b);
-    int textWidth = mainCanvas.textWidth(detailStr);
+    // 単位 "x100kPa" は小さいフォントで数値の下端に揃え、詳細文字列はその左へ右揃えにする
+    mainCanvas.setFont(labelFont);
     int textHeight = mainCanvas.fontHeight();
-
-    // 単位 "x100kPa" の幅と高さを小さいフォントで測定
-    mainCanvas.setFont(&fonts::Font0);
+    mainCanvas.setFont(smallFont);
     int unitWidth = mainCanvas.textWidth("x100kPa");
     int unitHeight = mainCanvas.fontHeight();
+    menuLayout.field(labelFont, right - unitWidth, y, canvasColor(COLOR_WHITE), fieldOf(MenuField::WarnDetail));
+    menuLayout.field(smallFont, right + 5, y + textHeight - unitHeight - 4, canvasColor(COLOR_WHITE),
+                     fieldOf(MenuField::WarnUnit));
+    menuLayout.field(labelFont, right, y, canvasColor(COLOR_WHITE), fieldOf(MenuField::WarnNone));
+  }
 
-    int startX = right - unitWidth - textWidth;
+  y += lineHeight;
+  // LUX センサーが無い場合は両方 Disabled を表示
+  addValueLine(y, "LUX LATEST:", SENSOR_AMBIENT_LIGHT_PRESENT, MenuField::LuxLatest);
+#if SENSOR_AMBIENT_LIGHT_PRESENT
+  y += lineHeight;
+#else
+  y += 25;
+#endif
+  addValueLine(y, "LUX MEDIAN:", SENSOR_AMBIENT_LIGHT_PRESENT, MenuField::LuxMedian);
 
-    // 詳細文字列を描画
-    mainCanvas.setFont(&fonts::FreeSansBold12pt7b);
-    mainCanvas.setCursor(startX, y);
-    mainCanvas.print(detailStr);
+  // 戻る案内を左下へ配置
+#if OIL_STARVATION_MAP_ENABLED
+  menuLayout.text(smallFont, 10, LCD_HEIGHT - 20, canvasColor(COLOR_WHITE), "Tap for oil map");
+#else
+  menuLayout.text(smallFont, 10, LCD_HEIGHT - 20, canvasColor(COLOR_WHITE), "Tap screen to return");
+#endif
+  isMenuLayoutTruncated = !menuLayout.seal();
+  if (isMenuLayoutTruncated)
+  {
+    Serial.printf("[Display] menu layout exceeds %u ops, increase MENU_LAYOUT_OPS\n",
+                  static_cast<unsigned>(MENU_LAYOUT_OPS));
+  }
+}
 
-    // 単位部分を小さいフォントで描画（数値の下端に揃える）
-    mainCanvas.setFont(&fonts::Font0);
-    mainCanvas.setCursor(startX + textWidth + 5, y + textHeight - unitHeight - 4);
-    mainCanvas.print("x100kPa");
-    // フォントを元に戻す
-    mainCanvas.setFont(&fonts::FreeSansBold12pt7b);
+void drawMenuScreen()
+{
+  if (mainCanvas.getBuffer() == nullptr)
+  {
+    return;
   }
-  else
+  if (!menuLayout.isRecorded())
   {
-    mainCanvas.drawRightString("None", LCD_WIDTH - 10, y);
+    recordMenuLayout();
   }
 
-  y += lineHeight;
-  mainCanvas.setCursor(10, y);
+  // 値の欄の文字列だけを作る
+  char waterStr[8];
+  char oilTempStr[8];
+  char pressureStr[8];
+  char detailStr[40];
+  const char *fieldTexts[static_cast<int>(MenuField::Count)] = {};
+  auto setField = [&](MenuField field, const char *text) { fieldTexts[static_cast<int>(field)] = text; };
+
+  // 水温は小数点を表示しない
+  snprintf(waterStr, sizeof(waterStr), "%6.0f", recordedMaxWaterTemp.value());
+  snprintf(oilTempStr, sizeof(oilTempStr), "%6d", recordedMaxOilTempTop.value());
+  snprintf(pressureStr, sizeof(pressureStr), "%6.1f", recordedMaxOilPressure.value());
+  setField(MenuField::WaterTempMax, waterStr);
+  setField(MenuField::OilTempMax, oilTempStr);
+  setField(MenuField::OilPressureMax, pressureStr);
+  if (lastLowEventDuration > 0.0F)
+  {
+    // 方向, G値, 継続秒数, 油圧をカンマ区切りで作成（カンマ後にスペースを入れる）
+    snprintf(detailStr, sizeof(detailStr), "%s, %.1fG, %.1fs, %.1f", lastLowEventDir, lastLowEventG, lastLowEventDuration,
+             lastLowEventPressure);
+    setField(MenuField::WarnDetail, detailStr);
+    setField(MenuField::WarnUnit, "x100kPa");
+  }
+  else
+  {
+    setField(MenuField::WarnNone, "None");
+  }
 #if SENSOR_AMBIENT_LIGHT_PRESENT
-  // 現在のLUX値を表示
-  mainCanvas.print("LUX LATEST:");
-  snprintf(valStr, sizeof(valStr), "%6d", latestLux);
-  mainCanvas.drawRightString(valStr, LCD_WIDTH - 10, y);
+  char luxStr[8];
+  char medianStr[8];
+  snprintf(luxStr, sizeof(luxStr), "%6d", latestLux);
+  snprintf(medianStr, sizeof(medianStr), "%6d", medianLuxValue);
+  setField(MenuField::LuxLatest, luxStr);
+  setField(MenuField::LuxMedian, medianStr);
+#endif
 
-  y += lineHeight;
-  mainCanvas.setCursor(10, y);
-  // 照度の中央値を表示
-  mainCanvas.print("LUX MEDIAN:");
-  char medStr[8];
-  snprintf(medStr, sizeof(medStr), "%6d", medianLuxValue);
-  mainCanvas.drawRightString(medStr, LCD_WIDTH - 10, y);
-#else
-  // LUX センサーが無い場合は両方 Disabled を表示
-  mainCanvas.print("LUX LATEST:");
-  mainCanvas.drawRightString(DISABLED_STR, LCD_WIDTH - 10, y);
+  menuLayout.replay(mainCanvas, fieldTexts);
+  if (isMenuLayoutTruncated)
+  {
+    // 欠けた行に気づけるよう、リリースビルドでも画面に出す
+    mainCanvas.setFont(&fonts::Font0);
+    mainCanvas.setTextColor(canvasColor(COLOR_RED));
+    mainCanvas.setCursor(10, LCD_HEIGHT - 10);
+    mainCanvas.print("MENU LAYOUT TRUNCATED");
+  }
 
-  y += 25;
-  mainCanvas.setCursor(10, y);
-  mainCanvas.print("LUX MEDIAN:");
-  mainCanvas.drawRightString(DISABLED_STR, LCD_WIDTH - 10, y);
-#endif
+  pushMainCanvas();
+}
 
-  // 戻る案内を左下へ配置
-  mainCanvas.setCursor(10, LCD_HEIGHT - 20);
+// ────────────────────── 油圧マップ画面描画 ──────────────────────
+void drawOilMapScreen()
+{
+  constexpr int FOOTER_HEIGHT = 12;
+  if (mainCanvas.getBuffer() == nullptr)
+  {
+    return;
+  }
+  mainCanvas.fillScreen(canvasColor(COLOR_BLACK));
+#if OIL_STARVATION_MAP_ENABLED
+  drawStarvationMap(mainCanvas, starvationMap, 0, 0, LCD_WIDTH, LCD_HEIGHT - FOOTER_HEIGHT);
+#endif
   mainCanvas.setFont(&fonts::Font0);
+  mainCanvas.setTextColor(canvasColor(COLOR_WHITE));
+  mainCanvas.setCursor(10, LCD_HEIGHT - FOOTER_HEIGHT + 2);
   mainCanvas.printf("Tap screen to return");
 
-  mainCanvas.pushSprite(0, 0);
+  pushMainCanvas();
+}
+
+// ────────────────────── 処理時間画面描画 ──────────────────────
+void drawProfileScreen()
+{
+  if (mainCanvas.getBuffer() == nullptr)
+  {
+    return;
+  }
+  mainCanvas.fillScreen(canvasColor(COLOR_BLACK));
+#if FRAME_PROFILER_ENABLED && defined(ARDUINO)
+  // 区間ごとの p50/p99/max [us] と締め切り超過回数
+  mainCanvas.setFont(&fonts::Font0);
+  mainCanvas.setTextColor(canvasColor(COLOR_WHITE));
+  mainCanvas.setCursor(10, 10);
+  mainCanvas.print("FRAME PROFILE p50/p99/max [us]");
+  drawFrameProfileSummary(30);
+#endif
+  pushMainCanvas();
 }
 
 // ────────────────────── ゲージ状態リセット ──────────────────────
 void resetGaugeState()
 {
-  // メニュー画面の残像を防ぐため一度画面をクリアする
-  mainCanvas.fillScreen(COLOR_BLACK);
-  mainCanvas.pushSprite(0, 0);
+  // メニュー画面の残像を防ぐため一度パネルを直接クリアする（ウィジェットの無い余白もここで黒になる）
+  waitDisplayTransfer();
+  display.fillScreen(COLOR_BLACK);
+  totalPushedBytes += static_cast<uint32_t>(LCD_WIDTH) * LCD_HEIGHT * sizeof(uint16_t);
+  // 各ウィジェットは次のフレームで描き直す（ゲージは背景レイヤーからの 1 回の複写で静的な部分が戻る）
+  topBarState = {};
+  resetFpsOverlay();
+  resetRacingIndicator();
 
   pressureGaugeInitialized = false;
   waterGaugeInitialized = false;
@@ -7,13 +7,32 @@
 #include "sensor.h"
 
 extern M5GFX display;
+// メニュー・油圧マップ画面の描画先。ゲージ画面は部品ごとのスプライトへ描く。
+// バッファは initDisplayBuffers() が PSRAM に一度だけ確保する
 extern M5Canvas mainCanvas;
 extern int currentFps;
+// 直近フレームと起動以降に転送したバイト数
+extern uint32_t lastFramePushedBytes;
+extern uint32_t totalPushedBytes;
 
+// ゲージ画面の部品ごとのスプライト・メニュー用の mainCanvas・転送用の第2バッファ・数字グリフを用意し、
+// パレット形式ならパレットを設定する（mainCanvas の画素形式を設定した後に呼ぶ）
+void initDisplayBuffers();
+// 第2バッファを使い DMA 転送と描画を重ねているか
+auto isDisplayTransferOverlapped() -> bool;
+// 転送中のフレームがあれば完了を待つ（他のデバイスで SPI バスを使う前に呼ぶ）
+void waitDisplayTransfer();
 void drawOilTemperatureTopBar(M5Canvas& canvas, float oilTemp, int maxOilTemp);
 void renderDisplayAndLog(float pressureAvg, float waterTempAvg, float oilTemp, int16_t maxOilTemp);
 void updateGauges();
 void drawMenuScreen();
+// メニューの次のページ（G と油圧の分布のヒートマップ）
+void drawOilMapScreen();
+// メニューのページ（区間ごとの p50/p99/max と締め切り超過回数）。FRAME_PROFILER_ENABLED のときだけ使う
+void drawProfileScreen();
 void resetGaugeState();
+// 起動またはセンサー異常からの最大値（油圧 [bar]・水温 [℃]・油温 [℃]）。永続ストアへの保存と復元に使う
+void recordedMaxValues(float& maxOilPressure, float& maxWaterTemp, int& maxOilTemp);
+void restoreRecordedMaxValues(float maxOilPressure, float maxWaterTemp, int maxOilTemp);
 
 #endif  // DISPLAY_H
@@ -0,0 +1,196 @@
+#ifndef DISPLAY_LIST_H
+#define DISPLAY_LIST_H
+
+#include <M5GFX.h>
+
+#include <cstddef>
+#include <cstdint>
+
+// ────────────────────── 表示リスト ──────────────────────
+// 静的な画面を一度だけ記録し、以降は記録済みの命令を順に再生する。
+// 固定文字列は記録時に幅を測って左上座標へ解決し、文字の命令はフォントごとにまとめて並べ替えるため、
+// 再生時のフォント切り替えはフォントの種類数だけになる。値が変わる欄だけは再生時に文字列を受け取り、
+// 右揃えの位置をその場で求める。命令は固定長の配列に持ち、文字列は呼び出し側の静的な文字列を指すだけなので、
+// 記録・再生のどちらでもメモリを確保しない。容量 N を超えた命令は記録できず、記録と seal() が false を返す。
+// 再生は前回の再生との差分を取らず、毎回すべての命令を描く（描き先のキャンバスは画面を開くたびに確保し直すため）
+
+struct DisplayOp
+{
+  enum class Kind : uint8_t
+  {
+    FillScreen,
+    Rect,
+    Text,   // 固定文字列（x, y は左上）
+    Field,  // 値が変わる欄（x は右端、y は上端）
+  };
+
+  Kind kind;
+  uint8_t slot;  // Field の欄番号
+  uint16_t color;
+  int16_t x;
+  int16_t y;
+  int16_t w;
+  int16_t h;
+  const lgfx::IFont *font;
+  const char *text;
+};
+
+template <size_t N>
+class DisplayList
+{
+ public:
+  void clear()
+  {
+    opCount = 0;
+    sealed = false;
+    isOverflowed = false;
+  }
+  // seal() 済みで再生できるか
+  auto isRecorded() const -> bool { return sealed; }
+  auto size() const -> size_t { return opCount; }
+  auto op(size_t index) const -> const DisplayOp & { return ops[index]; }
+
+  // ── 記録 ──
+  // いずれも容量を超えて記録できなければ false
+  auto fillScreen(uint16_t color) -> bool
+  {
+    return add({DisplayOp::Kind::FillScreen, 0, color, 0, 0, 0, 0, nullptr, nullptr});
+  }
+
+  auto drawRect(int x, int y, int w, int h, uint16_t color) -> bool
+  {
+    return add({DisplayOp::Kind::Rect, 0, color, static_cast<int16_t>(x), static_cast<int16_t>(y), static_cast<int16_t>(w),
+         static_cast<int16_t>(h), nullptr, nullptr});
+  }
+
+  // text は再生時まで参照するため、文字列リテラルなど寿命の長いものを渡す
+  auto text(const lgfx::IFont *font, int x, int y, uint16_t color, const char *text) -> bool
+  {
+    return add({DisplayOp::Kind::Text, 0, color, static_cast<int16_t>(x), static_cast<int16_t>(y), 0, 0, font, text});
+  }
+
+  // 右端を right に揃えた固定文字列。幅は measure のキャンバスで記録時に測る
+  auto rightText(M5Canvas &measure, const lgfx::IFont *font, int right, int y, uint16_t color, const char *text)
+      -> bool
+  {
+    measure.setFont(font);
+    return this->text(font, right - measure.textWidth(text), y, color, text);
+  }
+
+  // 再生時に fieldTexts[slot] を右端 right に揃えて描く欄
+  auto field(const lgfx::IFont *font, int right, int y, uint16_t color, int slot) -> bool
+  {
+    return add({DisplayOp::Kind::Field, static_cast<uint8_t>(slot), color, static_cast<int16_t>(right),
+                static_cast<int16_t>(y), 0, 0, font, nullptr});
+  }
+
+  // 記録を終える。図形を先に、文字は最初に現れた順のフォントごとにまとめる（同じフォント内の順序は保つ）。
+  // 文字同士は重ならないことを前提とする。記録できなかった命令があれば false（記録できた分は再生できる）
+  auto seal() -> bool
+  {
+    // 並べ替える前の順序でキーを決めてから挿入ソートする
+    int keys[N];
+    for (size_t i = 0; i < opCount; ++i)
+    {
+      keys[i] = sortKey(ops[i]);
+    }
+    for (size_t i = 1; i < opCount; ++i)
+    {
+      DisplayOp moving = ops[i];
+      int key = keys[i];
+      size_t j = i;
+      while (j > 0 && keys[j - 1] > key)
+      {
+        ops[j] = ops[j - 1];
+        keys[j] = keys[j - 1];
+        --j;
+      }
+      ops[j] = moving;
+      keys[j] = key;
+    }
+    sealed = true;
+    return !isOverflowed;
+  }
+
+  // ── 再生 ──
+  // 記録した命令をすべて描く。fieldTexts は欄番号ごとの文字列。nullptr または空文字の欄は描かない
+  void replay(M5Canvas &canvas, const char *const *fieldTexts) const
+  {
+    const lgfx::IFont *currentFont = nullptr;
+    uint16_t currentColor = 0;
+    bool hasColor = false;
+    canvas.setTextSize(1);
+    for (size_t i = 0; i < opCount; ++i)
+    {
+      const DisplayOp &o = ops[i];
+      if (o.kind == DisplayOp::Kind::FillScreen)
+      {
+        canvas.fillScreen(o.color);
+        continue;
+      }
+      if (o.kind == DisplayOp::Kind::Rect)
+      {
+        canvas.drawRect(o.x, o.y, o.w, o.h, o.color);
+        continue;
+      }
+
+      const char *s = (o.kind == DisplayOp::Kind::Text) ? o.text : fieldTexts[o.slot];
+      if (s == nullptr || *s == '\0')
+      {
+        continue;
+      }
+      if (o.font != currentFont)
+      {
+        canvas.setFont(o.font);
+        currentFont = o.font;
+      }
+      if (!hasColor || o.color != currentColor)
+      {
+        canvas.setTextColor(o.color);
+        currentColor = o.color;
+        hasColor = true;
+      }
+      int x = (o.kind == DisplayOp::Kind::Text) ? o.x : o.x - canvas.textWidth(s);
+      canvas.setCursor(x, o.y);
+      canvas.print(s);
+    }
+  }
+
+ private:
+  auto add(const DisplayOp &o) -> bool
+  {
+    sealed = false;
+    // N は記録する画面に合わせて静的に決める。超えた分は記録せず、seal() まで失敗を覚えておく
+    if (opCount == N)
+    {
+      isOverflowed = true;
+      return false;
+    }
+    ops[opCount++] = o;
+    return true;
+  }
+
+  // 図形は 0、文字はそのフォントが最初に現れた位置 + 1
+  auto sortKey(const DisplayOp &o) const -> int
+  {
+    if (o.kind == DisplayOp::Kind::FillScreen || o.kind == DisplayOp::Kind::Rect)
+    {
+      return 0;
+    }
+    for (size_t i = 0; i < opCount; ++i)
+    {
+      if (ops[i].font == o.font && ops[i].font != nullptr)
+      {
+        return static_cast<int>(i) + 1;
+      }
+    }
+    return static_cast<int>(opCount) + 1;
+  }
+
+  DisplayOp ops[N] = {};
+  size_t opCount = 0;
+  bool sealed = false;
+  bool isOverflowed = false;  // 容量を超えて記録できなかった命令があるか
+};
+
+#endif  // DISPLAY_LIST_H
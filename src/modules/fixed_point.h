@@ -0,0 +1,146 @@
+#ifndef FIXED_POINT_H
+#define FIXED_POINT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+// ────────────────────── 固定小数点型 ──────────────────────
+// 小数部 FracBits ビットの Q 形式。ビット数はコンパイル時に決め、量ごとに範囲と分解能を選ぶ。
+// 乗算は 64bit の中間値で計算して最近接へ丸める。加減算は飽和しないため、範囲は型の選択で保証する。
+// ESP32-S3 は単精度 FPU を持ち、浮動小数点との相互変換の分だけ遅くなりうるため、速さではなく
+// 累積誤差が残らないこと（移動平均の合計など）が効く箇所に限って使う
+template <int FracBits, typename Storage = int32_t>
+class Fixed
+{
+  static_assert(std::is_signed<Storage>::value && sizeof(Storage) <= sizeof(int32_t), "符号付き 32bit 以下の整数で保持する");
+  static_assert(FracBits > 0 && FracBits < static_cast<int>(sizeof(Storage) * 8) - 1, "整数部に 1 ビット以上残す");
+
+ public:
+  using StorageType = Storage;
+  static constexpr int FRACTION_BITS = FracBits;
+  static constexpr Storage ONE = static_cast<Storage>(Storage(1) << FracBits);
+
+  constexpr Fixed() = default;
+
+  static constexpr auto fromRaw(Storage raw) -> Fixed
+  {
+    Fixed q;
+    q.value = raw;
+    return q;
+  }
+  // 最近接へ丸め、範囲外は上下限に飽和させる
+  static constexpr auto fromFloat(float v) -> Fixed
+  {
+    float scaled = v * static_cast<float>(ONE);
+    if (scaled >= static_cast<float>(std::numeric_limits<Storage>::max()))
+    {
+      return fromRaw(std::numeric_limits<Storage>::max());
+    }
+    if (scaled <= static_cast<float>(std::numeric_limits<Storage>::min()))
+    {
+      return fromRaw(std::numeric_limits<Storage>::min());
+    }
+    return fromRaw(static_cast<Storage>(scaled + ((scaled >= 0.0F) ? 0.5F : -0.5F)));
+  }
+  static constexpr auto fromInt(int v) -> Fixed { return fromRaw(static_cast<Storage>(v * ONE)); }
+  // 1LSB の大きさ
+  static constexpr auto epsilon() -> float { return 1.0F / static_cast<float>(ONE); }
+
+  constexpr auto raw() const -> Storage { return value; }
+  constexpr auto toFloat() const -> float { return static_cast<float>(value) / static_cast<float>(ONE); }
+  // 0 方向へ切り捨てた整数部（static_cast<int>(float) と同じ）
+  constexpr auto toInt() const -> int { return static_cast<int>(value / ONE); }
+
+  constexpr auto operator+(Fixed rhs) const -> Fixed { return fromRaw(static_cast<Storage>(value + rhs.value)); }
+  constexpr auto operator-(Fixed rhs) const -> Fixed { return fromRaw(static_cast<Storage>(value - rhs.value)); }
+  constexpr auto operator*(Fixed rhs) const -> Fixed
+  {
+    int64_t product = static_cast<int64_t>(value) * rhs.value;
+    return fromRaw(static_cast<Storage>((product + (int64_t(1) << (FracBits - 1))) >> FracBits));
+  }
+  auto operator+=(Fixed rhs) -> Fixed & { return *this = *this + rhs; }
+  auto operator-=(Fixed rhs) -> Fixed & { return *this = *this - rhs; }
+
+  constexpr auto operator==(Fixed rhs) const -> bool { return value == rhs.value; }
+  constexpr auto operator!=(Fixed rhs) const -> bool { return value != rhs.value; }
+  constexpr auto operator<(Fixed rhs) const -> bool { return value < rhs.value; }
+  constexpr auto operator<=(Fixed rhs) const -> bool { return value <= rhs.value; }
+  constexpr auto operator>(Fixed rhs) const -> bool { return value > rhs.value; }
+  constexpr auto operator>=(Fixed rhs) const -> bool { return value >= rhs.value; }
+
+ private:
+  Storage value = 0;
+};
+
+// ────────────────────── 平滑化・平均・ベクトル長 ──────────────────────
+// 指数移動平均。最初の入力で初期化する
+template <typename Q>
+class FixedEma
+{
+ public:
+  constexpr explicit FixedEma(Q alpha) : alpha(alpha) {}
+
+  auto update(Q input) -> Q
+  {
+    if (!initialized)
+    {
+      current = input;
+      initialized = true;
+    }
+    else
+    {
+      current += alpha * (input - current);
+    }
+    return current;
+  }
+  void reset() { initialized = false; }
+  auto value() const -> Q { return current; }
+
+ private:
+  Q alpha;
+  Q current;
+  bool initialized = false;
+};
+
+// 直近 N サンプルの移動平均。合計を整数で持つため、更新は O(1) で誤差も累積しない
+template <typename Q, size_t N>
+class FixedMovingAverage
+{
+  static_assert(N > 0, "サンプル数は 1 以上");
+
+ public:
+  void push(Q sample)
+  {
+    sum += static_cast<int64_t>(sample.raw()) - samples[index].raw();
+    samples[index] = sample;
+    index = (index + 1) % N;
+  }
+  // 全サンプルを同じ値で埋め、次の push は先頭から上書きする
+  void fill(Q sample)
+  {
+    for (Q &s : samples)
+    {
+      s = sample;
+    }
+    sum = static_cast<int64_t>(sample.raw()) * static_cast<int64_t>(N);
+    index = 0;
+  }
+  // 最近接へ丸めた平均
+  auto average() const -> Q
+  {
+    int64_t half = static_cast<int64_t>(N / 2);
+    int64_t rounded = (sum >= 0) ? (sum + half) / static_cast<int64_t>(N) : (sum - half) / static_cast<int64_t>(N);
+    return Q::fromRaw(static_cast<typename Q::StorageType>(rounded));
+  }
+  auto operator[](size_t i) const -> Q { return samples[i]; }
+  static constexpr auto size() -> size_t { return N; }
+
+ private:
+  Q samples[N] = {};
+  int64_t sum = 0;
+  size_t index = 0;
+};
+
+#endif  // FIXED_POINT_H
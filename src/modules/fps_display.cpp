@@ -2,49 +2,41 @@
 
 #include <M5CoreS3.h>
 
+#include "canvas_palette.h"
 #include "config.h"
+#include "dirty_region.h"
 #include "display.h"
 
-// FPSラベルが描画済みかどうかを保持
-static bool fpsLabelDrawn = false;
 static unsigned long lastFpsDrawTime = 0;
+// 次の呼び出しで時刻によらず描くか
+static bool isFpsRedrawPending = true;
 
 // ────────────────────── FPS表示 ──────────────────────
-auto drawFpsOverlay() -> bool
+auto drawFpsOverlay(M5Canvas &canvas) -> bool
 {
 #if !FPS_DISPLAY_ENABLED
   // FPS表示が無効な場合は何もしない
   return false;
 #endif
 
-  mainCanvas.setFont(&fonts::Font0);
-  mainCanvas.setTextSize(0);
-  // FPS表示を目立たせないよう文字色をグレーに設定
-  mainCanvas.setTextColor(COLOR_GRAY);
-
-  // ラベルがメーターに重ならないよう画面最下部へ配置
-  constexpr int FPS_Y = LCD_HEIGHT - 16;  // 下端に合わせる
   unsigned long now = millis();
-  if (!fpsLabelDrawn)
+  if (!isFpsRedrawPending && now - lastFpsDrawTime < 1000UL)
   {
-    // 数値表示用に領域を初期化
-    mainCanvas.fillRect(0, FPS_Y, 16, 16, COLOR_BLACK);
-    fpsLabelDrawn = true;
-    lastFpsDrawTime = 0;  // 初回はすぐ更新するため0に設定
+    return false;
   }
 
-  if (now - lastFpsDrawTime >= 1000UL)
-  {
-    // 数値表示部のみ塗り直して更新
-    mainCanvas.fillRect(0, FPS_Y + 8, 30, 8, COLOR_BLACK);
-    mainCanvas.setCursor(0, FPS_Y + 8);
-    mainCanvas.printf("%d", currentFps);
-    lastFpsDrawTime = now;
-    // 元の色に戻しておく
-    mainCanvas.setTextColor(COLOR_WHITE);
-    return true;
-  }
-  // 更新が無い場合も色を戻す
-  mainCanvas.setTextColor(COLOR_WHITE);
-  return false;
+  canvas.setFont(&fonts::Font0);
+  canvas.setTextSize(0);
+  // FPS表示を目立たせないよう文字色をグレーに設定
+  canvas.setTextColor(canvasColor(COLOR_GRAY));
+  // スプライト全体を塗り直して数値を描く
+  canvas.fillScreen(canvasColor(COLOR_BLACK));
+  frameDirtyRegions.markRect(0, 0, canvas.width(), canvas.height());
+  canvas.setCursor(0, 0);
+  canvas.printf("%d", currentFps);
+  lastFpsDrawTime = now;
+  isFpsRedrawPending = false;
+  return true;
 }
+
+void resetFpsOverlay() { isFpsRedrawPending = true; }
@@ -1,7 +1,11 @@
 #ifndef FPS_DISPLAY_H
 #define FPS_DISPLAY_H
 
-// FPS表示を更新したかどうかを返す
-auto drawFpsOverlay() -> bool;
+#include <M5GFX.h>
+
+// FPS 表示用の小さなスプライトへ数値を描く。FPS表示を更新したかどうかを返す
+auto drawFpsOverlay(M5Canvas &canvas) -> bool;
+// 画面を消した後、次の呼び出しですぐに描き直す
+void resetFpsOverlay();
 
 #endif  // FPS_DISPLAY_H
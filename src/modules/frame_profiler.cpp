@@ -0,0 +1,185 @@
+#include "frame_profiler.h"
+
+#include <cstdio>
+
+#if defined(ARDUINO)
+#include <Arduino.h>
+
+#include "canvas_palette.h"
+#include "display.h"
+#endif
+
+static constexpr const char *STAGE_LABELS[] = {"IN", "SNS", "GAU", "PUSH", "FRM"};
+static_assert(sizeof(STAGE_LABELS) / sizeof(STAGE_LABELS[0]) == static_cast<size_t>(ProfileStage::Count),
+              "区間ごとにラベルを用意する");
+
+// ────────────────────── LatencyHistogram ──────────────────────
+auto LatencyHistogram::bucketOf(uint32_t us) -> int
+{
+  // 0〜3us はそのまま、それ以上は最上位ビットと次の 2 ビットで分類する
+  if (us < 4)
+  {
+    return static_cast<int>(us);
+  }
+  int msb = 31 - __builtin_clz(us);
+  int sub = static_cast<int>((us >> (msb - 2)) & 3U);
+  int bucket = (4 * (msb - 1)) + sub;
+  return (bucket < BUCKET_COUNT) ? bucket : BUCKET_COUNT - 1;
+}
+
+auto LatencyHistogram::bucketUpperBound(int bucket) -> uint32_t
+{
+  if (bucket < 4)
+  {
+    return static_cast<uint32_t>(bucket);
+  }
+  int msb = (bucket / 4) + 1;
+  uint32_t lower = static_cast<uint32_t>(4 + (bucket % 4)) << (msb - 2);
+  return lower + (1U << (msb - 2)) - 1;
+}
+
+void LatencyHistogram::record(uint32_t us)
+{
+  // 読み出し側から要求されたリセットは、記録する側のコアで行う
+  if (isResetRequested.exchange(false, std::memory_order_acquire))
+  {
+    for (std::atomic<uint32_t> &b : buckets)
+    {
+      b.store(0, std::memory_order_relaxed);
+    }
+    maxUs.store(0, std::memory_order_relaxed);
+  }
+  std::atomic<uint32_t> &bucket = buckets[bucketOf(us)];
+  bucket.store(bucket.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+  if (us > maxUs.load(std::memory_order_relaxed))
+  {
+    maxUs.store(us, std::memory_order_relaxed);
+  }
+}
+
+auto LatencyHistogram::snapshot(uint32_t (&out)[BUCKET_COUNT]) const -> uint32_t
+{
+  bool isCleared = isResetRequested.load(std::memory_order_acquire);
+  uint32_t total = 0;
+  for (int i = 0; i < BUCKET_COUNT; ++i)
+  {
+    out[i] = isCleared ? 0 : buckets[i].load(std::memory_order_relaxed);
+    total += out[i];
+  }
+  return total;
+}
+
+auto LatencyHistogram::max() const -> uint32_t
+{
+  return isResetRequested.load(std::memory_order_acquire) ? 0 : maxUs.load(std::memory_order_relaxed);
+}
+
+auto LatencyHistogram::count() const -> uint32_t
+{
+  uint32_t counts[BUCKET_COUNT];
+  return snapshot(counts);
+}
+
+auto LatencyHistogram::percentile(uint32_t percent) const -> uint32_t
+{
+  // 記録中のコアと並行して読むため、件数もバケットの写しから数えて辻褄を合わせる
+  uint32_t counts[BUCKET_COUNT];
+  uint32_t sampleCount = snapshot(counts);
+  uint32_t maxValue = max();
+  if (sampleCount == 0)
+  {
+    return 0;
+  }
+  // 切り上げで順位を求め、そのサンプルを含むバケットを探す
+  uint64_t rank = ((static_cast<uint64_t>(sampleCount) * percent) + 99) / 100;
+  if (rank == 0)
+  {
+    rank = 1;
+  }
+  uint64_t seen = 0;
+  for (int i = 0; i < BUCKET_COUNT; ++i)
+  {
+    seen += counts[i];
+    if (seen >= rank)
+    {
+      uint32_t upper = bucketUpperBound(i);
+      return (upper < maxValue) ? upper : maxValue;
+    }
+  }
+  return maxValue;
+}
+
+// ────────────────────── FrameProfiler ──────────────────────
+void FrameProfiler::recordSince(ProfileStage stage, uint32_t startCycles)
+{
+  // 符号なし減算なのでサイクルカウンタの一周にも対応する
+  uint32_t elapsedUs = (readCycles() - startCycles) / cyclesPerUs;
+  histograms[static_cast<int>(stage)].record(elapsedUs);
+}
+
+void FrameProfiler::endFrame()
+{
+  uint32_t frameUs = (readCycles() - frameStartCycles) / cyclesPerUs;
+  histograms[static_cast<int>(ProfileStage::Frame)].record(frameUs);
+  if (frameUs > FRAME_INTERVAL_US)
+  {
+    missCount++;
+  }
+}
+
+void FrameProfiler::reset()
+{
+  for (LatencyHistogram &h : histograms)
+  {
+    h.reset();
+  }
+  missCount = 0;
+}
+
+void FrameProfiler::formatStage(ProfileStage stage, char *buffer, size_t size) const
+{
+  const LatencyHistogram &h = histogram(stage);
+  snprintf(buffer, size, "%s %lu/%lu/%lu", STAGE_LABELS[static_cast<int>(stage)],
+           static_cast<unsigned long>(h.percentile(50)), static_cast<unsigned long>(h.percentile(99)),
+           static_cast<unsigned long>(h.max()));
+}
+
+// ────────────────────── 実機での出力 ──────────────────────
+#if defined(ARDUINO) && FRAME_PROFILER_ENABLED
+static auto readCpuCycles() -> uint32_t { return ESP.getCycleCount(); }
+
+FrameProfiler frameProfiler(readCpuCycles, F_CPU / 1000000UL);
+
+// メニュー画面下部に p50/p99/max [us] を 2 区間ずつ表示する
+void drawFrameProfileSummary(int y)
+{
+  constexpr int LINE_HEIGHT = 10;
+  constexpr int COLUMN_X = 160;
+  mainCanvas.setFont(&fonts::Font0);
+  mainCanvas.setTextColor(canvasColor(COLOR_GRAY));
+
+  char text[32];
+  for (int i = 0; i < static_cast<int>(ProfileStage::Count); ++i)
+  {
+    frameProfiler.formatStage(static_cast<ProfileStage>(i), text, sizeof(text));
+    mainCanvas.setCursor(10 + ((i % 2) * COLUMN_X), y + ((i / 2) * LINE_HEIGHT));
+    mainCanvas.print(text);
+  }
+  mainCanvas.setCursor(10 + COLUMN_X, y + (2 * LINE_HEIGHT));
+  mainCanvas.printf("MISS %lu", static_cast<unsigned long>(frameProfiler.deadlineMisses()));
+  mainCanvas.setTextColor(canvasColor(COLOR_WHITE));
+}
+
+void printFrameProfile()
+{
+  char text[32];
+  Serial.println("[Profile] stage p50/p99/max [us]");
+  for (int i = 0; i < static_cast<int>(ProfileStage::Count); ++i)
+  {
+    frameProfiler.formatStage(static_cast<ProfileStage>(i), text, sizeof(text));
+    Serial.printf("  %s (n=%lu)\n", text,
+                  static_cast<unsigned long>(frameProfiler.histogram(static_cast<ProfileStage>(i)).count()));
+  }
+  Serial.printf("  deadline misses: %lu\n", static_cast<unsigned long>(frameProfiler.deadlineMisses()));
+}
+#endif
@@ -0,0 +1,124 @@
+#ifndef FRAME_PROFILER_H
+#define FRAME_PROFILER_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include "config.h"
+
+// ────────────────────── 計測区間 ──────────────────────
+enum class ProfileStage : uint8_t
+{
+  Input,   // M5.update・タッチ・ALS・サンプル反映
+  Sensor,  // acquireSensorData（取得タスク側で計測）
+  Gauge,   // updateGauges（Push を含む）
+  Push,    // 更新領域の転送
+  Frame,   // フレーム全体（待機を除く）
+  Count,
+};
+
+// ────────────────────── 固定メモリのレイテンシ分布 ──────────────────────
+// 2 のべき乗ごとに 4 分割した対数バケットで記録する（相対誤差 25% 以内）。
+// 記録は 1 つのコア（Sensor 区間は取得タスク、それ以外は描画ループ）からだけ行い、読み出しとリセットは
+// 別のコアからでもよい。リセットは要求だけを残し、記録する側が次の record() で消すので書き込みは競合しない
+class LatencyHistogram
+{
+ public:
+  static constexpr int BUCKET_COUNT = 80;  // 約 1 秒まで
+
+  void record(uint32_t us);
+  void reset() { isResetRequested.store(true, std::memory_order_release); }
+  // 指定パーセンタイル [0-100] が含まれるバケットの上限 [us]
+  auto percentile(uint32_t percent) const -> uint32_t;
+  auto max() const -> uint32_t;
+  auto count() const -> uint32_t;
+
+  static auto bucketOf(uint32_t us) -> int;
+  static auto bucketUpperBound(int bucket) -> uint32_t;
+
+ private:
+  // バケットを読み出した時点の値で写す（リセット待ちなら空）。戻り値はサンプル数
+  auto snapshot(uint32_t (&out)[BUCKET_COUNT]) const -> uint32_t;
+
+  std::atomic<uint32_t> buckets[BUCKET_COUNT] = {};
+  std::atomic<uint32_t> maxUs{0};
+  std::atomic<bool> isResetRequested{false};
+};
+
+// ────────────────────── フレームプロファイラ ──────────────────────
+class FrameProfiler
+{
+ public:
+  using CycleFn = uint32_t (*)();
+
+  FrameProfiler(CycleFn cycleFn, uint32_t cyclesPerUs) : readCycles(cycleFn), cyclesPerUs(cyclesPerUs) {}
+
+  auto cycles() const -> uint32_t { return readCycles(); }
+  // 開始時のサイクル値から経過時間を記録する
+  void recordSince(ProfileStage stage, uint32_t startCycles);
+
+  void beginFrame() { frameStartCycles = readCycles(); }
+  // フレーム全体の時間を記録し、FRAME_INTERVAL_US を超えたら締め切り超過として数える
+  void endFrame();
+
+  void reset();
+  auto histogram(ProfileStage stage) const -> const LatencyHistogram &
+  {
+    return histograms[static_cast<int>(stage)];
+  }
+  auto deadlineMisses() const -> uint32_t { return missCount; }
+
+  // 区間の要約を "GAU 1200/3400/5100" (p50/p99/max [us]) 形式で書き出す
+  void formatStage(ProfileStage stage, char *buffer, size_t size) const;
+
+ private:
+  CycleFn readCycles;
+  uint32_t cyclesPerUs;
+  uint32_t frameStartCycles = 0;
+  uint32_t missCount = 0;
+  LatencyHistogram histograms[static_cast<int>(ProfileStage::Count)];
+};
+
+// 区間の開始から破棄までを記録する
+class ProfileScope
+{
+ public:
+  ProfileScope(FrameProfiler &profiler, ProfileStage stage)
+      : profiler(profiler), stage(stage), startCycles(profiler.cycles())
+  {
+  }
+  ~ProfileScope() { profiler.recordSince(stage, startCycles); }
+
+ private:
+  FrameProfiler &profiler;
+  ProfileStage stage;
+  uint32_t startCycles;
+};
+
+// ────────────────────── 計測マクロ ──────────────────────
+// PROFILE_STAGE はスコープ終了まで、BEGIN/END は同じ関数内の 2 点間を計測する。
+// FRAME_PROFILER_ENABLED が 0 のときは何も生成しない
+#if FRAME_PROFILER_ENABLED
+extern FrameProfiler frameProfiler;
+// 実機の情報をメニューとシリアルへ出力する
+void drawFrameProfileSummary(int y);
+void printFrameProfile();
+
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+#define PROFILE_STAGE(stage) ProfileScope PROFILE_CONCAT(profileScope, __LINE__)(frameProfiler, ProfileStage::stage)
+#define PROFILE_STAGE_BEGIN(stage) uint32_t PROFILE_CONCAT(profileStart, stage) = frameProfiler.cycles()
+#define PROFILE_STAGE_END(stage) \
+  frameProfiler.recordSince(ProfileStage::stage, PROFILE_CONCAT(profileStart, stage))
+#define PROFILE_FRAME_BEGIN() frameProfiler.beginFrame()
+#define PROFILE_FRAME_END() frameProfiler.endFrame()
+#else
+#define PROFILE_STAGE(stage) ((void)0)
+#define PROFILE_STAGE_BEGIN(stage) ((void)0)
+#define PROFILE_STAGE_END(stage) ((void)0)
+#define PROFILE_FRAME_BEGIN() ((void)0)
+#define PROFILE_FRAME_END() ((void)0)
+#endif
+
+#endif  // FRAME_PROFILER_H
@@ -0,0 +1,191 @@
+#include "glyph_cache.h"
+
+#include <esp_heap_caps.h>
+
+#include <cstring>
+
+#include "dirty_region.h"
+
+// ────────────────────── DigitGlyphCache ──────────────────────
+auto DigitGlyphCache::build(const lgfx::IFont *font, uint16_t foreground, uint16_t background) -> bool
+{
+  release();
+
+  // 全グリフを 1 枚の作業用スプライトへ横に並べて描く
+  M5Canvas scratch;
+  scratch.setColorDepth(CANVAS_COLOR_DEPTH);
+  scratch.setFont(font);
+  scratch.setTextSize(1);
+  scratch.setTextWrap(false);
+  char text[2] = {};
+  int total = 0;
+  for (int i = 0; i < GLYPH_COUNT; ++i)
+  {
+    text[0] = GLYPHS[i];
+    offsets[i] = static_cast<int16_t>(total);
+    widths[i] = static_cast<int16_t>(scratch.textWidth(text));
+    total += widths[i];
+  }
+  cellH = scratch.fontHeight();
+  if (scratch.createSprite(total, cellH) == nullptr)
+  {
+    return false;
+  }
+  scratch.fillScreen(background);
+  scratch.setTextColor(foreground);
+  for (int i = 0; i < GLYPH_COUNT; ++i)
+  {
+    text[0] = GLYPHS[i];
+    scratch.setCursor(offsets[i], 0);
+    scratch.print(text);
+  }
+
+  // 背景の画素値はキャンバス内部の並び（バイト順・パレット番号）のまま比較する
+  const uint8_t *source = static_cast<const uint8_t *>(scratch.getBuffer());
+  const size_t sourceRowBytes = CanvasFormat::rowBytes(total);
+  uint16_t rawBackground = CanvasFormat::read(source, 0);
+  int first = cellH;
+  int last = -1;
+  for (int y = 0; y < cellH; ++y)
+  {
+    const uint8_t *row = source + (y * sourceRowBytes);
+    for (int x = 0; x < total; ++x)
+    {
+      if (CanvasFormat::read(row, x) != rawBackground)
+      {
+        first = (y < first) ? y : first;
+        last = y;
+        break;
+      }
+    }
+  }
+  if (last < first)
+  {
+    scratch.deleteSprite();
+    return false;
+  }
+
+  // インクのある行だけを残す
+  inkY = first;
+  inkH = last - first + 1;
+  rowBytes = sourceRowBytes;
+  pixels = static_cast<uint8_t *>(heap_caps_malloc(rowBytes * inkH, MALLOC_CAP_8BIT));
+  if (pixels != nullptr)
+  {
+    memcpy(pixels, source + (inkY * rowBytes), rowBytes * inkH);
+  }
+  scratch.deleteSprite();
+  backgroundColor = background;
+  return pixels != nullptr;
+}
+
+void DigitGlyphCache::release()
+{
+  if (pixels != nullptr)
+  {
+    heap_caps_free(pixels);
+    pixels = nullptr;
+  }
+}
+
+auto DigitGlyphCache::indexOf(char c) -> int
+{
+  for (int i = 0; i < GLYPH_COUNT; ++i)
+  {
+    if (GLYPHS[i] == c)
+    {
+      return i;
+    }
+  }
+  return -1;
+}
+
+void DigitGlyphCache::blit(M5Canvas &canvas, int index, int x, int top) const
+{
+  int y = top + inkY;
+  int w = widths[index];
+  int canvasW = canvas.width();
+  if (x < 0 || y < 0 || x + w > canvasW || y + inkH > canvas.height())
+  {
+    return;
+  }
+  const size_t canvasRowBytes = CanvasFormat::rowBytes(canvasW);
+  uint8_t *dest = static_cast<uint8_t *>(canvas.getBuffer()) + (y * canvasRowBytes);
+  for (int row = 0; row < inkH; ++row)
+  {
+    CanvasFormat::copy(dest + (row * canvasRowBytes), x, pixels + (row * rowBytes), offsets[index], w);
+  }
+}
+
+// ────────────────────── GlyphField ──────────────────────
+auto GlyphField::draw(M5Canvas &canvas, const char *text) -> bool
+{
+  if (cache == nullptr || !cache->isReady())
+  {
+    invalidate();
+    return false;
+  }
+
+  int8_t glyphs[MAX_CHARS];
+  int16_t xs[MAX_CHARS];
+  int count = 0;
+  int textWidth = 0;
+  for (const char *c = text; *c != '\0'; ++c)
+  {
+    int index = DigitGlyphCache::indexOf(*c);
+    if (index < 0 || count == MAX_CHARS)
+    {
+      invalidate();
+      return false;
+    }
+    glyphs[count++] = static_cast<int8_t>(index);
+    textWidth += cache->glyphWidth(index);
+  }
+  if (textWidth > width)
+  {
+    invalidate();
+    return false;
+  }
+
+  int left = right - textWidth;
+  for (int i = 0, x = left; i < count; x += cache->glyphWidth(glyphs[i]), ++i)
+  {
+    xs[i] = static_cast<int16_t>(x);
+  }
+
+  int inkTop = top + cache->inkTop();
+  int inkH = cache->inkHeight();
+  if (drawnCount < 0)
+  {
+    // 表示内容が不明なので欄全体を背景色にしてから全桁を描く
+    canvas.fillRect(right - width, inkTop, width, inkH, cache->background());
+    frameDirtyRegions.markRect(right - width, inkTop, width, inkH);
+  }
+  else if (drawnLeft < left)
+  {
+    // 桁が減った分の左側を消す
+    canvas.fillRect(drawnLeft, inkTop, left - drawnLeft, inkH, cache->background());
+    frameDirtyRegions.markRect(drawnLeft, inkTop, left - drawnLeft, inkH);
+  }
+
+  for (int i = 0; i < count; ++i)
+  {
+    // 同じ位置に同じ文字が描かれていれば複写しない
+    bool isSame = false;
+    for (int j = 0; j < drawnCount && !isSame; ++j)
+    {
+      isSame = (drawnX[j] == xs[i] && drawnGlyphs[j] == glyphs[i]);
+    }
+    if (!isSame)
+    {
+      cache->blit(canvas, glyphs[i], xs[i], top);
+      frameDirtyRegions.markRect(xs[i], inkTop, cache->glyphWidth(glyphs[i]), inkH);
+    }
+  }
+
+  memcpy(drawnGlyphs, glyphs, count * sizeof(glyphs[0]));
+  memcpy(drawnX, xs, count * sizeof(xs[0]));
+  drawnCount = count;
+  drawnLeft = left;
+  return true;
+}
@@ -0,0 +1,81 @@
+#ifndef GLYPH_CACHE_H
+#define GLYPH_CACHE_H
+
+#include <M5GFX.h>
+
+#include <cstdint>
+
+#include "canvas_palette.h"
+#include "config.h"
+
+// ────────────────────── 数字グリフのキャッシュ ──────────────────────
+// 数値表示に使う文字を起動時に一度だけフォント経由で描き、mainCanvas と同じ画素形式で保持する。
+// 描画時はフォントの展開や文字幅の計算を行わず、インクのある行だけを memcpy で複写する
+class DigitGlyphCache
+{
+ public:
+  static constexpr char GLYPHS[] = "0123456789.-";
+  static constexpr int GLYPH_COUNT = sizeof(GLYPHS) - 1;
+
+  // font の各文字を前景色・背景色（canvasColor() の値）で描いて保持する。確保に失敗したら false
+  auto build(const lgfx::IFont *font, uint16_t foreground, uint16_t background) -> bool;
+  void release();
+
+  auto isReady() const -> bool { return pixels != nullptr; }
+  // キャッシュに無い文字は -1
+  static auto indexOf(char c) -> int;
+  auto glyphWidth(int index) const -> int { return widths[index]; }
+  // フォントの行送り（文字セルの高さ）と、全グリフを通したインクの行範囲
+  auto cellHeight() const -> int { return cellH; }
+  auto inkTop() const -> int { return inkY; }
+  auto inkHeight() const -> int { return inkH; }
+  auto background() const -> uint16_t { return backgroundColor; }
+
+  // 文字セルの左上を (x, top) としてインクの行範囲を複写する。キャンバスからはみ出す場合は何もしない
+  void blit(M5Canvas &canvas, int index, int x, int top) const;
+
+ private:
+  uint8_t *pixels = nullptr;  // 全グリフを横に並べた画像（インクの行のみ、CanvasFormat で詰めた行）
+  size_t rowBytes = 0;
+  int16_t offsets[GLYPH_COUNT] = {};
+  int16_t widths[GLYPH_COUNT] = {};
+  int cellH = 0;
+  int inkY = 0;
+  int inkH = 0;
+  uint16_t backgroundColor = 0;
+};
+
+// ────────────────────── 数値欄 ──────────────────────
+// 右端を固定した数値の表示欄。前回描いた文字と位置を覚えておき、変わったグリフだけを複写する。
+// 描いた範囲は frameDirtyRegions へ記録する
+class GlyphField
+{
+ public:
+  static constexpr int MAX_CHARS = 8;
+
+  GlyphField() = default;
+  // right: 右端（この座標は含まない）、top: 文字セルの上端、width: 欄の最大幅
+  GlyphField(const DigitGlyphCache &cache, int right, int top, int width)
+      : cache(&cache), right(right), top(top), width(width)
+  {
+  }
+
+  // 下地が描き直された、または上に別の表示が重なったため、次回は欄全体を描き直す
+  void invalidate() { drawnCount = -1; }
+
+  // text を右揃えで描く。キャッシュに無い文字を含む・欄に収まらない場合は何も描かず false を返すので、
+  // 呼び出し側はフォントで描く（欄は無効化される）
+  auto draw(M5Canvas &canvas, const char *text) -> bool;
+
+ private:
+  const DigitGlyphCache *cache = nullptr;
+  int right = 0;
+  int top = 0;
+  int width = 0;
+  int drawnCount = -1;  // -1: 表示内容が不明
+  int drawnLeft = 0;    // 前回描いた文字列の左端
+  int8_t drawnGlyphs[MAX_CHARS] = {};
+  int16_t drawnX[MAX_CHARS] = {};
+};
+
+#endif  // GLYPH_CACHE_H
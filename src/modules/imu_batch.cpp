@@ -0,0 +1,108 @@
+#include "imu_batch.h"
+
+#include <cmath>
+
+// ────────────────────── FIFO の解析 ──────────────────────
+auto parseAccelFifo(const uint8_t *data, size_t length, float scale, AccelSample *out, size_t maxSamples) -> size_t
+{
+  constexpr int16_t INVALID_FRAME = static_cast<int16_t>(0x8000);
+  size_t stored = 0;
+  for (size_t pos = 0; pos + IMU_FIFO_FRAME_BYTES <= length && stored < maxSamples; pos += IMU_FIFO_FRAME_BYTES)
+  {
+    int16_t raw[3];
+    for (int axis = 0; axis < 3; ++axis)
+    {
+      raw[axis] = static_cast<int16_t>(data[pos + (axis * 2)] | (data[pos + (axis * 2) + 1] << 8));
+    }
+    if (raw[0] == INVALID_FRAME && raw[1] == INVALID_FRAME && raw[2] == INVALID_FRAME)
+    {
+      continue;
+    }
+    out[stored++] = {raw[0] * scale, raw[1] * scale, raw[2] * scale};
+  }
+  return stored;
+}
+
+// ────────────────────── 向きの判定 ──────────────────────
+// 許容角度 10 度以内で単独方向とし、それ以外は斜め方向とする
+auto classifyGDirection(float lateral, float longitudinal) -> const char *
+{
+  constexpr float PURE_TAN = 0.17632698F;  // tan(10度)
+  float absLat = std::fabs(lateral);
+  float absLon = std::fabs(longitudinal);
+  if (absLat <= absLon * PURE_TAN)
+  {
+    // 前後方向として扱う
+    return (longitudinal >= 0.0F) ? "Front" : "Rear";
+  }
+  if (absLon <= absLat * PURE_TAN)
+  {
+    // 左右方向として扱う
+    return (lateral >= 0.0F) ? "Right" : "Left";
+  }
+  // 斜め方向 (Front/Rear + Left/Right)
+  if (longitudinal >= 0.0F)
+  {
+    return (lateral >= 0.0F) ? "FR" : "FL";
+  }
+  return (lateral >= 0.0F) ? "RR" : "RL";
+}
+
+// ────────────────────── GForceFilter ──────────────────────
+void GForceFilter::configure(float cutoffHz, float sampleRateHz)
+{
+  // 1 次ローパスの離散化: alpha = 1 - exp(-2π fc / fs)
+  alpha = 1.0F - std::exp(-2.0F * static_cast<float>(M_PI) * cutoffHz / sampleRateHz);
+}
+
+void GForceFilter::reset()
+{
+  offset = {};
+  filtered = {};
+  offsetCount = 0;
+}
+
+auto GForceFilter::processBatch(const AccelSample *samples, size_t count) -> GForceSummary
+{
+  GForceSummary summary = {0.0F, 0.0F, "Right", static_cast<uint16_t>(count)};
+  float sum = 0.0F;
+  for (size_t i = 0; i < count; ++i)
+  {
+    const AccelSample &s = samples[i];
+    if (!isCalibrated())
+    {
+      // 静止状態の平均をオフセットとし、フィルタもその値から始める
+      offset.x += s.x;
+      offset.y += s.y;
+      offset.z += s.z;
+      if (++offsetCount == OFFSET_SAMPLE_COUNT)
+      {
+        offset.x /= OFFSET_SAMPLE_COUNT;
+        offset.y /= OFFSET_SAMPLE_COUNT;
+        offset.z /= OFFSET_SAMPLE_COUNT;
+        filtered = offset;
+      }
+      continue;
+    }
+
+    filtered.x += alpha * (s.x - filtered.x);
+    filtered.y += alpha * (s.y - filtered.y);
+    filtered.z += alpha * (s.z - filtered.z);
+
+    // Z 軸を上下として除き、Y を左右・X を前後として扱う
+    float lateral = filtered.y - offset.y;
+    float longitudinal = filtered.x - offset.x;
+    float g = std::sqrt((lateral * lateral) + (longitudinal * longitudinal));
+    sum += g;
+    if (g >= summary.peak)
+    {
+      summary.peak = g;
+      summary.direction = classifyGDirection(lateral, longitudinal);
+    }
+  }
+  if (count > 0)
+  {
+    summary.mean = sum / static_cast<float>(count);
+  }
+  return summary;
+}
@@ -0,0 +1,65 @@
+#ifndef IMU_BATCH_H
+#define IMU_BATCH_H
+
+#include <cstddef>
+#include <cstdint>
+
+// ────────────────────── 加速度バッチ ──────────────────────
+// IMU の FIFO から一度に読み出した加速度 [G]
+struct AccelSample
+{
+  float x;
+  float y;
+  float z;
+};
+
+// 1 回の取得で読み出す最大サンプル数。定常では 1 回に 3〜4 サンプル (800Hz × 4ms) しか溜まらず、
+// この上限は取得タスクが I2C の占有などで止められたときの余裕（800Hz で 40ms 分）
+constexpr size_t IMU_BATCH_MAX_SAMPLES = 32;
+// ヘッダなし FIFO の 1 フレーム（X/Y/Z 各 16bit リトルエンディアン）
+constexpr size_t IMU_FIFO_FRAME_BYTES = 6;
+
+// ヘッダなし FIFO のバイト列を加速度へ変換し、格納したサンプル数を返す。
+// scale は 1LSB あたりの G。空読み時の無効フレーム (0x8000) は読み飛ばす
+auto parseAccelFifo(const uint8_t *data, size_t length, float scale, AccelSample *out, size_t maxSamples)
+    -> size_t;
+
+// 前後・左右の成分から向きの文字列（Front/Rear/Right/Left/FR/FL/RR/RL）を返す
+auto classifyGDirection(float lateral, float longitudinal) -> const char *;
+
+// ────────────────────── バッチの要約 ──────────────────────
+struct GForceSummary
+{
+  float mean;             // バッチ内の水平加速度の平均 [G]
+  float peak;             // バッチ内の最大値 [G]
+  const char *direction;  // 最大値のときの向き
+  uint16_t count;         // 処理したサンプル数
+};
+
+// 起動直後のオフセット補正とローパスフィルタを掛け、バッチごとに平均と最大を求める。
+// 入力も出力も float で、累積する合計も無いため FPU でそのまま計算する
+class GForceFilter
+{
+ public:
+  // オフセットを平均するサンプル数
+  static constexpr int OFFSET_SAMPLE_COUNT = 20;
+
+  GForceFilter(float cutoffHz, float sampleRateHz) { configure(cutoffHz, sampleRateHz); }
+
+  // 1 次 IIR の係数をサンプリング周波数に合わせて設定する
+  void configure(float cutoffHz, float sampleRateHz);
+  // オフセットとフィルタ状態を破棄し、補正からやり直す
+  void reset();
+  auto isCalibrated() const -> bool { return offsetCount >= OFFSET_SAMPLE_COUNT; }
+
+  // バッチを処理する。オフセット確定までのサンプルは 0G として数える
+  auto processBatch(const AccelSample *samples, size_t count) -> GForceSummary;
+
+ private:
+  float alpha = 1.0F;
+  AccelSample offset = {};
+  AccelSample filtered = {};
+  int offsetCount = 0;
+};
+
+#endif  // IMU_BATCH_H
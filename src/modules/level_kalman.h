@@ -0,0 +1,137 @@
+#ifndef LEVEL_KALMAN_H
+#define LEVEL_KALMAN_H
+
+#include <cstddef>
+#include <cstdint>
+
+// ────────────────────── 1 次元カルマンフィルタ（水準モデル） ──────────────────────
+// 真値はランダムウォーク、測定は白色雑音とみなす。共分散の推移は入力に依存しないため、
+// ゲイン列はコンパイル時に求めて表で持ち、実行時は比較と乗算 1 回で更新する。
+// 定常状態では係数 K∞ の EMA と同じだが、イノベーションが同じ向きに連続してゲートを超えたら
+// 段差とみなして共分散を初期化する。以降は段差後のサンプルの累積平均として収束し直すため、
+// 平滑化を強くしても段差には数サンプルで追従する
+
+namespace level_kalman_detail
+{
+// constexpr で使える平方根（ニュートン法）
+constexpr auto sqrtNewton(double v) -> double
+{
+  if (v <= 0.0)
+  {
+    return 0.0;
+  }
+  double x = (v > 1.0) ? v : 1.0;
+  for (int i = 0; i < 64; ++i)
+  {
+    x = 0.5 * (x + (v / x));
+  }
+  return x;
+}
+
+// 初期化直後の事前分散（測定雑音の分散に対する比）。最初のゲインがほぼ 1 になる大きさ
+constexpr double INITIAL_VARIANCE_RATIO = 1.0e6;
+}  // namespace level_kalman_detail
+
+// 設計値から求めたゲイン列と定常特性
+template <typename Q, size_t STEPS>
+struct LevelKalmanGains
+{
+  Q gains[STEPS];           // 初期化から k サンプル目のゲイン（最後の要素は定常ゲイン）
+  Q gate;                   // 段差とみなすイノベーションの大きさ
+  float steadyGain;         // 定常ゲイン K∞
+  float groupDelaySamples;  // 定常状態の群遅延 (1 - K∞) / K∞ [サンプル]
+  bool isConverged;         // 表の末尾までにゲインが定常値へ収束したか
+};
+
+// noise: 測定雑音の標準偏差、driftPerSqrtS: 真値のゆらぎ [単位/√s]、
+// samplePeriodS: サンプル間隔 [s]、gateSigma: ゲート幅（定常時のイノベーションの標準偏差の倍数）
+template <typename Q, size_t STEPS>
+constexpr auto makeLevelKalmanGains(float noise, float driftPerSqrtS, float samplePeriodS, float gateSigma)
+    -> LevelKalmanGains<Q, STEPS>
+{
+  static_assert(STEPS >= 2, "ゲイン列は 2 要素以上");
+  using level_kalman_detail::sqrtNewton;
+  LevelKalmanGains<Q, STEPS> result{};
+
+  // 分散は測定雑音の分散で正規化して計算する
+  double noiseVariance = static_cast<double>(noise) * noise;
+  double processRatio = static_cast<double>(driftPerSqrtS) * driftPerSqrtS * samplePeriodS / noiseVariance;
+  double predicted = level_kalman_detail::INITIAL_VARIANCE_RATIO;
+  double lastGain = 1.0;
+  for (size_t k = 0; k < STEPS - 1; ++k)
+  {
+    lastGain = predicted / (predicted + 1.0);
+    result.gains[k] = Q::fromFloat(static_cast<float>(lastGain));
+    predicted = ((1.0 - lastGain) * predicted) + processRatio;
+  }
+
+  // 定常解: 予測後の分散 P は P^2 - qP - q = 0 の正の根
+  double steadyPredicted = (processRatio + sqrtNewton((processRatio * processRatio) + (4.0 * processRatio))) / 2.0;
+  double steadyGain = steadyPredicted / (steadyPredicted + 1.0);
+  result.gains[STEPS - 1] = Q::fromFloat(static_cast<float>(steadyGain));
+  result.gate = Q::fromFloat(static_cast<float>(gateSigma * noise * sqrtNewton(steadyPredicted + 1.0)));
+  result.steadyGain = static_cast<float>(steadyGain);
+  result.groupDelaySamples = static_cast<float>((1.0 - steadyGain) / steadyGain);
+  // 末尾の 1 つ手前が定常値から 1% 以内なら、表の打ち切りによる段差は無視できる
+  double gap = lastGain - steadyGain;
+  result.isConverged = ((gap >= 0.0) ? gap : -gap) <= steadyGain * 0.01;
+  return result;
+}
+
+// ────────────────────── 推定器 ──────────────────────
+template <typename Q, size_t STEPS>
+class LevelKalman
+{
+ public:
+  constexpr LevelKalman(const LevelKalmanGains<Q, STEPS> &design, int confirmSamples)
+      : design(&design), confirmSamples(confirmSamples)
+  {
+  }
+
+  // 最初の測定値はそのまま推定値とする
+  auto update(Q measurement) -> Q
+  {
+    if (!initialized)
+    {
+      reset(measurement);
+      return current;
+    }
+    Q innovation = measurement - current;
+    int direction = (innovation > design->gate) ? 1 : (innovation < Q() - design->gate) ? -1 : 0;
+    exceedCount = (direction != 0 && direction == lastDirection) ? exceedCount + 1 : (direction != 0) ? 1 : 0;
+    lastDirection = direction;
+    if (exceedCount >= confirmSamples)
+    {
+      // 段差: 共分散を初期化し、この測定値から平均を取り直す
+      step = 0;
+      exceedCount = 0;
+      lastDirection = 0;
+    }
+    current += design->gains[step] * innovation;
+    step = (step + 1 < STEPS) ? step + 1 : STEPS - 1;
+    return current;
+  }
+  // 推定値を固定し、定常ゲインから再開する
+  void reset(Q value)
+  {
+    current = value;
+    step = STEPS - 1;
+    exceedCount = 0;
+    lastDirection = 0;
+    initialized = true;
+  }
+  auto value() const -> Q { return current; }
+  // 段差の検出直後など、ゲインが定常値より大きい区間か
+  auto isSettling() const -> bool { return step < STEPS - 1; }
+
+ private:
+  const LevelKalmanGains<Q, STEPS> *design;
+  int confirmSamples;
+  Q current;
+  size_t step = STEPS - 1;
+  int exceedCount = 0;
+  int lastDirection = 0;
+  bool initialized = false;
+};
+
+#endif  // LEVEL_KALMAN_H
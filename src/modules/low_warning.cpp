@@ -4,7 +4,9 @@
 #include <cmath>
 #include <limits>
 
+#include "canvas_palette.h"
 #include "config.h"
+#include "dirty_region.h"
 #include "sensor.h"
 
 // 直近の低油圧イベント情報
@@ -30,10 +32,11 @@ struct LowWarningState
 };
 
 // 油圧警告表示。現在の表示状態とその変更の有無を返す
-bool drawLowPressureWarning(M5Canvas &canvas, float gForce, float pressure, bool &stateChanged)
+bool drawLowPressureWarning(M5Canvas &canvas, float gForce, float gForcePeak, float pressure, bool &stateChanged,
+                            const M5Canvas *background)
 {
-  constexpr int GAUGE_X = 0;    // 油圧ゲージの左上X
-  constexpr int GAUGE_Y = 60;   // 油圧ゲージの左上Y
+  constexpr int GAUGE_X = 0;    // 油圧ゲージのスプライト内の左上X
+  constexpr int GAUGE_Y = 0;    // 油圧ゲージのスプライト内の左上Y
   constexpr int GAUGE_W = 160;  // ゲージ幅
   constexpr int GAUGE_H = 170;  // ゲージ高さ
 
@@ -80,7 +83,7 @@ bool drawLowPressureWarning(M5Canvas &canvas, float gForce, float pressure, bool
     {
       // 新しいイベント開始
       state.startMs = now;
-      state.peakG = gForce;
+      state.peakG = gForcePeak;
       state.minPressure = pressure;
       state.eventDir = currentGDirection;
       state.eventLogged = false;
@@ -88,7 +91,7 @@ bool drawLowPressureWarning(M5Canvas &canvas, float gForce, float pressure, bool
     else
     {
       // イベント継続中は最大/最小値を更新
-      state.peakG = std::max(state.peakG, gForce);
+      state.peakG = std::max(state.peakG, gForcePeak);
       state.minPressure = std::min(state.minPressure, pressure);
     }
     if (now - state.startMs >= WARNING_DELAY_MS)
@@ -115,23 +118,26 @@ bool drawLowPressureWarning(M5Canvas &canvas, float gForce, float pressure, bool
     }
   }
 
-  if (shouldShow)
+  // 警告の文字と色は一定なので、表示し始めたときと、ゲージの再描画で下地ごと上書きされたときだけ描く
+  bool isBoxOverdrawn = frameDirtyRegions.overlaps(layout.boxX, layout.boxY, layout.boxW, layout.boxH);
+  if (shouldShow && (!prevShowing || isBoxOverdrawn))
   {
-    // 警告表示を毎フレーム再描画
-    canvas.fillRect(layout.boxX, layout.boxY, layout.boxW, layout.boxH, COLOR_RED);
-    canvas.setTextColor(COLOR_WHITE, COLOR_RED);
+    canvas.fillRect(layout.boxX, layout.boxY, layout.boxW, layout.boxH, canvasColor(COLOR_RED));
+    canvas.setTextColor(canvasColor(COLOR_WHITE), canvasColor(COLOR_RED));
     canvas.setTextDatum(m5gfx::textdatum_t::middle_center);
     canvas.drawString(WARN_TEXT, layout.boxX + (layout.boxW / 2), layout.boxY + (layout.boxH / 2));
     canvas.setTextDatum(m5gfx::textdatum_t::top_left);
+    frameDirtyRegions.markRect(layout.boxX, layout.boxY, layout.boxW, layout.boxH);
     state.boxX = layout.boxX;
     state.boxY = layout.boxY;
     state.boxW = layout.boxW;
     state.boxH = layout.boxH;
   }
-  else if (prevShowing)
+  else if (!shouldShow && prevShowing)
   {
-    // 表示継続時間が過ぎたので警告を消去
-    canvas.fillRect(state.boxX, state.boxY, state.boxW, state.boxH, COLOR_BLACK);
+    // 表示継続時間が過ぎたので警告の下にあった目盛などを背景レイヤーから戻す
+    restoreCanvasRect(canvas, background, state.boxX, state.boxY, state.boxW, state.boxH, canvasColor(COLOR_BLACK));
+    frameDirtyRegions.markRect(state.boxX, state.boxY, state.boxW, state.boxH);
     // 次回のイベントに備えて状態をリセット
     state = {};
   }
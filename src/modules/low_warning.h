@@ -9,7 +9,10 @@ extern const char *lastLowEventDir;  // Gの向き
 extern float lastLowEventDuration;   // 継続時間[s]
 extern float lastLowEventPressure;   // そのときの油圧[bar]
 
-// 低油圧警告表示。解除後も3秒間表示を継続し、現在の表示状態とその変更の有無を返す
-bool drawLowPressureWarning(M5Canvas &canvas, float gForce, float pressure, bool &stateChanged);
+// 低油圧警告表示（油圧ゲージのスプライトへ描く）。解除後も3秒間表示を継続し、現在の表示状態とその変更の有無を返す。
+// 判定はフレーム内の平均 G、イベントの記録値は最大 G を使う
+// 消去は background（油圧ゲージの背景レイヤー）からの複写で行い、無ければ黒で塗る
+bool drawLowPressureWarning(M5Canvas &canvas, float gForce, float gForcePeak, float pressure, bool &stateChanged,
+                            const M5Canvas *background = nullptr);
 
 #endif  // LOW_WARNING_H
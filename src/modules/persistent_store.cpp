@@ -0,0 +1,203 @@
+#include "persistent_store.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "session_log.h"
+
+// ────────────────────── 値の変換 ──────────────────────
+// 固定小数点へ丸め、型の範囲に収める
+template <typename T>
+static auto toFixed(float value, float scale) -> T
+{
+  float scaled = std::round(value * scale);
+  scaled = std::min(std::max(scaled, static_cast<float>(std::numeric_limits<T>::min())),
+                    static_cast<float>(std::numeric_limits<T>::max()));
+  return static_cast<T>(scaled);
+}
+
+auto makePersistentState(float maxOilPressure, float maxWaterTemp, int maxOilTemp, float lowEventG,
+                         const char *lowEventDirection, float lowEventDuration, float lowEventPressure)
+    -> PersistentState
+{
+  PersistentState state = {};
+  state.maxOilPressureCbar = toFixed<uint16_t>(maxOilPressure, 100.0F);
+  state.maxWaterTempDeci = toFixed<int16_t>(maxWaterTemp, 10.0F);
+  state.maxOilTemp = toFixed<int16_t>(static_cast<float>(maxOilTemp), 1.0F);
+  state.lowEventDirection = LOG_G_DIRECTION_COUNT;  // 不明
+  for (uint8_t i = 0; i < LOG_G_DIRECTION_COUNT; ++i)
+  {
+    if (lowEventDirection != nullptr && strcmp(lowEventDirection, LOG_G_DIRECTIONS[i]) == 0)
+    {
+      state.lowEventDirection = i;
+    }
+  }
+  state.lowEventGMilli = toFixed<uint16_t>(lowEventG, 1000.0F);
+  state.lowEventDurationCentisec = toFixed<uint16_t>(lowEventDuration, 100.0F);
+  state.lowEventPressureCbar = toFixed<uint16_t>(lowEventPressure, 100.0F);
+  return state;
+}
+
+auto persistentDirectionName(const PersistentState &state, const char *fallback) -> const char *
+{
+  return (state.lowEventDirection < LOG_G_DIRECTION_COUNT) ? LOG_G_DIRECTIONS[state.lowEventDirection] : fallback;
+}
+
+// ────────────────────── 記録の検証 ──────────────────────
+// CRC-32（IEEE 802.3）。記録は 28 バイトなので表を持たずビット単位で計算する
+static auto crc32(const uint8_t *data, size_t length) -> uint32_t
+{
+  uint32_t crc = 0xFFFFFFFFU;
+  for (size_t i = 0; i < length; ++i)
+  {
+    crc ^= data[i];
+    for (int bit = 0; bit < 8; ++bit)
+    {
+      crc = (crc >> 1) ^ (0xEDB88320U & (0U - (crc & 1U)));
+    }
+  }
+  return ~crc;
+}
+
+static auto recordCrc(const StoreRecord &record) -> uint32_t
+{
+  return crc32(reinterpret_cast<const uint8_t *>(&record), offsetof(StoreRecord, crc));
+}
+
+static auto isValidRecord(const StoreRecord &record) -> bool
+{
+  return record.magic == STORE_RECORD_MAGIC && record.version == STORE_FORMAT_VERSION &&
+         record.crc == recordCrc(record);
+}
+
+static auto isErasedRecord(const StoreRecord &record) -> bool
+{
+  const uint8_t *bytes = reinterpret_cast<const uint8_t *>(&record);
+  return std::all_of(bytes, bytes + sizeof(record), [](uint8_t b) { return b == 0xFF; });
+}
+
+// ────────────────────── 復元 ──────────────────────
+auto PersistentStore::restore() -> bool
+{
+  const size_t sectorCount = flash.size() / STORE_SECTOR_SIZE;
+  dirty = false;
+  writeOffset = 0;
+  isWriteSectorErased = false;
+  nextSequence = 1;
+
+  // セクタは先頭から順に埋まるため、先頭の記録が最も新しいセクタに最新の記録がある
+  size_t latestSector = sectorCount;
+  uint32_t latestSequence = 0;
+  for (size_t sector = 0; sector < sectorCount; ++sector)
+  {
+    StoreRecord record;
+    if (flash.read(sector * STORE_SECTOR_SIZE, &record, sizeof(record)) && isValidRecord(record) &&
+        (latestSector == sectorCount || record.sequence > latestSequence))
+    {
+      latestSector = sector;
+      latestSequence = record.sequence;
+    }
+  }
+  if (latestSector == sectorCount)
+  {
+    // 記録が無い。先頭セクタを消去してから書き始める
+    return false;
+  }
+
+  // そのセクタを消去済みの位置まで読み、CRC の合う最後の記録を採る（書き込み途中で電源が切れた記録は飛ばす）
+  const size_t sectorStart = latestSector * STORE_SECTOR_SIZE;
+  size_t slot = 0;
+  for (; slot < STORE_RECORDS_PER_SECTOR; ++slot)
+  {
+    StoreRecord record;
+    if (!flash.read(sectorStart + (slot * sizeof(record)), &record, sizeof(record)) || isErasedRecord(record))
+    {
+      break;
+    }
+    if (isValidRecord(record) && record.sequence >= latestSequence)
+    {
+      shadow = record.state;
+      latestSequence = record.sequence;
+    }
+  }
+  nextSequence = latestSequence + 1;
+  writeOffset = sectorStart + (slot * sizeof(StoreRecord));
+  isWriteSectorErased = true;
+  if (slot == STORE_RECORDS_PER_SECTOR)
+  {
+    writeOffset -= sizeof(StoreRecord);
+    advance();
+  }
+  return true;
+}
+
+// ────────────────────── 書き込み ──────────────────────
+void PersistentStore::update(const PersistentState &next)
+{
+  if (memcmp(&next, &shadow, sizeof(shadow)) != 0)
+  {
+    shadow = next;
+    dirty = true;
+  }
+}
+
+void PersistentStore::advance()
+{
+  writeOffset += sizeof(StoreRecord);
+  if (writeOffset % STORE_SECTOR_SIZE == 0)
+  {
+    writeOffset = (writeOffset >= flash.size()) ? 0 : writeOffset;
+    isWriteSectorErased = false;
+  }
+}
+
+auto PersistentStore::eraseAhead() -> bool
+{
+  if (isWriteSectorErased)
+  {
+    return false;
+  }
+  if (!flash.eraseSector(writeOffset - (writeOffset % STORE_SECTOR_SIZE)))
+  {
+    ++failedCount;
+    return true;
+  }
+  isWriteSectorErased = true;
+  ++erasedCount;
+  return true;
+}
+
+auto PersistentStore::service(bool allowErase) -> bool
+{
+  if (!dirty)
+  {
+    return false;
+  }
+
+  if (!isWriteSectorErased)
+  {
+    // 次のセクタを消去する。最新の記録は直前のセクタに残っているため、途中で電源が切れても失われない
+    return allowErase && eraseAhead();
+  }
+
+  StoreRecord record;
+  memset(&record, 0, sizeof(record));
+  record.magic = STORE_RECORD_MAGIC;
+  record.version = STORE_FORMAT_VERSION;
+  record.sequence = nextSequence;
+  record.state = shadow;
+  record.crc = recordCrc(record);
+  bool ok = flash.write(writeOffset, &record, sizeof(record));
+  // 失敗した位置は一部だけ書かれている可能性があるため再利用せず、次の位置で書き直す
+  advance();
+  if (!ok)
+  {
+    ++failedCount;
+    return true;
+  }
+  ++nextSequence;
+  ++writtenCount;
+  dirty = false;
+  return true;
+}
@@ -0,0 +1,177 @@
+#ifndef PERSISTENT_STORE_H
+#define PERSISTENT_STORE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+// ────────────────────── 保存する値 ──────────────────────
+// 電源を切っても残す最大値と直近の低油圧イベント（固定小数点、リトルエンディアン）
+struct PersistentState
+{
+  uint16_t maxOilPressureCbar;        // 油圧の最大値 [0.01bar]
+  int16_t maxWaterTempDeci;           // 水温の最大値 [0.1℃]
+  int16_t maxOilTemp;                 // 油温の最大値 [℃]
+  uint8_t lowEventDirection;          // 低油圧イベントの G の向き（LOG_G_DIRECTIONS の添字）
+  uint8_t reserved;
+  uint16_t lowEventGMilli;            // 低油圧イベントの G [0.001G]
+  uint16_t lowEventDurationCentisec;  // 低油圧イベントの継続時間 [0.01s]
+  uint16_t lowEventPressureCbar;      // 低油圧イベントの油圧 [0.01bar]
+  uint16_t reserved2;
+};
+static_assert(sizeof(PersistentState) == 16, "PersistentState は 16 バイト固定");
+
+// 工学値から保存する値を作成する
+auto makePersistentState(float maxOilPressure, float maxWaterTemp, int maxOilTemp, float lowEventG,
+                         const char *lowEventDirection, float lowEventDuration, float lowEventPressure)
+    -> PersistentState;
+// 保存した向きの文字列。不明な値なら fallback
+auto persistentDirectionName(const PersistentState &state, const char *fallback) -> const char *;
+
+// ────────────────────── 記録フォーマット ──────────────────────
+// フラッシュへ追記する 1 件分の記録（32 バイト）。消去済みの領域は全ビットが 1 (0xFF)
+struct StoreRecord
+{
+  uint16_t magic;     // STORE_RECORD_MAGIC
+  uint16_t version;   // STORE_FORMAT_VERSION
+  uint32_t sequence;  // 書き込み順の通し番号（大きいほど新しい）
+  PersistentState state;
+  uint32_t reserved;
+  uint32_t crc;  // magic から reserved までの CRC-32
+};
+static_assert(sizeof(StoreRecord) == 32, "StoreRecord は 32 バイト固定");
+
+constexpr uint16_t STORE_RECORD_MAGIC = 0x5347;  // "GS"
+constexpr uint16_t STORE_FORMAT_VERSION = 1;
+// 消去単位。ESP32 の内蔵フラッシュと同じ 4KB
+constexpr size_t STORE_SECTOR_SIZE = 4096;
+constexpr size_t STORE_RECORDS_PER_SECTOR = STORE_SECTOR_SIZE / sizeof(StoreRecord);
+
+// ────────────────────── フラッシュ領域の抽象 ──────────────────────
+// 実機ではデータパーティション、ホストではファイルが実装する。NOR フラッシュと同様に、
+// 書き込みはビットを 1 → 0 にしか変えられず、0 → 1 へ戻すにはセクタ単位の消去が要る
+class FlashRegion
+{
+ public:
+  virtual ~FlashRegion() = default;
+  // 領域の大きさ（STORE_SECTOR_SIZE の倍数）
+  virtual auto size() const -> size_t = 0;
+  virtual auto read(size_t offset, void *data, size_t length) -> bool = 0;
+  // 消去済みの範囲へ書き込む
+  virtual auto write(size_t offset, const void *data, size_t length) -> bool = 0;
+  // offset から始まる 1 セクタを消去する（数十 ms かかる）
+  virtual auto eraseSector(size_t offset) -> bool = 0;
+};
+
+// stdio のファイルで NOR フラッシュを模した実装（ホストでの検証用）。ファイルの末尾より先は消去済みとして読む
+class FileFlashRegion : public FlashRegion
+{
+ public:
+  FileFlashRegion(FILE *file, size_t size) : file(file), regionSize(size) {}
+
+  auto size() const -> size_t override { return regionSize; }
+
+  auto read(size_t offset, void *data, size_t length) -> bool override
+  {
+    if (offset + length > regionSize || fseek(file, static_cast<long>(offset), SEEK_SET) != 0)
+    {
+      return false;
+    }
+    size_t got = fread(data, 1, length, file);
+    memset(static_cast<uint8_t *>(data) + got, 0xFF, length - got);
+    return true;
+  }
+
+  auto write(size_t offset, const void *data, size_t length) -> bool override
+  {
+    uint8_t current[STORE_SECTOR_SIZE];
+    if (length > sizeof(current) || !read(offset, current, length))
+    {
+      return false;
+    }
+    // 書き込めるのは 1 → 0 の変化だけ
+    const uint8_t *bytes = static_cast<const uint8_t *>(data);
+    for (size_t i = 0; i < length; ++i)
+    {
+      current[i] &= bytes[i];
+    }
+    return seekForWrite(offset) && fwrite(current, 1, length, file) == length && fflush(file) == 0;
+  }
+
+  auto eraseSector(size_t offset) -> bool override
+  {
+    uint8_t erased[STORE_SECTOR_SIZE];
+    memset(erased, 0xFF, sizeof(erased));
+    return offset % STORE_SECTOR_SIZE == 0 && offset + STORE_SECTOR_SIZE <= regionSize && seekForWrite(offset) &&
+           fwrite(erased, 1, sizeof(erased), file) == sizeof(erased) && fflush(file) == 0;
+  }
+
+ private:
+  // ファイルが offset より短ければ、間を消去済み (0xFF) で埋めてから位置を合わせる
+  auto seekForWrite(size_t offset) -> bool
+  {
+    if (fseek(file, 0, SEEK_END) != 0)
+    {
+      return false;
+    }
+    for (long end = ftell(file); end >= 0 && static_cast<size_t>(end) < offset; ++end)
+    {
+      fputc(0xFF, file);
+    }
+    return fseek(file, static_cast<long>(offset), SEEK_SET) == 0;
+  }
+
+  FILE *file;
+  size_t regionSize;
+};
+
+// ────────────────────── 永続ストア ──────────────────────
+// 値は RAM 上の写しだけを更新し、フラッシュへの反映は呼び出し側が空き時間に service() で 1 操作ずつ行う。
+// 記録は領域全体を環状に追記していくため、各セクタの消去回数は均等になる
+class PersistentStore
+{
+ public:
+  explicit PersistentStore(FlashRegion &flash) : flash(flash) {}
+
+  // 起動時に一度呼び、最新の有効な記録を RAM へ読み込む。記録が無ければ false
+  auto restore() -> bool;
+  auto state() const -> const PersistentState & { return shadow; }
+  // RAM 上の値を更新する。変化があれば書き込み待ちにする（フラッシュには触れない）
+  void update(const PersistentState &next);
+  auto isDirty() const -> bool { return dirty; }
+  // 書き込み待ちがあれば、記録 1 件の書き込みかセクタ 1 つの消去のどちらか 1 操作だけ行う。
+  // allowErase が false の間は消去が必要な書き込みを見送る。フラッシュを操作した場合 true
+  auto service(bool allowErase) -> bool;
+  // 次に記録を書くセクタが未消去なら、書き込み待ちが無くても先に消去しておく。
+  // 停車中に済ませておけば、走行中の書き込みで消去を待たずに済む。フラッシュを操作した場合 true
+  auto eraseAhead() -> bool;
+
+  auto writtenRecords() const -> uint32_t { return writtenCount; }
+  auto erasedSectors() const -> uint32_t { return erasedCount; }
+  auto failedWrites() const -> uint32_t { return failedCount; }
+
+ private:
+  // 次の書き込み位置へ進める。セクタの終わりに達したら次のセクタ（末尾なら先頭）を消去待ちにする
+  void advance();
+
+  FlashRegion &flash;
+  PersistentState shadow = {};
+  bool dirty = false;
+  size_t writeOffset = 0;            // 次に記録を書く位置
+  bool isWriteSectorErased = false;  // writeOffset 以降がそのセクタの終わりまで消去済みか
+  uint32_t nextSequence = 1;
+  uint32_t writtenCount = 0;
+  uint32_t erasedCount = 0;
+  uint32_t failedCount = 0;
+};
+
+// ────────────────────── 実機での保存 (persistent_store_flash.cpp) ──────────────────────
+// 保存用パーティションを開いて最大値と低油圧イベントを復元し、次に書くセクタを消去しておく。
+// パーティションが無ければ保存しない
+void initPersistentStore();
+// フレームの空き時間に呼び、現在の値を RAM へ写して、変化があればフラッシュへ 1 操作だけ反映する。
+// セクタの消去は停車中（メニュー表示中か、エンジン停止中）に限る
+void servicePersistentStore(bool isMenuOpen);
+
+#endif  // PERSISTENT_STORE_H
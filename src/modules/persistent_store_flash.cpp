@@ -0,0 +1,101 @@
+#include <Arduino.h>
+#include <esp_partition.h>
+
+#include "config.h"
+#include "display.h"
+#include "low_warning.h"
+#include "persistent_store.h"
+#include "sensor.h"
+
+// ────────────────────── 内蔵フラッシュのパーティション ──────────────────────
+class PartitionFlashRegion : public FlashRegion
+{
+ public:
+  auto size() const -> size_t override { return (partition != nullptr) ? partition->size : 0; }
+  auto read(size_t offset, void *data, size_t length) -> bool override
+  {
+    return esp_partition_read(partition, offset, data, length) == ESP_OK;
+  }
+  auto write(size_t offset, const void *data, size_t length) -> bool override
+  {
+    return esp_partition_write(partition, offset, data, length) == ESP_OK;
+  }
+  auto eraseSector(size_t offset) -> bool override
+  {
+    return esp_partition_erase_range(partition, offset, STORE_SECTOR_SIZE) == ESP_OK;
+  }
+
+  const esp_partition_t *partition = nullptr;
+};
+
+static PartitionFlashRegion partitionRegion;
+static PersistentStore persistentStore(partitionRegion);
+static bool isPersistentStoreReady = false;
+static unsigned long lastPressurizedMs = 0;  // 油圧が停止判定のしきい値以上だった最後の時刻 [ms]
+
+// 油圧がしきい値未満のまま PERSISTENT_STORE_STOPPED_MS 続いていればエンジン停止中とみなす。
+// レーシングモードは横 G が小さいだけで解除され、一般道の走行中でも外れるため判定には使わない。
+// 油圧センサーが無い構成では判定できないため false
+static auto isEngineStopped(unsigned long nowMs) -> bool
+{
+  auto &oilPressure = sensorChannel<SensorChannelId::OilPressure>();
+  if (!oilPressure.SPEC.present)
+  {
+    return false;
+  }
+  if (oilPressure.isShorted() || oilPressure.estimate().toFloat() >= PERSISTENT_STORE_STOPPED_PRESSURE_BAR)
+  {
+    lastPressurizedMs = nowMs;
+  }
+  return nowMs - lastPressurizedMs >= PERSISTENT_STORE_STOPPED_MS;
+}
+
+void initPersistentStore()
+{
+#if PERSISTENT_STORE_ENABLED
+  partitionRegion.partition = esp_partition_find_first(ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_ANY,
+                                                       PERSISTENT_STORE_PARTITION);
+  if (partitionRegion.partition == nullptr || partitionRegion.size() < STORE_SECTOR_SIZE * 2)
+  {
+    Serial.printf("[Store] partition '%s' not found, max values will not be kept\n", PERSISTENT_STORE_PARTITION);
+    return;
+  }
+
+  unsigned long start = micros();
+  if (persistentStore.restore())
+  {
+    const PersistentState &state = persistentStore.state();
+    restoreRecordedMaxValues(state.maxOilPressureCbar / 100.0F, state.maxWaterTempDeci / 10.0F, state.maxOilTemp);
+    lastLowEventG = state.lowEventGMilli / 1000.0F;
+    lastLowEventDir = persistentDirectionName(state, lastLowEventDir);
+    lastLowEventDuration = state.lowEventDurationCentisec / 100.0F;
+    lastLowEventPressure = state.lowEventPressureCbar / 100.0F;
+  }
+  Serial.printf("[Store] restored in %lu us\n", micros() - start);
+  // 起動直後は走り出す前なので、次に書くセクタの消去をここで済ませておく
+  persistentStore.eraseAhead();
+  isPersistentStoreReady = true;
+#endif
+}
+
+void servicePersistentStore(bool isMenuOpen)
+{
+  if (!isPersistentStoreReady)
+  {
+    return;
+  }
+
+  float maxOilPressure = 0.0F;
+  float maxWaterTemp = 0.0F;
+  int maxOilTemp = 0;
+  recordedMaxValues(maxOilPressure, maxWaterTemp, maxOilTemp);
+  persistentStore.update(makePersistentState(maxOilPressure, maxWaterTemp, maxOilTemp, lastLowEventG, lastLowEventDir,
+                                             lastLowEventDuration, lastLowEventPressure));
+  // 消去中はキャッシュが止まり両コアの処理が数十 ms 止まるため、消去は停車中だけに行う。
+  // 走行中は消去済みのセクタへの追記だけを行い、セクタが埋まったら停車するまで RAM に保持する
+  bool isStopped = isMenuOpen || isEngineStopped(millis());
+  if (!persistentStore.service(isStopped) && isStopped)
+  {
+    persistentStore.eraseAhead();
+  }
+}
@@ -1,5 +1,8 @@
 #include "racing_indicator.h"
 
+#include "canvas_palette.h"
+#include "dirty_region.h"
+
 // レーシングモードかどうかを保持
 bool isRacingMode = false;
 
@@ -7,10 +10,13 @@ bool isRacingMode = false;
 static bool indicatorDrawn = false;
 
 // ────────────────────── レーシング中表示 ──────────────────────
-bool drawRacingIndicator(M5Canvas &canvas)
+bool drawRacingIndicator(M5Canvas &canvas, const M5Canvas *background)
 {
+  // 油圧ゲージのスプライト内の左下（メーター名の左）に置く
+  constexpr int GAUGE_H = 170;
+  constexpr int INDICATOR_SIZE = 8;
   constexpr int INDICATOR_X = 2;
-  constexpr int INDICATOR_Y = LCD_HEIGHT - 16;
+  constexpr int INDICATOR_Y = GAUGE_H - INDICATOR_SIZE;
 
   if (isRacingMode)
   {
@@ -18,18 +24,23 @@ bool drawRacingIndicator(M5Canvas &canvas)
     {
       canvas.setFont(&fonts::Font0);
       canvas.setTextSize(0);
-      canvas.setTextColor(COLOR_RED, COLOR_BLACK);
+      canvas.setTextColor(canvasColor(COLOR_RED), canvasColor(COLOR_BLACK));
       canvas.setCursor(INDICATOR_X, INDICATOR_Y);
       canvas.print("R");
+      frameDirtyRegions.markRect(INDICATOR_X, INDICATOR_Y, INDICATOR_SIZE, INDICATOR_SIZE);
       indicatorDrawn = true;
       return true;
     }
   }
   else if (indicatorDrawn)
   {
-    canvas.fillRect(INDICATOR_X, INDICATOR_Y, 8, 8, COLOR_BLACK);
+    restoreCanvasRect(canvas, background, INDICATOR_X, INDICATOR_Y, INDICATOR_SIZE, INDICATOR_SIZE,
+                      canvasColor(COLOR_BLACK));
+    frameDirtyRegions.markRect(INDICATOR_X, INDICATOR_Y, INDICATOR_SIZE, INDICATOR_SIZE);
     indicatorDrawn = false;
     return true;
   }
   return false;
 }
+
+void resetRacingIndicator() { indicatorDrawn = false; }
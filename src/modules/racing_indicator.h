@@ -8,6 +8,9 @@
 // 現在レーシングモードかどうか
 extern bool isRacingMode;
 
-// レーシング中表示を描画。描画の更新があれば true を返す
-bool drawRacingIndicator(M5Canvas &canvas);
+// レーシング中表示を油圧ゲージのスプライトへ描画。消去は background（背景レイヤー）からの複写で行う。
+// 描画の更新があれば true を返す
+bool drawRacingIndicator(M5Canvas &canvas, const M5Canvas *background = nullptr);
+// ゲージを描き直すときに呼び、次の呼び出しで表示を描き直させる
+void resetRacingIndicator();
 #endif  // RACING_INDICATOR_H
@@ -1,242 +1,341 @@
 #include "sensor.h"
 
+#include <Adafruit_ADS1X15.h>
 #include <M5CoreS3.h>
 #include <Wire.h>
 
 #include <algorithm>
 #include <cmath>
 #include <numeric>
+#include <tuple>
+#include <type_traits>
+#include <utility>
 
-// ────────────────────── グローバル変数 ──────────────────────
-Adafruit_ADS1015 adsConverter;
+#include "adc_scheduler.h"
+#include "frame_profiler.h"
+#include "imu_batch.h"
+#include "sensor_conversion.h"
+#include "session_log.h"
+#include "spsc_ring.h"
 
-float oilPressureSamples[PRESSURE_SAMPLE_SIZE] = {};
-float waterTemperatureSamples[WATER_TEMP_SAMPLE_SIZE] = {};
-float oilTemperatureSamples[OIL_TEMP_SAMPLE_SIZE] = {};
-bool oilPressureOverVoltage = false;
+// ────────────────────── グローバル変数 ──────────────────────
+SensorChannelBank sensorChannels;
 float currentGForce = 0.0F;
+float currentGForcePeak = 0.0F;
 const char *currentGDirection = "Right";
-static int oilPressureIndex = 0;
-static int waterTempIndex = 0;
-static int oilTempIndex = 0;
-
-// 最初の水温・油温取得かどうかのフラグ
-static bool isFirstWaterTempSample = true;
-static bool isFirstOilTempSample = true;
-
-// ADC セトリング待ち時間 [us]
-constexpr int ADC_SETTLING_US = 50;
-
-// 温度サンプリング間隔 [ms]
-// 500msごとに取得し、10サンプルで約5秒平均となる
-constexpr int TEMP_SAMPLE_INTERVAL_MS = 500;
-constexpr float SUPPLY_VOLTAGE = 5.0f;
-// 電圧降下は config で設定
-constexpr float CORRECTION_FACTOR = SUPPLY_VOLTAGE / (SUPPLY_VOLTAGE - VOLTAGE_DROP);
-constexpr float THERMISTOR_R25 = 10000.0f;
-constexpr float THERMISTOR_B_CONSTANT = 3380.0f;
-constexpr float ABSOLUTE_TEMPERATURE_25 = 298.16f;  // 273.16 + 25
-constexpr float SERIES_REFERENCE_RES = 10000.0f;
-
-// ────────────────────── ユーティリティ ──────────────────────
-static auto convertAdcToVoltage(int16_t rawAdc) -> float { return (rawAdc * 6.144F) / 2047.0F; }
-
-static auto convertVoltageToOilPressure(float voltage) -> float
+uint32_t lastSensorSampleMs = 0;
+
+// ────────────────────── ADC 読み取り ──────────────────────
+// ADS1x15 の単発変換をノンブロッキングで扱うアダプタ。ドライバは変換器の種類ごとに選ぶ
+template <AdcChip Chip>
+class Ads1x15Device : public AdcDevice
 {
-  // 4.9V 以上はショートエラーとみなし 0 扱い
-  if (voltage >= 4.9F)
+ public:
+  using Driver = std::conditional_t<Chip == AdcChip::Ads1115, Adafruit_ADS1115, Adafruit_ADS1015>;
+
+  auto begin(uint8_t address) -> bool
+  {
+    if (!driver.begin(address))
+    {
+      return false;
+    }
+    driver.setDataRate((Chip == AdcChip::Ads1115) ? RATE_ADS1115_860SPS : RATE_ADS1015_1600SPS);
+    return true;
+  }
+
+  void startConversion(uint8_t channel) override
+  {
+    static constexpr uint16_t MUX_BY_CHANNEL[ADC_CHANNEL_COUNT] = {
+        ADS1X15_REG_CONFIG_MUX_SINGLE_0, ADS1X15_REG_CONFIG_MUX_SINGLE_1, ADS1X15_REG_CONFIG_MUX_SINGLE_2,
+        ADS1X15_REG_CONFIG_MUX_SINGLE_3};
+    driver.startADCReading(MUX_BY_CHANNEL[channel], false);
+  }
+  auto isConversionReady() -> bool override { return driver.conversionComplete(); }
+  // 変換表は ADS1015 の 12bit コードで作っているため、ADS1115 の 16bit 値は下位 4bit を落として揃える
+  auto readConversionResult() -> int16_t override
+  {
+    int16_t raw = driver.getLastConversionResults();
+    return (Chip == AdcChip::Ads1115) ? static_cast<int16_t>(raw >> 4) : raw;
+  }
+  // データシートの変換時間から内部発振器の誤差 (10%) を引いた値
+  auto minConversionUs() const -> unsigned long override
   {
-    return 0.0F;
+    return (Chip == AdcChip::Ads1115) ? (1000000UL / 860) * 9 / 10 : (1000000UL / 1600) * 9 / 10;
   }
 
-  voltage *= CORRECTION_FACTOR;
-  // 電源電圧近くまで上昇してもそのまま変換し、
-  // 12bar 以上かどうかは呼び出し側で判断する
+ private:
+  Driver driver;
+};
 
-  // センサー実測式に基づき圧力へ変換
-  return (voltage > 0.5F) ? 2.5F * (voltage - 0.5F) : 0.0F;
-}
+// config.h の ADC_CONVERTERS に並べた変換器をまとめて持つ
+template <typename Sequence>
+class AdsConverterSet;
 
-static auto convertVoltageToTemp(float voltage) -> float
+template <size_t... Is>
+class AdsConverterSet<std::index_sequence<Is...>>
 {
-  voltage *= CORRECTION_FACTOR;
-  // 電源電圧より高い/等しい電圧は異常値として捨てる
-  if (voltage <= 0.0F || voltage >= SUPPLY_VOLTAGE)
+ public:
+  // 全変換器を初期化して bank へ接続する。応答しない変換器も接続し、変換待ちの打ち切りで読み飛ばす
+  auto begin(AdcBank &bank, AdcBank::MicrosFn microsFn) -> bool
   {
-    return 200.0F;
+    bool isAllFound = true;
+    ((isAllFound &= beginOne<Is>(bank, microsFn)), ...);
+    return isAllFound;
   }
 
-  // 分圧式よりサーミスタ抵抗値を算出
-  // R = Rref * (V / (Vcc - V))  (サーミスタがGND側の場合)
-  float resistance = SERIES_REFERENCE_RES * (voltage / (SUPPLY_VOLTAGE - voltage));
+ private:
+  template <size_t I>
+  auto beginOne(AdcBank &bank, AdcBank::MicrosFn microsFn) -> bool
+  {
+    bool isFound = std::get<I>(devices).begin(ADC_CONVERTERS[I].address);
+    if (!isFound)
+    {
+      Serial.printf("[ADS1x15] no response at 0x%02X\n", ADC_CONVERTERS[I].address);
+    }
+    bank.attach(I, std::get<I>(devices), microsFn);
+    return isFound;
+  }
+
+  std::tuple<Ads1x15Device<ADC_CONVERTERS[Is].chip>...> devices;
+};
+
+static AdsConverterSet<std::make_index_sequence<ADC_CONVERTER_COUNT>> adsConverters;
+static AdcBank adcBank;
 
-  // Steinhart–Hart の簡易形 (β式)
-  float kelvin =
-      THERMISTOR_B_CONSTANT / (log(resistance / THERMISTOR_R25) + THERMISTOR_B_CONSTANT / ABSOLUTE_TEMPERATURE_25);
+// ────────────────────── コア間の受け渡し ──────────────────────
+// 取得側だけが push し、描画側だけが pop する
+static SpscRing<SensorSample, SENSOR_QUEUE_CAPACITY> sensorQueue;
+// 内部 I2C (IMU/タッチ/ALS/PMIC) を両コアから同時に使わないためのミューテックス
+static SemaphoreHandle_t internalI2cMutex = nullptr;
 
-  return std::isnan(kelvin) ? 200.0F : kelvin - 273.16F;
+void lockInternalI2c()
+{
+  if (internalI2cMutex != nullptr)
+  {
+    xSemaphoreTake(internalI2cMutex, portMAX_DELAY);
+  }
 }
 
-// ────────────────────── ADC 読み取り ──────────────────────
-static auto readAdcWithSettling(uint8_t ch) -> int16_t
+void unlockInternalI2c()
 {
-  adsConverter.readADC_SingleEnded(ch);  // ダミー変換
-  delayMicroseconds(ADC_SETTLING_US);    // セトリング待ち
-  return adsConverter.readADC_SingleEnded(ch);
+  if (internalI2cMutex != nullptr)
+  {
+    xSemaphoreGive(internalI2cMutex);
+  }
 }
 
-// ────────────────────── 温度読み取り ──────────────────────
-// 指定チャンネルから温度を取得して摂氏に変換
-static auto readTemperatureChannel(uint8_t ch) -> float
+// ────────────────────── IMU FIFO (BMI270) ──────────────────────
+// 加速度を高い出力レートで FIFO に溜め、取得ごとに 1 回のバースト読み出しでまとめて回収する
+namespace bmi270
 {
-  int16_t raw = readAdcWithSettling(ch);
-  return convertVoltageToTemp(convertAdcToVoltage(raw));
+constexpr uint8_t I2C_ADDRESS = 0x69;
+constexpr uint32_t I2C_FREQUENCY = 400000;
+constexpr uint8_t REG_FIFO_LENGTH_0 = 0x24;  // FIFO のバイト数（下位、上位 6bit は次のレジスタ）
+constexpr uint8_t REG_FIFO_DATA = 0x26;
+constexpr uint8_t REG_ACC_CONF = 0x40;
+constexpr uint8_t REG_ACC_RANGE = 0x41;
+constexpr uint8_t REG_FIFO_CONFIG_1 = 0x49;
+constexpr uint8_t REG_CMD = 0x7E;
+// ODR 800Hz・内部フィルタ通常・高性能モード
+constexpr uint8_t ACC_CONF_800HZ = 0xAB;
+// 加速度のみ・ヘッダなし
+constexpr uint8_t FIFO_ACC_HEADERLESS = 0x40;
+constexpr uint8_t CMD_FIFO_FLUSH = 0xB0;
+}  // namespace bmi270
+
+static bool isImuFifoEnabled = false;
+static float imuAccelScale = 0.0F;  // 1LSB あたりの G
+
+void initImuFifo()
+{
+  if (M5.Imu.getType() != m5::imu_t::imu_bmi270)
+  {
+    // BMI270 以外は従来どおりデータレジスタを 1 回ずつ読む
+    return;
+  }
+  auto &bus = M5.In_I2C;
+  bus.writeRegister8(bmi270::I2C_ADDRESS, bmi270::REG_ACC_CONF, bmi270::ACC_CONF_800HZ, bmi270::I2C_FREQUENCY);
+  // 測定レンジは M5Unified の設定を引き継ぐ (0:±2G 1:±4G 2:±8G 3:±16G)
+  uint8_t range = bus.readRegister8(bmi270::I2C_ADDRESS, bmi270::REG_ACC_RANGE, bmi270::I2C_FREQUENCY) & 0x03;
+  imuAccelScale = static_cast<float>(2 << range) / 32768.0F;
+  bus.writeRegister8(bmi270::I2C_ADDRESS, bmi270::REG_FIFO_CONFIG_1, bmi270::FIFO_ACC_HEADERLESS,
+                     bmi270::I2C_FREQUENCY);
+  bus.writeRegister8(bmi270::I2C_ADDRESS, bmi270::REG_CMD, bmi270::CMD_FIFO_FLUSH, bmi270::I2C_FREQUENCY);
+  isImuFifoEnabled = true;
 }
 
-// ────────────────────── サンプルバッファ更新 ──────────────────────
-// 初回は全要素を同じ値で埋め、その後はリングバッファ更新
-template <size_t N>
-static void updateSampleBuffer(float value, float (&buffer)[N], int &index, bool &first)
+// FIFO に溜まった加速度を読み出す。FIFO が使えない場合は現在値を 1 サンプルだけ返す
+static auto readImuBatch(AccelSample *samples, size_t maxSamples) -> size_t
 {
-  if (first)
+  lockInternalI2c();
+  size_t count = 0;
+  if (isImuFifoEnabled)
   {
-    for (float &v : buffer)
+    auto &bus = M5.In_I2C;
+    uint8_t lengthBytes[2] = {};
+    bus.readRegister(bmi270::I2C_ADDRESS, bmi270::REG_FIFO_LENGTH_0, lengthBytes, sizeof(lengthBytes),
+                     bmi270::I2C_FREQUENCY);
+    size_t length = lengthBytes[0] | ((lengthBytes[1] & 0x3F) << 8);
+    // フレーム単位に切り捨て、読み切れない分は次回へ残す
+    length = std::min(length / IMU_FIFO_FRAME_BYTES, maxSamples) * IMU_FIFO_FRAME_BYTES;
+    uint8_t data[IMU_BATCH_MAX_SAMPLES * IMU_FIFO_FRAME_BYTES];
+    if (length > 0 && bus.readRegister(bmi270::I2C_ADDRESS, bmi270::REG_FIFO_DATA, data, length,
+                                       bmi270::I2C_FREQUENCY))
     {
-      v = value;
+      count = parseAccelFifo(data, length, imuAccelScale, samples, maxSamples);
     }
-    // 初期化直後は最初の要素から更新を再開する
-    index = 0;
-    first = false;
   }
-  else
+  else if (maxSamples > 0)
   {
-    buffer[index] = value;
-    index = (index + 1) % N;
+    M5.Imu.getAccelData(&samples[0].x, &samples[0].y, &samples[0].z);
+    count = 1;
   }
+  unlockInternalI2c();
+  return count;
 }
 
-// ────────────────────── センサ取得 ──────────────────────
-void acquireSensorData()
+// ────────────────────── 入力の差し替え ──────────────────────
+// 取得処理が参照する時計と加速度。トレース再生時は setSensorInputs() で差し替える
+static SensorClockFn sensorMillis = millis;
+static SensorAccelFn sensorAccel = readImuBatch;
+static GForceFilter gForceFilter(G_FILTER_CUTOFF_HZ, IMU_FIFO_ODR_HZ);
+// 定常の 1 回分の数倍を読み切れること。足りない分は FIFO に残り次回へ回る
+static_assert(IMU_BATCH_MAX_SAMPLES >= 4 * static_cast<size_t>(IMU_FIFO_ODR_HZ * SENSOR_TASK_INTERVAL_MS / 1000.0F),
+              "IMU_BATCH_MAX_SAMPLES は取得周期の 4 回分以上");
+
+void setSensorInputs(SensorClockFn millisFn, SensorClockFn microsFn, SensorAccelFn accelFn, float accelRateHz,
+                     AdcDevice &adc)
 {
-  static unsigned long lastWaterTempSampleTime = 0;
-  static unsigned long lastOilTempSampleTime = 0;
-
-  // デモモード用の変数
-  // デモ用電圧とシーケンス管理変数
-  static float demoVoltage = 0.0F;    // 現在のデモ電圧
-  static unsigned long demoTick = 0;  // 更新タイマ
-  static bool inPattern = false;      // 0→5V上昇後のパターンフェーズか
-  static size_t patternIndex = 0;     // パターンインデックス
-  // デモモードでの電圧変化パターン
-  // 5V到達後に 5,0,5,4,3,2,1,0,1,2,3,4,5,0,0,2.5 と0.5秒ごとに変化させる
-  constexpr float patternSeq[] = {5.0F, 0.0F, 5.0F, 4.0F, 3.0F, 2.0F, 1.0F, 0.0F,
-                                  1.0F, 2.0F, 3.0F, 4.0F, 5.0F, 0.0F, 0.0F, 2.5F};
-
-  unsigned long now = millis();
+  sensorMillis = millisFn;
+  sensorAccel = accelFn;
+  gForceFilter.configure(G_FILTER_CUTOFF_HZ, accelRateHz);
+  adcBank.attach(ADC_DEVICE_MAIN, adc, microsFn);
+}
 
-  // IMU から加速度を取得
-  float ax = 0.0F, ay = 0.0F, az = 0.0F;
-  M5.Imu.getAccelData(&ax, &ay, &az);
+// ────────────────────── チャンネルごとの取得 ──────────────────────
+// 記述子はコンパイル時定数のため、チャンネルごとに分岐や間接呼び出しの無い処理へ展開される
+template <size_t I>
+static void acquireChannel(unsigned long now, SensorSample &sample)
+{
+  constexpr const SensorChannelSpec &SPEC = SENSOR_CHANNELS[I];
+  constexpr uint8_t CHANNEL_BIT = 1U << I;
 
-  // ── 起動直後は複数サンプルからオフセットを平均化 ──
-  static bool gForceOffsetInitialized = false;
-  static float axOffset = 0.0F;
-  static float ayOffset = 0.0F;
-  static float azOffset = 0.0F;
-  static int offsetSampleCount = 0;
-  static unsigned long imuSettlingStart = 0;      // IMU 初期化時刻
-  constexpr unsigned long IMU_SETTLING_MS = 200;  // IMU安定化待ち時間 [ms]
-  constexpr int verticalAxis = 2;                 // 0:X, 1:Y, 2:Z（上下G検知は無効）
-  if (!gForceOffsetInitialized)
+  bool isDue = true;
+  if constexpr (SPEC.samplePeriodMs > 0)
   {
-    // 初回呼び出し時に開始時刻を記録
-    if (imuSettlingStart == 0)
+    static unsigned long lastRequestMs = 0;
+    isDue = (now - lastRequestMs >= SPEC.samplePeriodMs);
+    if (isDue)
     {
-      imuSettlingStart = now;
+      lastRequestMs = now;
     }
+  }
 
-    // センサが安定するまで待機
-    if (now - imuSettlingStart < IMU_SETTLING_MS)
+  if constexpr (!SPEC.present)
+  {
+    // 未接続のチャンネルは取得周期ごとに 0 を報告する
+    if (isDue)
     {
-      currentGForce = 0.0F;
-      currentGDirection = "Right";
-      return;
+      sample.values[I] = 0.0F;
+      sample.freshMask |= CHANNEL_BIT;
     }
-
-    axOffset += ax;
-    ayOffset += ay;
-    azOffset += az;
-    offsetSampleCount++;
-    if (offsetSampleCount >= 20)
+  }
+  else
+  {
+    if constexpr (SPEC.samplePeriodMs > 0)
     {
-      axOffset /= offsetSampleCount;
-      ayOffset /= offsetSampleCount;
-      azOffset /= offsetSampleCount;
-      // 縦軸判定は無効化のため処理なし
-      gForceOffsetInitialized = true;
+      // 変換を要求し、結果は後続フレームで回収する
+      if (isDue)
+      {
+        adcBank.requestChannel(SPEC.adcDevice, SPEC.adcChannel);
+      }
     }
-    else
+    int16_t raw = 0;
+    if (adcBank.takeResult(SPEC.adcDevice, SPEC.adcChannel, raw))
     {
-      // オフセット確定までは 0G 扱い
-      currentGForce = 0.0F;
-      currentGDirection = "Right";
-      return;
+      // 変換はコンパイル時生成のテーブル参照のみ
+      sample.values[I] = SPEC.convert(raw);
+      sample.freshMask |= CHANNEL_BIT;
+      if (raw >= SPEC.overVoltageCode)
+      {
+        sample.shortedMask |= CHANNEL_BIT;
+      }
     }
   }
+}
 
-  float adjX = ax - axOffset;
-  float adjY = ay - ayOffset;
-  float adjZ = az - azOffset;
+template <size_t... Is>
+static void acquireChannels(unsigned long now, SensorSample &sample, std::index_sequence<Is...> /*channels*/)
+{
+  (acquireChannel<Is>(now, sample), ...);
+}
 
-  // 縦軸を除いた 2 軸のみで判定
-  int lateralAxis = 0;       // 左右成分を持つ軸
-  int longitudinalAxis = 0;  // 前後成分を持つ軸
-  if (verticalAxis == 0)
-  {
-    lateralAxis = 1;       // Y: 左右
-    longitudinalAxis = 2;  // Z: 前後
-  }
-  else if (verticalAxis == 1)
-  {
-    lateralAxis = 0;       // X: 左右
-    longitudinalAxis = 2;  // Z: 前後
-  }
-  else  // verticalAxis == 2
-  {
-    lateralAxis = 1;       // Y: 左右
-    longitudinalAxis = 0;  // X: 前後
-  }
+#if DEMO_MODE_ENABLED
+// デモ電圧を各チャンネルの変換へ通す。温度センサは電圧変化と逆の振る舞いにする
+template <size_t I>
+static void setDemoChannel(float voltage, SensorSample &sample)
+{
+  constexpr const SensorChannelSpec &SPEC = SENSOR_CHANNELS[I];
+  float channelVoltage = (SPEC.unit == SensorUnit::Celsius) ? SUPPLY_VOLTAGE - voltage : voltage;
+  auto code = static_cast<int16_t>(std::lround(channelVoltage * ADC_MAX_CODE / ADC_FULL_SCALE_VOLTAGE));
+  sample.values[I] = SPEC.convert(code);
+  sample.freshMask |= static_cast<uint8_t>(1U << I);
+}
 
-  float lat = (lateralAxis == 0) ? adjX : (lateralAxis == 1) ? adjY : adjZ;
-  float lon = (longitudinalAxis == 0) ? adjX : (longitudinalAxis == 1) ? adjY : adjZ;
-  float absLat = fabsf(lat);
-  float absLon = fabsf(lon);
+template <size_t... Is>
+static void setDemoChannels(float voltage, SensorSample &sample, std::index_sequence<Is...> /*channels*/)
+{
+  (setDemoChannel<Is>(voltage, sample), ...);
+}
+#endif
 
-  // 方向判定。許容角度 10 度以内で単独方向とする
-  constexpr float PURE_TAN = 0.17632698F;  // tan(10度)
-  currentGForce = sqrtf((lat * lat) + (lon * lon));
-  if (absLat <= absLon * PURE_TAN)
-  {
-    // 前後方向として扱う
-    currentGDirection = (lon >= 0.0F) ? "Front" : "Rear";
-  }
-  else if (absLon <= absLat * PURE_TAN)
+// ────────────────────── G センサ ──────────────────────
+static void sampleGForce(unsigned long now, SensorSample &sample)
+{
+  // 前回の取得以降に溜まった加速度をまとめて取得
+  AccelSample batch[IMU_BATCH_MAX_SAMPLES];
+  size_t count = sensorAccel(batch, IMU_BATCH_MAX_SAMPLES);
+
+  static unsigned long imuSettlingStart = 0;      // IMU 初期化時刻
+  constexpr unsigned long IMU_SETTLING_MS = 200;  // IMU安定化待ち時間 [ms]
+  // 初回呼び出し時に開始時刻を記録
+  if (imuSettlingStart == 0)
   {
-    // 左右方向として扱う
-    currentGDirection = (lat >= 0.0F) ? "Right" : "Left";
+    imuSettlingStart = now;
   }
-  else
+
+  // センサが安定するまでは読み捨てて 0G とし、その後の静止状態からオフセットを求める
+  if (!gForceFilter.isCalibrated() && now - imuSettlingStart < IMU_SETTLING_MS)
   {
-    // 斜め方向 (Front/Rear + Left/Right)
-    if (lon >= 0.0F)
-    {
-      currentGDirection = (lat >= 0.0F) ? "FR" : "FL";
-    }
-    else
-    {
-      currentGDirection = (lat >= 0.0F) ? "RR" : "RL";
-    }
+    count = 0;
   }
+  GForceSummary summary = gForceFilter.processBatch(batch, count);
+  sample.gForce = summary.mean;
+  sample.gForcePeak = summary.peak;
+  sample.gDirection = summary.direction;
+  sample.gSampleCount = summary.count;
+}
+
+// ────────────────────── センサ取得 ──────────────────────
+void acquireSensorData()
+{
+  PROFILE_STAGE(Sensor);
+
+  // デモモード用の変数
+  // デモ用電圧とシーケンス管理変数
+  static float demoVoltage = 0.0F;    // 現在のデモ電圧
+  static unsigned long demoTick = 0;  // 更新タイマ
+  static bool inPattern = false;      // 0→5V上昇後のパターンフェーズか
+  static size_t patternIndex = 0;     // パターンインデックス
+  // デモモードでの電圧変化パターン
+  // 5V到達後に 5,0,5,4,3,2,1,0,1,2,3,4,5,0,0,2.5 と0.5秒ごとに変化させる
+  constexpr float patternSeq[] = {5.0F, 0.0F, 5.0F, 4.0F, 3.0F, 2.0F, 1.0F, 0.0F,
+                                  1.0F, 2.0F, 3.0F, 4.0F, 5.0F, 0.0F, 0.0F, 2.5F};
+
+  unsigned long now = sensorMillis();
+  SensorSample sample = {};
+  sample.timestampMs = now;
+  sampleGForce(now, sample);
 
   // デモモード処理
 #if DEMO_MODE_ENABLED
@@ -272,56 +371,110 @@ void acquireSensorData()
     }
   }
 
-  float demoPressure = convertVoltageToOilPressure(demoVoltage);
-  // 温度センサは電圧変化と逆の振る舞いにする
-  float demoTemp = convertVoltageToTemp(SUPPLY_VOLTAGE - demoVoltage);
+  setDemoChannels(demoVoltage, sample, std::make_index_sequence<SENSOR_CHANNEL_COUNT>());
+  Serial.printf("[DEMO] V:%.2f P:%.2f T:%.1f\n", demoVoltage, sample.value(SensorChannelId::OilPressure),
+                sample.value(SensorChannelId::WaterTemp));
 
-  oilPressureSamples[oilPressureIndex] = demoPressure;
-  updateSampleBuffer(demoTemp, waterTemperatureSamples, waterTempIndex, isFirstWaterTempSample);
-  updateSampleBuffer(demoTemp, oilTemperatureSamples, oilTempIndex, isFirstOilTempSample);
-
-  Serial.printf("[DEMO] V:%.2f P:%.2f T:%.1f\n", demoVoltage, demoPressure, demoTemp);
-
-  oilPressureIndex = (oilPressureIndex + 1) % PRESSURE_SAMPLE_SIZE;
+  sensorQueue.push(sample);
   return;
 #endif
 
   // ── 通常センサ読み取り ──
-#if SENSOR_OIL_PRESSURE_PRESENT
-  int16_t rawAdc = readAdcWithSettling(ADC_CH_OIL_PRESSURE);  // CH1: 油圧
-  float voltage = convertAdcToVoltage(rawAdc);
-  oilPressureOverVoltage = voltage >= 4.9F;
-  float pressureValue = oilPressureOverVoltage ? 0.0F : convertVoltageToOilPressure(voltage);
-  oilPressureSamples[oilPressureIndex] = pressureValue;
-#else
-  oilPressureSamples[oilPressureIndex] = 0.0F;
-  oilPressureOverVoltage = false;
-#endif
-  oilPressureIndex = (oilPressureIndex + 1) % PRESSURE_SAMPLE_SIZE;
+  // 前フレームで開始した変換を全変換器から回収し、次の変換を開始する（待ち時間なし）
+  adcBank.poll();
+  acquireChannels(now, sample, std::make_index_sequence<SENSOR_CHANNEL_COUNT>());
+
+  sensorQueue.push(sample);
+}
 
-  // 水温
-  if (now - lastWaterTempSampleTime >= TEMP_SAMPLE_INTERVAL_MS)
+// ────────────────────── ADC スケジューラ ──────────────────────
+auto initAdcConverters() -> bool { return adsConverters.begin(adcBank, micros); }
+
+void initAdcScheduler()
+{
+  // 毎フレーム必要なチャンネル（油圧）は常時変換し、他は要求時のみ割り込ませる
+  for (uint8_t device = 0; device < adcBank.deviceCount(); ++device)
   {
-    float value;
-#if SENSOR_WATER_TEMP_PRESENT
-    value = readTemperatureChannel(ADC_CH_WATER_TEMP);
-#else
-    value = 0.0f;
+    adcBank.setHomeChannel(device, sensorHomeAdcChannel(device));
+  }
+}
+
+void serviceAdcScheduler()
+{
+  // 別コアで取得している場合は取得タスクが ADC を専有する
+#if !DEMO_MODE_ENABLED && !DUAL_CORE_ACQUISITION_ENABLED
+  adcBank.poll();
 #endif
-    updateSampleBuffer(value, waterTemperatureSamples, waterTempIndex, isFirstWaterTempSample);
-    lastWaterTempSampleTime = now;
+}
+
+auto consumeAdcBusTimeUs() -> unsigned long { return adcBank.consumeBusTimeUs(); }
+
+// ────────────────────── 取得タスク ──────────────────────
+static void sensorTask(void * /*param*/)
+{
+  TickType_t lastWakeTime = xTaskGetTickCount();
+  for (;;)
+  {
+    acquireSensorData();
+    vTaskDelayUntil(&lastWakeTime, pdMS_TO_TICKS(SENSOR_TASK_INTERVAL_MS));
+  }
+}
+
+void startSensorTask()
+{
+  internalI2cMutex = xSemaphoreCreateMutex();
+  xTaskCreatePinnedToCore(sensorTask, "sensor", SENSOR_TASK_STACK_SIZE, nullptr, SENSOR_TASK_PRIORITY, nullptr,
+                          SENSOR_TASK_CORE);
+}
+
+auto sensorQueueDropCount() -> size_t { return sensorQueue.dropped(); }
+
+// ────────────────────── 描画側への反映 ──────────────────────
+// 描画ループが参照する値は描画コアだけが書き換える
+static void applySensorSample(const SensorSample &sample)
+{
+  lastSensorSampleMs = sample.timestampMs;
+  sensorChannels.forEach(
+      [&sample](auto &channel)
+      {
+        SensorChannelId id = channel.SPEC.id;
+        if (sample.isFresh(id))
+        {
+          channel.apply(sample.value(id), sample.isShorted(id));
+        }
+      });
+}
+
+void drainSensorSamples()
+{
+  // フレーム内に届いた加速度全体の平均と最大を求める
+  float gSum = 0.0F;
+  uint32_t gCount = 0;
+  float gPeak = 0.0F;
+  const char *gPeakDirection = currentGDirection;
+
+  SensorSample sample;
+  while (sensorQueue.pop(sample))
+  {
+    applySensorSample(sample);
+    recordSensorSample(sample);
+    if (sample.gSampleCount > 0)
+    {
+      gSum += sample.gForce * sample.gSampleCount;
+      gCount += sample.gSampleCount;
+      if (sample.gForcePeak >= gPeak)
+      {
+        gPeak = sample.gForcePeak;
+        gPeakDirection = sample.gDirection;
+      }
+    }
   }
 
-  // 油温
-  if (now - lastOilTempSampleTime >= TEMP_SAMPLE_INTERVAL_MS)
+  // 加速度が届かなかったフレームは前回の値を維持する
+  if (gCount > 0)
   {
-    float value;
-#if SENSOR_OIL_TEMP_PRESENT
-    value = readTemperatureChannel(ADC_CH_OIL_TEMP);
-#else
-    value = 0.0f;
-#endif
-    updateSampleBuffer(value, oilTemperatureSamples, oilTempIndex, isFirstOilTempSample);
-    lastOilTempSampleTime = now;
+    currentGForce = gSum / static_cast<float>(gCount);
+    currentGForcePeak = gPeak;
+    currentGDirection = gPeakDirection;
   }
 }
@@ -1,23 +1,74 @@
 #ifndef SENSOR_H
 #define SENSOR_H
 
-#include <Adafruit_ADS1X15.h>
-
 #include <cstddef>
 #include <cstdint>
 
 #include "config.h"
+#include "sensor_channels.h"
+
+class AdcDevice;
+struct AccelSample;
+using SensorClockFn = unsigned long (*)();
+// 前回以降に溜まった加速度を最大 maxSamples 個読み出し、読み出した数を返す
+using SensorAccelFn = size_t (*)(AccelSample *samples, size_t maxSamples);
+
+// 取得タスクから描画ループへ渡す 1 回分の測定値
+struct SensorSample
+{
+  uint32_t timestampMs;                // 取得時刻 [ms]
+  float gForce;                        // 水平加速度の平均 [G]
+  float gForcePeak;                    // 水平加速度の最大 [G]
+  const char *gDirection;              // 最大時の加速度の向き（文字列リテラル）
+  uint16_t gSampleCount;               // 平均・最大を求めた加速度のサンプル数
+  float values[SENSOR_CHANNEL_COUNT];  // チャンネルごとの工学値（SENSOR_CHANNELS の順）
+  uint8_t freshMask;                   // 今回取得したチャンネルのビット
+  uint8_t shortedMask;                 // 過電圧（ショート）を検出したチャンネルのビット
 
-extern Adafruit_ADS1015 adsConverter;
+  auto isFresh(SensorChannelId id) const -> bool { return (freshMask & (1U << sensorChannelIndex(id))) != 0; }
+  auto isShorted(SensorChannelId id) const -> bool { return (shortedMask & (1U << sensorChannelIndex(id))) != 0; }
+  auto value(SensorChannelId id) const -> float { return values[sensorChannelIndex(id)]; }
+};
+
+// 描画側で平均・平滑化するチャンネルごとの値
+extern SensorChannelBank sensorChannels;
+template <SensorChannelId Id>
+inline auto sensorChannel() -> SensorChannelState<sensorChannelIndex(Id)> &
+{
+  return sensorChannels.get<Id>();
+}
 
-extern float oilPressureSamples[PRESSURE_SAMPLE_SIZE];
-extern float waterTemperatureSamples[WATER_TEMP_SAMPLE_SIZE];
-extern float oilTemperatureSamples[OIL_TEMP_SAMPLE_SIZE];
-extern bool oilPressureOverVoltage;
-extern float currentGForce;            // 起動時からの水平加速度変化 [G]
-extern const char *currentGDirection;  // 現在の加速度の向き (FR/RR/FL/RL, Front, Rear など)
+extern float currentGForce;            // 起動時からの水平加速度変化。直近フレームの平均 [G]
+extern float currentGForcePeak;        // 直近フレームの水平加速度の最大 [G]
+extern const char *currentGDirection;  // 最大時の加速度の向き (FR/RR/FL/RL, Front, Rear など)
+extern uint32_t lastSensorSampleMs;    // 最後に反映したサンプルの取得時刻 [ms]
+// 上記の値は描画ループ側が drainSensorSamples() でのみ更新する
 
+// センサーを 1 回読み取り、結果をキューへ積む
 void acquireSensorData();
+// 取得処理の時計・加速度・ADC を差し替える（トレース再生用。既定は millis/micros・IMU FIFO・ADS1015）。
+// accelRateHz は加速度のサンプリング周波数で、ローパスフィルタの係数に使う
+void setSensorInputs(SensorClockFn millisFn, SensorClockFn microsFn, SensorAccelFn accelFn, float accelRateHz,
+                     AdcDevice &adc);
+// IMU の FIFO を設定する（M5.Imu.begin() の後に呼ぶ）
+void initImuFifo();
+// 取得タスクを別コアで起動する（センサー初期化後に呼ぶ）
+void startSensorTask();
+// キューに溜まったサンプルを描画用の値へ反映する（描画ループから呼ぶ）
+void drainSensorSamples();
+// キューが満杯で捨てたサンプル数
+auto sensorQueueDropCount() -> size_t;
+// 内部 I2C を使う処理の前後で呼ぶ（タスク起動前は何もしない）
+void lockInternalI2c();
+void unlockInternalI2c();
+// ADC_CONVERTERS の ADS1x15 を外部 I2C (Wire) 上で初期化する。全台が応答すれば true
+auto initAdcConverters() -> bool;
+// ADC スケジューラを初期化する（initAdcConverters() の後に呼ぶ）
+void initAdcScheduler();
+// 描画後などの空き時間に ADC 変換の回収と次の開始を行う
+void serviceAdcScheduler();
+// 前回取得以降に ADC の I2C 通信へ費やした時間 [us]
+auto consumeAdcBusTimeUs() -> unsigned long;
 
 // 平均計算テンプレート
 template <size_t N>
@@ -0,0 +1,310 @@
+#ifndef SENSOR_CHANNELS_H
+#define SENSOR_CHANNELS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <tuple>
+#include <utility>
+
+#include "adc_scheduler.h"
+#include "config.h"
+#include "fixed_point.h"
+#include "level_kalman.h"
+#include "sensor_conversion.h"
+
+// ────────────────────── チャンネル定義 ──────────────────────
+// ADS1015 に接続したセンサーの一覧。表の順序と一致させる
+enum class SensorChannelId : uint8_t
+{
+  OilPressure,
+  WaterTemp,
+  OilTemp,
+};
+
+enum class SensorUnit : uint8_t
+{
+  Bar,
+  Celsius,
+};
+
+// 取得値から表示値を推定する方法
+enum class SensorFilter : uint8_t
+{
+  AverageEma,  // 取得ごとの移動平均と、描画ごとの EMA の 2 段
+  Kalman,      // 取得ごとの 1 次元カルマンフィルタ 1 段（表示側では平滑化しない）
+};
+
+using AdcConvertFn = float (*)(int16_t rawAdc);
+
+// 過電圧判定を行わないチャンネルの値
+constexpr int16_t NO_OVER_VOLTAGE_CODE = INT16_MAX;
+
+// 1 チャンネル分の記述子。取得・平均・異常判定・平滑化はすべてここから決まる
+struct SensorChannelSpec
+{
+  SensorChannelId id;
+  const char *label;        // シリアル出力用の名前
+  SensorUnit unit;          // 工学値の単位
+  bool present;             // 接続されているか（false なら常に 0 を報告する）
+  uint8_t adcDevice;        // ADC_CONVERTERS の番号
+  uint8_t adcChannel;       // 変換器の入力番号
+  AdcConvertFn convert;     // ADC コードから工学値への変換（コンパイル時生成のテーブル参照）
+  uint32_t samplePeriodMs;  // 変換を要求する間隔 [ms]。0 は常時変換（ホームチャンネル）
+  SensorFilter filter;      // 推定方法
+  size_t windowSize;        // 移動平均のサンプル数 (AverageEma)
+  int fractionBits;         // 平均・平滑化に使う固定小数点の小数部ビット数
+  float displayMax;         // 表示の上限
+  float faultThreshold;     // 平均がこれ以上なら異常として 0 表示
+  int16_t overVoltageCode;  // 生コードがこれ以上ならショートとして 0 表示
+  float smoothingAlpha;     // 表示の平滑化係数 (AverageEma)
+  float noiseSigma;         // 測定雑音の標準偏差 (Kalman)
+  float driftPerSqrtS;      // 真値のゆらぎ [単位/√s] (Kalman)
+};
+
+// センサーを追加するときは SensorChannelId と、この表に 1 行ずつ加える。これで済むのは取得から描画側の推定値までで、
+// 変換の要求と回収 (acquireChannel)・コア間の受け渡し (SensorSample)・反映 (drainSensorSamples)・推定と異常判定は
+// この表から生成される（8 チャンネルまで）。ゲージとメニューの表示、セッションログの記録 (recordSensorSample)、
+// 永続ストアの最大値はチャンネルごとに書いているため、値を見せる・残すにはそれぞれに手を入れる
+inline constexpr SensorChannelSpec SENSOR_CHANNELS[] = {
+    {SensorChannelId::OilPressure, "Oil.P", SensorUnit::Bar, SENSOR_OIL_PRESSURE_PRESENT, ADC_DEVICE_MAIN,
+     ADC_CH_OIL_PRESSURE, convertAdcToOilPressure, 0,
+     OIL_PRESSURE_ESTIMATOR_ENABLED ? SensorFilter::Kalman : SensorFilter::AverageEma, PRESSURE_SAMPLE_SIZE, 20,
+     MAX_OIL_PRESSURE_DISPLAY, 11.0F, OIL_PRESSURE_OVER_VOLTAGE_CODE, OIL_PRESSURE_SMOOTHING_ALPHA,
+     OIL_PRESSURE_NOISE_BAR, OIL_PRESSURE_DRIFT_BAR_PER_SQRT_S},
+    {SensorChannelId::WaterTemp, "Water.T", SensorUnit::Celsius, SENSOR_WATER_TEMP_PRESENT, ADC_DEVICE_MAIN,
+     ADC_CH_WATER_TEMP, convertAdcToTemp, TEMP_SAMPLE_INTERVAL_MS, SensorFilter::AverageEma, WATER_TEMP_SAMPLE_SIZE,
+     16, TEMPERATURE_SENSOR_ERROR, 199.0F, NO_OVER_VOLTAGE_CODE, TEMP_SMOOTHING_ALPHA, 0.0F, 0.0F},
+    {SensorChannelId::OilTemp, "Oil.T", SensorUnit::Celsius, SENSOR_OIL_TEMP_PRESENT, ADC_DEVICE_MAIN,
+     ADC_CH_OIL_TEMP, convertAdcToTemp, TEMP_SAMPLE_INTERVAL_MS, SensorFilter::AverageEma, OIL_TEMP_SAMPLE_SIZE, 16,
+     TEMPERATURE_SENSOR_ERROR, 199.0F, NO_OVER_VOLTAGE_CODE, TEMP_SMOOTHING_ALPHA, 0.0F, 0.0F},
+};
+
+constexpr size_t SENSOR_CHANNEL_COUNT = sizeof(SENSOR_CHANNELS) / sizeof(SENSOR_CHANNELS[0]);
+
+constexpr auto sensorChannelIndex(SensorChannelId id) -> size_t { return static_cast<size_t>(id); }
+// 取得間隔 [ms]。常時変換のチャンネルは取得タスクの周期
+constexpr auto sensorSamplePeriodMs(const SensorChannelSpec &spec) -> uint32_t
+{
+  return (spec.samplePeriodMs == 0) ? SENSOR_TASK_INTERVAL_MS : spec.samplePeriodMs;
+}
+constexpr auto sensorChannelSpec(SensorChannelId id) -> const SensorChannelSpec &
+{
+  return SENSOR_CHANNELS[sensorChannelIndex(id)];
+}
+
+// ────────────────────── 表の検証 ──────────────────────
+namespace sensor_channel_detail
+{
+constexpr auto isTableValid() -> bool
+{
+  for (size_t i = 0; i < SENSOR_CHANNEL_COUNT; ++i)
+  {
+    const SensorChannelSpec &spec = SENSOR_CHANNELS[i];
+    if (sensorChannelIndex(spec.id) != i || spec.adcDevice >= ADC_CONVERTER_COUNT ||
+        spec.adcChannel >= ADC_CHANNEL_COUNT || spec.windowSize == 0 || spec.convert == nullptr ||
+        (spec.filter == SensorFilter::Kalman && (spec.noiseSigma <= 0.0F || spec.driftPerSqrtS <= 0.0F)))
+    {
+      return false;
+    }
+    for (size_t j = 0; j < i; ++j)
+    {
+      const SensorChannelSpec &other = SENSOR_CHANNELS[j];
+      if (other.present && spec.present && other.adcDevice == spec.adcDevice && other.adcChannel == spec.adcChannel)
+      {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+constexpr auto countHomeChannels(uint8_t device) -> size_t
+{
+  size_t count = 0;
+  for (const SensorChannelSpec &spec : SENSOR_CHANNELS)
+  {
+    count += (spec.present && spec.adcDevice == device && spec.samplePeriodMs == 0) ? 1 : 0;
+  }
+  return count;
+}
+
+constexpr auto isHomeChannelUnique() -> bool
+{
+  for (uint8_t device = 0; device < ADC_CONVERTER_COUNT; ++device)
+  {
+    if (countHomeChannels(device) > 1)
+    {
+      return false;
+    }
+  }
+  return true;
+}
+}  // namespace sensor_channel_detail
+
+static_assert(ADC_CONVERTER_COUNT > 0 && ADC_CONVERTER_COUNT <= ADC_MAX_DEVICES, "変換器は 1〜4 台");
+static_assert(sensor_channel_detail::isTableValid(), "ID は表の順序と一致させ、ADC 入力は重複させない");
+// 1 台の ADS1x15 は 1 つの変換器を切り替えて使うため、常時変換できるのは変換器ごとに 1 チャンネルまで
+static_assert(sensor_channel_detail::isHomeChannelUnique(), "常時変換は変換器ごとに 1 チャンネルまで");
+static_assert(SENSOR_CHANNEL_COUNT <= 8, "取得済みフラグは 8bit で持つ");
+
+// 指定した変換器で常時変換するチャンネルの入力番号（無ければ ADC_NO_CHANNEL）
+constexpr auto sensorHomeAdcChannel(uint8_t device) -> uint8_t
+{
+  for (const SensorChannelSpec &spec : SENSOR_CHANNELS)
+  {
+    if (spec.present && spec.adcDevice == device && spec.samplePeriodMs == 0)
+    {
+      return spec.adcChannel;
+    }
+  }
+  return ADC_NO_CHANNEL;
+}
+
+// ────────────────────── 推定段 ──────────────────────
+// カルマンフィルタのゲイン列の長さ。定常値へ収束しない設計は static_assert で弾く
+constexpr size_t SENSOR_KALMAN_GAIN_STEPS = 128;
+
+// 移動平均と表示側 EMA の 2 段
+template <size_t I, SensorFilter Filter = SENSOR_CHANNELS[I].filter>
+class SensorEstimator
+{
+  static constexpr const SensorChannelSpec &SPEC = SENSOR_CHANNELS[I];
+
+ public:
+  using Q = Fixed<SPEC.fractionBits>;
+
+  void push(Q sample) { samples.push(sample); }
+  void fill(Q sample) { samples.fill(sample); }
+  auto estimate() const -> Q { return samples.average(); }
+  auto smooth(Q target) -> Q { return smoothed.update(target); }
+  auto sample(size_t i) const -> Q { return samples[i]; }
+
+  // 定常状態の群遅延 [ms]。移動平均は取得周期、EMA は描画周期で数える
+  static constexpr auto groupDelayMs() -> float
+  {
+    return (static_cast<float>(SPEC.windowSize - 1) / 2.0F * static_cast<float>(sensorSamplePeriodMs(SPEC))) +
+           ((1.0F - SPEC.smoothingAlpha) / SPEC.smoothingAlpha * static_cast<float>(FRAME_INTERVAL_US) / 1000.0F);
+  }
+
+ private:
+  FixedMovingAverage<Q, SPEC.windowSize> samples;
+  FixedEma<Q> smoothed{Q::fromFloat(SPEC.smoothingAlpha)};
+};
+
+// 1 次元カルマンフィルタ 1 段。取得ごとに更新し、描画側ではそのまま使う
+template <size_t I>
+class SensorEstimator<I, SensorFilter::Kalman>
+{
+  static constexpr const SensorChannelSpec &SPEC = SENSOR_CHANNELS[I];
+
+ public:
+  using Q = Fixed<SPEC.fractionBits>;
+  static constexpr LevelKalmanGains<Q, SENSOR_KALMAN_GAIN_STEPS> GAINS =
+      makeLevelKalmanGains<Q, SENSOR_KALMAN_GAIN_STEPS>(SPEC.noiseSigma, SPEC.driftPerSqrtS,
+                                                        static_cast<float>(sensorSamplePeriodMs(SPEC)) / 1000.0F,
+                                                        ESTIMATOR_STEP_GATE_SIGMA);
+  static_assert(GAINS.isConverged, "ゲイン列を長くするか、ゆらぎを大きくする");
+
+  void push(Q sample) { filter.update(sample); }
+  void fill(Q sample) { filter.reset(sample); }
+  auto estimate() const -> Q { return filter.value(); }
+  auto smooth(Q target) -> Q { return target; }
+
+  // 定常状態の群遅延 [ms]。段差の検出後は累積平均に切り替わるため、これより速く追従する
+  static constexpr auto groupDelayMs() -> float
+  {
+    return GAINS.groupDelaySamples * static_cast<float>(sensorSamplePeriodMs(SPEC));
+  }
+
+ private:
+  LevelKalman<Q, SENSOR_KALMAN_GAIN_STEPS> filter{GAINS, ESTIMATOR_STEP_CONFIRM_SAMPLES};
+};
+
+// ────────────────────── チャンネルごとの描画側の状態 ──────────────────────
+// 記述子から型と配列長が決まるため、チャンネル間の分岐や間接参照は残らない
+template <size_t I>
+class SensorChannelState
+{
+ public:
+  static constexpr const SensorChannelSpec &SPEC = SENSOR_CHANNELS[I];
+  using Estimator = SensorEstimator<I>;
+  using Q = typename Estimator::Q;
+
+  // 取得値を反映する。最初の値は推定段全体を埋め、起動直後の表示が 0 から立ち上がらないようにする
+  void apply(float value, bool isShorted)
+  {
+    Q q = Q::fromFloat(value);
+    if (isFirstSample)
+    {
+      estimator.fill(q);
+      isFirstSample = false;
+    }
+    else
+    {
+      estimator.push(q);
+    }
+    shorted = isShorted;
+  }
+  // 推定値を指定の値に固定する
+  void fill(float value)
+  {
+    estimator.fill(Q::fromFloat(value));
+    isFirstSample = false;
+  }
+
+  auto estimate() const -> Q { return estimator.estimate(); }
+  auto isShorted() const -> bool { return shorted; }
+  auto sample(size_t i) const -> Q { return estimator.sample(i); }
+  static constexpr auto groupDelayMs() -> float { return Estimator::groupDelayMs(); }
+
+  // 表示の上限で制限した推定値。異常時は 0 を返し、hasFault を立てる
+  auto displayTarget(bool &hasFault) const -> Q
+  {
+    constexpr Q DISPLAY_MAX = Q::fromFloat(SPEC.displayMax);
+    constexpr Q FAULT_THRESHOLD = Q::fromFloat(SPEC.faultThreshold);
+    Q target = estimate();
+    target = (target < DISPLAY_MAX) ? target : DISPLAY_MAX;
+    hasFault = (target >= FAULT_THRESHOLD || shorted);
+    return hasFault ? Q() : target;
+  }
+  // 表示用の平滑化（推定段が 1 段のチャンネルはそのまま返す）
+  auto smooth(Q target) -> Q { return estimator.smooth(target); }
+
+ private:
+  Estimator estimator;
+  bool isFirstSample = true;
+  bool shorted = false;
+};
+
+// 全チャンネルの状態を 1 つにまとめた入れ物
+template <typename Sequence>
+class SensorChannelBankImpl;
+
+template <size_t... Is>
+class SensorChannelBankImpl<std::index_sequence<Is...>>
+{
+ public:
+  template <SensorChannelId Id>
+  auto get() -> SensorChannelState<sensorChannelIndex(Id)> &
+  {
+    return std::get<sensorChannelIndex(Id)>(states);
+  }
+  template <SensorChannelId Id>
+  auto get() const -> const SensorChannelState<sensorChannelIndex(Id)> &
+  {
+    return std::get<sensorChannelIndex(Id)>(states);
+  }
+  // 各チャンネルの状態に fn(state) を適用する（コンパイル時に展開）
+  template <typename Fn>
+  void forEach(Fn &&fn)
+  {
+    (fn(std::get<Is>(states)), ...);
+  }
+
+ private:
+  std::tuple<SensorChannelState<Is>...> states;
+};
+
+using SensorChannelBank = SensorChannelBankImpl<std::make_index_sequence<SENSOR_CHANNEL_COUNT>>;
+
+#endif  // SENSOR_CHANNELS_H
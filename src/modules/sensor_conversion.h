@@ -0,0 +1,171 @@
+#ifndef SENSOR_CONVERSION_H
+#define SENSOR_CONVERSION_H
+
+#include <cmath>
+#include <cstdint>
+
+#include "config.h"
+
+// ────────────────────── 変換定数 ──────────────────────
+constexpr float SUPPLY_VOLTAGE = 5.0f;
+// 電圧降下は config で設定
+constexpr float CORRECTION_FACTOR = SUPPLY_VOLTAGE / (SUPPLY_VOLTAGE - VOLTAGE_DROP);
+constexpr float THERMISTOR_R25 = 10000.0f;
+constexpr float THERMISTOR_B_CONSTANT = 3380.0f;
+constexpr float ABSOLUTE_TEMPERATURE_25 = 298.16f;  // 273.16 + 25
+constexpr float SERIES_REFERENCE_RES = 10000.0f;
+
+// 4.9V 以上はショートエラーとみなす
+constexpr float OIL_PRESSURE_OVER_VOLTAGE = 4.9F;
+// 温度センサー異常時に返す値
+constexpr float TEMPERATURE_SENSOR_ERROR = 200.0F;
+
+// ADS1015 (GAIN_TWOTHIRDS) のフルスケール電圧と最大コード
+constexpr float ADC_FULL_SCALE_VOLTAGE = 6.144F;
+constexpr int ADC_MAX_CODE = 2047;
+constexpr int ADC_CODE_COUNT = ADC_MAX_CODE + 1;
+
+// ────────────────────── 浮動小数点による変換 ──────────────────────
+constexpr auto convertAdcToVoltage(int16_t rawAdc) -> float { return (rawAdc * ADC_FULL_SCALE_VOLTAGE) / 2047.0F; }
+
+constexpr auto convertVoltageToOilPressure(float voltage) -> float
+{
+  // 4.9V 以上はショートエラーとみなし 0 扱い
+  if (voltage >= OIL_PRESSURE_OVER_VOLTAGE)
+  {
+    return 0.0F;
+  }
+
+  voltage *= CORRECTION_FACTOR;
+  // 電源電圧近くまで上昇してもそのまま変換し、
+  // 12bar 以上かどうかは呼び出し側で判断する
+
+  // センサー実測式に基づき圧力へ変換
+  return (voltage > 0.5F) ? 2.5F * (voltage - 0.5F) : 0.0F;
+}
+
+inline auto convertVoltageToTemp(float voltage) -> float
+{
+  voltage *= CORRECTION_FACTOR;
+  // 電源電圧より高い/等しい電圧は異常値として捨てる
+  if (voltage <= 0.0F || voltage >= SUPPLY_VOLTAGE)
+  {
+    return TEMPERATURE_SENSOR_ERROR;
+  }
+
+  // 分圧式よりサーミスタ抵抗値を算出
+  // R = Rref * (V / (Vcc - V))  (サーミスタがGND側の場合)
+  float resistance = SERIES_REFERENCE_RES * (voltage / (SUPPLY_VOLTAGE - voltage));
+
+  // Steinhart–Hart の簡易形 (β式)
+  float kelvin =
+      THERMISTOR_B_CONSTANT / (log(resistance / THERMISTOR_R25) + THERMISTOR_B_CONSTANT / ABSOLUTE_TEMPERATURE_25);
+
+  return std::isnan(kelvin) ? TEMPERATURE_SENSOR_ERROR : kelvin - 273.16F;
+}
+
+// ────────────────────── コンパイル時生成のルックアップテーブル ──────────────────────
+// ADS1015 のコードは 2048 通りしかないため、全コードの変換結果をビルド時に計算しておく
+namespace sensor_lut_detail
+{
+// constexpr で使える自然対数（2 のべき乗で [1, 2) に正規化し atanh 級数で計算）
+constexpr auto constexprLog(double x) -> double
+{
+  int exponent = 0;
+  while (x >= 2.0)
+  {
+    x /= 2.0;
+    ++exponent;
+  }
+  while (x < 1.0)
+  {
+    x *= 2.0;
+    --exponent;
+  }
+  double y = (x - 1.0) / (x + 1.0);
+  double y2 = y * y;
+  double term = y;
+  double sum = 0.0;
+  for (int n = 1; n < 40; n += 2)
+  {
+    sum += term / n;
+    term *= y2;
+  }
+  return (2.0 * sum) + (exponent * 0.69314718055994530942);
+}
+
+constexpr auto codeToTemperature(int code) -> float
+{
+  float voltage = convertAdcToVoltage(static_cast<int16_t>(code)) * CORRECTION_FACTOR;
+  if (voltage <= 0.0F || voltage >= SUPPLY_VOLTAGE)
+  {
+    return TEMPERATURE_SENSOR_ERROR;
+  }
+  float resistance = SERIES_REFERENCE_RES * (voltage / (SUPPLY_VOLTAGE - voltage));
+  double kelvin = THERMISTOR_B_CONSTANT /
+                  (constexprLog(resistance / THERMISTOR_R25) + THERMISTOR_B_CONSTANT / ABSOLUTE_TEMPERATURE_25);
+  return static_cast<float>(kelvin - 273.16);
+}
+
+constexpr auto codeToOilPressure(int code) -> float
+{
+  return convertVoltageToOilPressure(convertAdcToVoltage(static_cast<int16_t>(code)));
+}
+
+// 過電圧となる最小コード
+constexpr auto findOverVoltageCode() -> int
+{
+  int code = 0;
+  while (code < ADC_MAX_CODE && convertAdcToVoltage(static_cast<int16_t>(code)) < OIL_PRESSURE_OVER_VOLTAGE)
+  {
+    ++code;
+  }
+  return code;
+}
+}  // namespace sensor_lut_detail
+
+// ADC コードから工学値への変換表
+struct AdcLookupTable
+{
+  float values[ADC_CODE_COUNT];
+};
+
+constexpr auto buildTemperatureTable() -> AdcLookupTable
+{
+  AdcLookupTable table = {};
+  for (int code = 0; code < ADC_CODE_COUNT; ++code)
+  {
+    table.values[code] = sensor_lut_detail::codeToTemperature(code);
+  }
+  return table;
+}
+
+constexpr auto buildOilPressureTable() -> AdcLookupTable
+{
+  AdcLookupTable table = {};
+  for (int code = 0; code < ADC_CODE_COUNT; ++code)
+  {
+    table.values[code] = sensor_lut_detail::codeToOilPressure(code);
+  }
+  return table;
+}
+
+inline constexpr AdcLookupTable TEMPERATURE_LUT = buildTemperatureTable();
+inline constexpr AdcLookupTable OIL_PRESSURE_LUT = buildOilPressureTable();
+// このコード以上は油圧センサーのショートとして扱う
+inline constexpr int16_t OIL_PRESSURE_OVER_VOLTAGE_CODE = sensor_lut_detail::findOverVoltageCode();
+
+// ────────────────────── テーブル参照による変換 ──────────────────────
+// 負のコード（GND 付近のノイズ）は 0 として扱う
+inline auto clampAdcCode(int16_t rawAdc) -> int
+{
+  return (rawAdc < 0) ? 0 : (rawAdc > ADC_MAX_CODE) ? ADC_MAX_CODE : rawAdc;
+}
+
+inline auto convertAdcToTemp(int16_t rawAdc) -> float { return TEMPERATURE_LUT.values[clampAdcCode(rawAdc)]; }
+
+inline auto convertAdcToOilPressure(int16_t rawAdc) -> float { return OIL_PRESSURE_LUT.values[clampAdcCode(rawAdc)]; }
+
+inline auto isOilPressureOverVoltage(int16_t rawAdc) -> bool { return rawAdc >= OIL_PRESSURE_OVER_VOLTAGE_CODE; }
+
+#endif  // SENSOR_CONVERSION_H
@@ -0,0 +1,82 @@
+#include "sensor_trace.h"
+
+#include <cstdio>
+
+#include "imu_batch.h"
+#include "sensor.h"
+
+// ────────────────────── トレース解析 ──────────────────────
+auto parseSensorTraceLine(const char *line, SensorTraceFrame &frame) -> bool
+{
+  unsigned long timestampMs = 0;
+  int adc[ADC_CHANNEL_COUNT] = {};
+  float ax = 0.0F, ay = 0.0F, az = 0.0F;
+  int fields = sscanf(line, "%lu,%d,%d,%d,%d,%f,%f,%f", &timestampMs, &adc[0], &adc[1], &adc[2], &adc[3], &ax, &ay,
+                      &az);
+  if (fields != 8)
+  {
+    return false;
+  }
+  frame.timestampMs = static_cast<uint32_t>(timestampMs);
+  for (int ch = 0; ch < ADC_CHANNEL_COUNT; ++ch)
+  {
+    frame.adc[ch] = static_cast<int16_t>(adc[ch]);
+  }
+  frame.accelX = ax;
+  frame.accelY = ay;
+  frame.accelZ = az;
+  return true;
+}
+
+// ────────────────────── SensorTraceReplay ──────────────────────
+SensorTraceReplay::SensorTraceReplay(const SensorTraceFrame *frames, size_t frameCount)
+    : frames(frames), frameCount(frameCount), virtualUs(frames[0].timestampMs * 1000UL)
+{
+}
+
+void SensorTraceReplay::advanceUs(unsigned long us)
+{
+  virtualUs += us;
+  while (cursor + 1 < frameCount && frames[cursor + 1].timestampMs * 1000UL <= virtualUs)
+  {
+    ++cursor;
+  }
+}
+
+auto SensorTraceReplay::isFinished() const -> bool { return nowMs() > frames[frameCount - 1].timestampMs; }
+
+void SensorTraceReplay::readAccel(float *ax, float *ay, float *az) const
+{
+  *ax = frames[cursor].accelX;
+  *ay = frames[cursor].accelY;
+  *az = frames[cursor].accelZ;
+}
+
+void SensorTraceReplay::startConversion(uint8_t channel)
+{
+  convertingChannel = channel;
+  conversionDoneUs = virtualUs + CONVERSION_US;
+}
+
+// ────────────────────── 取得処理への接続 ──────────────────────
+// sensor.cpp は関数ポインタで入力を受け取るため、再生中のインスタンスを経由して呼ぶ
+static SensorTraceReplay *activeReplay = nullptr;
+
+static auto replayMillis() -> unsigned long { return activeReplay->nowMs(); }
+static auto replayMicros() -> unsigned long { return activeReplay->nowUs(); }
+// トレースは FIFO を持たないため、取得ごとに現在のフレームの値を 1 サンプル返す
+static auto replayAccel(AccelSample *samples, size_t maxSamples) -> size_t
+{
+  if (maxSamples == 0)
+  {
+    return 0;
+  }
+  activeReplay->readAccel(&samples[0].x, &samples[0].y, &samples[0].z);
+  return 1;
+}
+
+void attachSensorTraceReplay(SensorTraceReplay &replay)
+{
+  activeReplay = &replay;
+  setSensorInputs(replayMillis, replayMicros, replayAccel, 1000.0F / SENSOR_TASK_INTERVAL_MS, replay);
+}
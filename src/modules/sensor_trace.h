@@ -0,0 +1,58 @@
+#ifndef SENSOR_TRACE_H
+#define SENSOR_TRACE_H
+
+#include <cstddef>
+#include <cstdint>
+
+#include "adc_scheduler.h"
+
+// ────────────────────── 記録済みトレース ──────────────────────
+// 取得時刻ごとの ADC 生コード（全チャンネル）と IMU 加速度 [G]
+struct SensorTraceFrame
+{
+  uint32_t timestampMs;
+  int16_t adc[ADC_CHANNEL_COUNT];
+  float accelX;
+  float accelY;
+  float accelZ;
+};
+
+// "time_ms,ch0,ch1,ch2,ch3,ax,ay,az" 形式の 1 行を解析する。見出し行や不正な行は false
+auto parseSensorTraceLine(const char *line, SensorTraceFrame &frame) -> bool;
+
+// ────────────────────── トレース再生 ──────────────────────
+// 仮想時計に合わせて記録値を返す ADC 兼 IMU。時計は advanceUs() でのみ進むため実時間より速く再生できる
+class SensorTraceReplay : public AdcDevice
+{
+ public:
+  // ADS1015 (1600SPS) の 1 回の変換時間 [us]
+  static constexpr unsigned long CONVERSION_US = 700;
+
+  SensorTraceReplay(const SensorTraceFrame *frames, size_t frameCount);
+
+  // 仮想時計を進め、その時刻に有効なフレームへ移動する
+  void advanceUs(unsigned long us);
+  auto nowUs() const -> unsigned long { return virtualUs; }
+  auto nowMs() const -> unsigned long { return virtualUs / 1000UL; }
+  // 最後のフレームの時刻を過ぎたか
+  auto isFinished() const -> bool;
+
+  void readAccel(float *ax, float *ay, float *az) const;
+
+  void startConversion(uint8_t channel) override;
+  auto isConversionReady() -> bool override { return virtualUs >= conversionDoneUs; }
+  auto readConversionResult() -> int16_t override { return frames[cursor].adc[convertingChannel]; }
+
+ private:
+  const SensorTraceFrame *frames;
+  size_t frameCount;
+  size_t cursor = 0;
+  unsigned long virtualUs;
+  unsigned long conversionDoneUs = 0;
+  uint8_t convertingChannel = 0;
+};
+
+// 取得処理 (sensor.cpp) の時計・加速度・ADC をトレース再生へ切り替える
+void attachSensorTraceReplay(SensorTraceReplay &replay);
+
+#endif  // SENSOR_TRACE_H
@@ -0,0 +1,164 @@
+#include "session_log.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+// ────────────────────── レコード作成 ──────────────────────
+// 固定小数点へ丸め、型の範囲に収める
+template <typename T>
+static auto toFixed(float value, float scale) -> T
+{
+  float scaled = std::round(value * scale);
+  scaled = std::min(std::max(scaled, static_cast<float>(std::numeric_limits<T>::min())),
+                    static_cast<float>(std::numeric_limits<T>::max()));
+  return static_cast<T>(scaled);
+}
+
+static auto findDirectionCode(const char *direction) -> uint8_t
+{
+  for (uint8_t i = 0; i < LOG_G_DIRECTION_COUNT; ++i)
+  {
+    if (direction != nullptr && strcmp(direction, LOG_G_DIRECTIONS[i]) == 0)
+    {
+      return i;
+    }
+  }
+  return LOG_G_DIRECTION_COUNT;  // 不明
+}
+
+auto makeLogRecord(uint32_t timestampMs, float oilPressure, float waterTemp, float oilTemp, float gForce,
+                   const char *gDirection, uint8_t flags) -> LogRecord
+{
+  LogRecord record = {};
+  record.timestampMs = timestampMs;
+  record.oilPressureCbar = toFixed<uint16_t>(oilPressure, 100.0F);
+  record.waterTempDeci = toFixed<int16_t>(waterTemp, 10.0F);
+  record.oilTempDeci = toFixed<int16_t>(oilTemp, 10.0F);
+  record.gForceMilli = toFixed<uint16_t>(gForce, 1000.0F);
+  record.gDirection = findDirectionCode(gDirection);
+  record.flags = flags;
+  return record;
+}
+
+// ────────────────────── ブロック管理 ──────────────────────
+void SessionLogger::startBlock(LogBlock &block)
+{
+  memset(&block, 0, sizeof(block));
+  block.header.magic = LOG_BLOCK_MAGIC;
+  block.header.version = LOG_FORMAT_VERSION;
+  block.header.sequence = nextSequence++;
+}
+
+auto SessionLogger::append(const LogRecord &record) -> bool
+{
+  if (!isActiveOpen)
+  {
+    // 書き込み待ちで全ブロックが埋まっていれば、SD が追いつくまで捨てる
+    if (pendingCount == BLOCK_COUNT)
+    {
+      ++droppedCount;
+      return false;
+    }
+    activeIndex = (pendingHead + pendingCount) % BLOCK_COUNT;
+    startBlock(blocks[activeIndex]);
+    isActiveOpen = true;
+  }
+
+  LogBlock &block = blocks[activeIndex];
+  block.records[block.header.recordCount++] = record;
+  if (block.header.recordCount == LOG_RECORDS_PER_BLOCK)
+  {
+    sealActiveBlock();
+  }
+  return true;
+}
+
+void SessionLogger::sealActiveBlock()
+{
+  if (!isActiveOpen || blocks[activeIndex].header.recordCount == 0)
+  {
+    return;
+  }
+  isActiveOpen = false;
+  ++pendingCount;
+}
+
+void SessionLogger::requestSync()
+{
+  sealActiveBlock();
+  // 同期していない内容が無ければ何もしない
+  isSyncRequested = pendingCount > 0 || unsyncedBlocks > 0;
+}
+
+void SessionLogger::syncStorage()
+{
+  storage.sync();
+  ++syncedCount;
+  unsyncedBlocks = 0;
+  isSyncRequested = false;
+}
+
+auto SessionLogger::flushOneBlock() -> bool
+{
+  if (pendingCount == 0)
+  {
+    return false;
+  }
+  const LogBlock &block = blocks[pendingHead];
+  if (storage.writeBlock(reinterpret_cast<const uint8_t *>(&block), sizeof(block)))
+  {
+    ++writtenCount;
+    ++unsyncedBlocks;
+  }
+  else
+  {
+    // 書き込めなかったブロックは破棄し、後続の記録を止めない
+    ++failedCount;
+  }
+  pendingHead = (pendingHead + 1) % BLOCK_COUNT;
+  --pendingCount;
+  return true;
+}
+
+auto SessionLogger::syncIfDue() -> bool
+{
+  // FAT の更新は重いため一定ブロックごとにまとめ、同期の要求があれば対象のブロックを書き終えてから行う
+  if (!isSyncDue())
+  {
+    return false;
+  }
+  syncStorage();
+  return true;
+}
+
+// ────────────────────── デコーダ ──────────────────────
+auto decodeSessionLog(FILE *in, FILE *out) -> size_t
+{
+  fprintf(out,
+          "time_ms,oil_pressure_bar,water_temp_c,oil_temp_c,g_force,g_direction,"
+          "oil_pressure_fresh,water_temp_fresh,oil_temp_fresh,over_voltage\n");
+
+  size_t decoded = 0;
+  LogBlock block;
+  while (fread(&block, 1, sizeof(block), in) == sizeof(block))
+  {
+    if (block.header.magic != LOG_BLOCK_MAGIC || block.header.version != LOG_FORMAT_VERSION ||
+        block.header.recordCount > LOG_RECORDS_PER_BLOCK)
+    {
+      continue;
+    }
+    for (size_t i = 0; i < block.header.recordCount; ++i)
+    {
+      const LogRecord &r = block.records[i];
+      const char *direction = (r.gDirection < LOG_G_DIRECTION_COUNT) ? LOG_G_DIRECTIONS[r.gDirection] : "-";
+      fprintf(out, "%lu,%.2f,%.1f,%.1f,%.3f,%s,%d,%d,%d,%d\n", static_cast<unsigned long>(r.timestampMs),
+              r.oilPressureCbar / 100.0, r.waterTempDeci / 10.0, r.oilTempDeci / 10.0, r.gForceMilli / 1000.0,
+              direction, (r.flags & LOG_FLAG_OIL_PRESSURE) ? 1 : 0, (r.flags & LOG_FLAG_WATER_TEMP) ? 1 : 0,
+              (r.flags & LOG_FLAG_OIL_TEMP) ? 1 : 0, (r.flags & LOG_FLAG_OVER_VOLTAGE) ? 1 : 0);
+      ++decoded;
+    }
+  }
+  return decoded;
+}
@@ -0,0 +1,157 @@
+#ifndef SESSION_LOG_H
+#define SESSION_LOG_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+
+// ────────────────────── 記録フォーマット ──────────────────────
+// 1 サンプル分の固定長レコード（16 バイト、リトルエンディアン）
+struct LogRecord
+{
+  uint32_t timestampMs;      // 取得時刻 [ms]
+  uint16_t oilPressureCbar;  // 油圧 [0.01bar]
+  int16_t waterTempDeci;     // 水温 [0.1℃]
+  int16_t oilTempDeci;       // 油温 [0.1℃]
+  uint16_t gForceMilli;      // 水平加速度 [0.001G]
+  uint8_t gDirection;        // 加速度の向き（LOG_G_DIRECTIONS の添字）
+  uint8_t flags;             // LOG_FLAG_*
+  uint16_t reserved;
+};
+static_assert(sizeof(LogRecord) == 16, "LogRecord は 16 バイト固定");
+
+constexpr uint8_t LOG_FLAG_OIL_PRESSURE = 0x01;  // 油圧を今回取得した
+constexpr uint8_t LOG_FLAG_WATER_TEMP = 0x02;    // 水温を今回取得した
+constexpr uint8_t LOG_FLAG_OIL_TEMP = 0x04;      // 油温を今回取得した
+constexpr uint8_t LOG_FLAG_OVER_VOLTAGE = 0x08;  // 油圧センサー過電圧
+
+// 記録する加速度の向き。sensor.cpp が返す文字列と同じ並び
+constexpr const char *LOG_G_DIRECTIONS[] = {"Front", "Rear", "Right", "Left", "FR", "FL", "RR", "RL"};
+constexpr uint8_t LOG_G_DIRECTION_COUNT = sizeof(LOG_G_DIRECTIONS) / sizeof(LOG_G_DIRECTIONS[0]);
+
+// 512 バイト単位のブロック。SD のセクタ境界に揃えて書き込む
+struct LogBlockHeader
+{
+  uint32_t magic;        // LOG_BLOCK_MAGIC
+  uint16_t version;      // LOG_FORMAT_VERSION
+  uint16_t recordCount;  // 有効なレコード数
+  uint32_t sequence;     // 起動からの通し番号
+  uint32_t reserved;
+};
+
+constexpr uint32_t LOG_BLOCK_MAGIC = 0x474C4752;  // "RGLG"
+constexpr uint16_t LOG_FORMAT_VERSION = 1;
+constexpr size_t LOG_BLOCK_SIZE = 512;
+constexpr size_t LOG_RECORDS_PER_BLOCK = (LOG_BLOCK_SIZE - sizeof(LogBlockHeader)) / sizeof(LogRecord);
+
+struct LogBlock
+{
+  LogBlockHeader header;
+  LogRecord records[LOG_RECORDS_PER_BLOCK];
+};
+static_assert(sizeof(LogBlock) == LOG_BLOCK_SIZE, "LogBlock は 512 バイト固定");
+
+// 工学値からレコードを作成する
+auto makeLogRecord(uint32_t timestampMs, float oilPressure, float waterTemp, float oilTemp, float gForce,
+                   const char *gDirection, uint8_t flags) -> LogRecord;
+
+// ────────────────────── 保存先の抽象 ──────────────────────
+// 実機では SD カード、ホストでは通常のファイルが実装する
+class LogStorage
+{
+ public:
+  virtual ~LogStorage() = default;
+  // 1 ブロック分を書き込む
+  virtual auto writeBlock(const uint8_t *data, size_t size) -> bool = 0;
+  // 書き込んだ内容を媒体へ確定させる（電源断で失われないようにする）
+  virtual auto sync() -> bool { return true; }
+};
+
+// stdio のファイルへ書き込む実装（ホストでの検証・変換用）
+class FileLogStorage : public LogStorage
+{
+ public:
+  explicit FileLogStorage(FILE *file) : file(file) {}
+  auto writeBlock(const uint8_t *data, size_t size) -> bool override
+  {
+    return fwrite(data, 1, size, file) == size;
+  }
+  auto sync() -> bool override { return fflush(file) == 0; }
+
+ private:
+  FILE *file;
+};
+
+// ────────────────────── セッションロガー ──────────────────────
+// レコードをメモリ上のブロックへ溜め、書き込みは呼び出し側が空き時間に flushOneBlock() で行う。
+// 保存先の同期はブロックの書き込みよりずっと重いため別の操作とし、syncBlocks ブロックごと、
+// または requestSync() で要求されたときに、呼び出し側が別の空き時間に syncIfDue() で行う
+class SessionLogger
+{
+ public:
+  // 書き込み待ちにできるブロック数（SD の書き込み遅延を吸収する）
+  static constexpr int BLOCK_COUNT = 8;
+
+  explicit SessionLogger(LogStorage &storage, uint32_t syncBlocks = 64) : storage(storage), syncBlocks(syncBlocks) {}
+
+  // レコードを追加する。書き込み待ちが満杯なら捨てて false を返す
+  auto append(const LogRecord &record) -> bool;
+  // 書き込み中のブロックを途中で締め、書き込み待ちにする
+  void sealActiveBlock();
+  // 書き込み中のブロックを締め、それまでの記録をすべて書き込んだ時点で保存先を同期するよう要求する
+  void requestSync();
+  // 書き込み待ちのブロックがあるか
+  auto hasPendingBlock() const -> bool { return pendingCount > 0; }
+  // 最も古いブロックを 1 つ書き込む（同期はしない）。書き込んだ場合 true
+  auto flushOneBlock() -> bool;
+  // 同期するべきか。syncBlocks ブロック書き込んだとき、または要求された同期の対象をすべて書き込んだとき
+  auto isSyncDue() const -> bool
+  {
+    return unsyncedBlocks >= syncBlocks || (isSyncRequested && pendingCount == 0);
+  }
+  // 同期するべきなら保存先を同期する。同期した場合 true
+  auto syncIfDue() -> bool;
+
+  auto droppedRecords() const -> uint32_t { return droppedCount; }
+  auto writtenBlocks() const -> uint32_t { return writtenCount; }
+  auto failedWrites() const -> uint32_t { return failedCount; }
+  auto syncCount() const -> uint32_t { return syncedCount; }
+
+ private:
+  void startBlock(LogBlock &block);
+  void syncStorage();
+
+  LogStorage &storage;
+  uint32_t syncBlocks;
+  LogBlock blocks[BLOCK_COUNT] = {};
+  int activeIndex = 0;   // 書き込み中のブロック
+  int pendingHead = 0;   // 最も古い書き込み待ちブロック
+  int pendingCount = 0;  // 書き込み待ちのブロック数
+  bool isActiveOpen = false;
+  bool isSyncRequested = false;
+  uint32_t unsyncedBlocks = 0;  // 前回の同期以降に書き込んだブロック数
+  uint32_t nextSequence = 0;
+  uint32_t droppedCount = 0;
+  uint32_t writtenCount = 0;
+  uint32_t failedCount = 0;
+  uint32_t syncedCount = 0;
+};
+
+// ────────────────────── デコーダ ──────────────────────
+// バイナリログを CSV へ変換し、出力したレコード数を返す。壊れたブロックは読み飛ばす
+auto decodeSessionLog(FILE *in, FILE *out) -> size_t;
+
+// ────────────────────── 実機での記録 (session_log_sd.cpp) ──────────────────────
+struct SensorSample;
+// SD カードを初期化してログファイルを開く。失敗時は記録しない
+void initSessionLog();
+// 取得済みのサンプルを 1 レコードとして追加する（描画ループから呼ぶ）
+void recordSensorSample(const SensorSample &sample);
+// フレームの空き時間に呼び、書き込み待ちのブロックを 1 つだけ SD へ書き込む
+void serviceSessionLog();
+// ファイルの同期が収まる空き時間に呼び、必要ならファイルを同期する。一定時間ごとに同期を要求する
+void serviceSessionLogSync();
+// 書き込み途中のブロックも含めてファイルへ確定させる（メニューを開いたとき・レーシングモード終了時に呼ぶ）
+void syncSessionLog();
+
+#endif  // SESSION_LOG_H
@@ -0,0 +1,144 @@
+#include <M5CoreS3.h>
+#include <SD.h>
+#include <SPI.h>
+
+#include <cstdio>
+
+#include "config.h"
+#include "display.h"
+#include "sensor.h"
+#include "session_log.h"
+
+// ────────────────────── SD カードへの保存 ──────────────────────
+class SdLogStorage : public LogStorage
+{
+ public:
+  auto writeBlock(const uint8_t *data, size_t size) -> bool override { return file.write(data, size) == size; }
+  auto sync() -> bool override
+  {
+    file.flush();
+    return true;
+  }
+
+  fs::File file;
+};
+
+static SdLogStorage sdStorage;
+static SessionLogger sessionLogger(sdStorage, SESSION_LOG_SYNC_BLOCKS);
+static bool isSessionLogReady = false;
+static unsigned long lastSyncRequestMs = 0;
+
+// 温度は 500ms ごとにしか届かないため、直近の値を各レコードに含める
+static float latestWaterTemp = 0.0F;
+static float latestOilTemp = 0.0F;
+
+void initSessionLog()
+{
+#if SESSION_LOG_ENABLED
+  SPI.begin(SD_SPI_SCK_PIN, SD_SPI_MISO_PIN, SD_SPI_MOSI_PIN, SD_SPI_CS_PIN);
+  if (!SD.begin(SD_SPI_CS_PIN, SPI, SD_SPI_FREQUENCY))
+  {
+    Serial.println("[Log] SD card not found, session log disabled");
+    return;
+  }
+
+  // 既存のログを上書きしないよう空き番号のファイルを作る
+  char path[24];
+  for (int i = 0; i < 1000; ++i)
+  {
+    snprintf(path, sizeof(path), "/session_%03d.bin", i);
+    if (!SD.exists(path))
+    {
+      break;
+    }
+  }
+  sdStorage.file = SD.open(path, FILE_WRITE);
+  if (!sdStorage.file)
+  {
+    Serial.printf("[Log] failed to open %s\n", path);
+    return;
+  }
+  Serial.printf("[Log] recording to %s\n", path);
+  isSessionLogReady = true;
+#endif
+}
+
+void recordSensorSample(const SensorSample &sample)
+{
+  if (!isSessionLogReady)
+  {
+    return;
+  }
+
+  uint8_t flags = 0;
+  if (sample.isFresh(SensorChannelId::OilPressure))
+  {
+    flags |= LOG_FLAG_OIL_PRESSURE;
+  }
+  if (sample.isShorted(SensorChannelId::OilPressure))
+  {
+    flags |= LOG_FLAG_OVER_VOLTAGE;
+  }
+  if (sample.isFresh(SensorChannelId::WaterTemp))
+  {
+    latestWaterTemp = sample.value(SensorChannelId::WaterTemp);
+    flags |= LOG_FLAG_WATER_TEMP;
+  }
+  if (sample.isFresh(SensorChannelId::OilTemp))
+  {
+    latestOilTemp = sample.value(SensorChannelId::OilTemp);
+    flags |= LOG_FLAG_OIL_TEMP;
+  }
+  sessionLogger.append(makeLogRecord(sample.timestampMs, sample.value(SensorChannelId::OilPressure), latestWaterTemp,
+                                     latestOilTemp, sample.gForce, sample.gDirection, flags));
+}
+
+void serviceSessionLog()
+{
+  if (!isSessionLogReady)
+  {
+    return;
+  }
+
+  if (!sessionLogger.hasPendingBlock())
+  {
+    return;
+  }
+
+  // SD は LCD と SPI バスを共有するため、転送中のフレームを待ってから書き込む
+  waitDisplayTransfer();
+  sessionLogger.flushOneBlock();
+}
+
+void serviceSessionLogSync()
+{
+  if (!isSessionLogReady)
+  {
+    return;
+  }
+
+  // 電源断（イグニッション OFF）で失う記録を一定時間分に抑えるため、書き込み途中のブロックも定期的に確定させる
+  unsigned long now = millis();
+  if (now - lastSyncRequestMs >= SESSION_LOG_SYNC_INTERVAL_MS)
+  {
+    sessionLogger.requestSync();
+    lastSyncRequestMs = now;
+  }
+  if (!sessionLogger.isSyncDue())
+  {
+    return;
+  }
+
+  waitDisplayTransfer();
+  sessionLogger.syncIfDue();
+}
+
+void syncSessionLog()
+{
+  if (!isSessionLogReady)
+  {
+    return;
+  }
+  sessionLogger.requestSync();
+  lastSyncRequestMs = millis();
+}
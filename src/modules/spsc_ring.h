@@ -0,0 +1,65 @@
+#ifndef SPSC_RING_H
+#define SPSC_RING_H
+
+#include <atomic>
+#include <cstddef>
+
+// ────────────────────── 単一生産者・単一消費者リングバッファ ──────────────────────
+// 取得タスク（生産者）と描画ループ（消費者）の間でロックせずにデータを受け渡す。
+// 生産者は push() のみ、消費者は pop() のみを呼ぶこと。
+template <typename T, size_t Capacity>
+class SpscRing
+{
+  static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "容量は2のべき乗にする");
+
+ public:
+  // 満杯の場合は書き込まずに false を返す（古いデータを上書きしない）
+  auto push(const T &item) -> bool
+  {
+    size_t write = writeIndex.load(std::memory_order_relaxed);
+    size_t read = readIndex.load(std::memory_order_acquire);
+    if (write - read == Capacity)
+    {
+      ++droppedCount;
+      return false;
+    }
+    buffer[write & INDEX_MASK] = item;
+    // 要素の書き込みが完了してから公開する
+    writeIndex.store(write + 1, std::memory_order_release);
+    return true;
+  }
+
+  // 空の場合は false を返す
+  auto pop(T &item) -> bool
+  {
+    size_t read = readIndex.load(std::memory_order_relaxed);
+    size_t write = writeIndex.load(std::memory_order_acquire);
+    if (read == write)
+    {
+      return false;
+    }
+    item = buffer[read & INDEX_MASK];
+    // 要素を読み終えてから領域を解放する
+    readIndex.store(read + 1, std::memory_order_release);
+    return true;
+  }
+
+  // 現在の要素数（取得した瞬間の目安）
+  auto size() const -> size_t
+  {
+    return writeIndex.load(std::memory_order_acquire) - readIndex.load(std::memory_order_acquire);
+  }
+
+  // 満杯で捨てた件数（生産者側からのみ更新）
+  auto dropped() const -> size_t { return droppedCount; }
+
+ private:
+  static constexpr size_t INDEX_MASK = Capacity - 1;
+
+  T buffer[Capacity] = {};
+  std::atomic<size_t> writeIndex{0};
+  std::atomic<size_t> readIndex{0};
+  size_t droppedCount = 0;
+};
+
+#endif  // SPSC_RING_H
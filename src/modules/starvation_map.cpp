@@ -0,0 +1,172 @@
+#include "starvation_map.h"
+
+#include <cstdio>
+#include <cstring>
+
+#if defined(ARDUINO)
+#include <Arduino.h>
+#endif
+
+#include "canvas_palette.h"
+
+// 画面上の配置順（3 × 3 の中央を除く）。文字列は classifyGDirection が返すもの
+static constexpr const char *DIRECTION_LABELS[] = {"FL", "Front", "FR", "Left", "Right", "RL", "Rear", "RR"};
+static_assert(sizeof(DIRECTION_LABELS) / sizeof(DIRECTION_LABELS[0]) == StarvationHistogram::DIRECTION_BINS,
+              "向きごとにラベルを用意する");
+
+// ────────────────────── StarvationHistogram ──────────────────────
+auto StarvationHistogram::directionOf(const char *direction) -> int
+{
+  for (int i = 0; i < DIRECTION_BINS; ++i)
+  {
+    if (direction != nullptr && strcmp(direction, DIRECTION_LABELS[i]) == 0)
+    {
+      return i;
+    }
+  }
+  return -1;  // 不明
+}
+
+auto StarvationHistogram::directionLabel(int direction) -> const char * { return DIRECTION_LABELS[direction]; }
+
+auto StarvationHistogram::gBinOf(float gForce) -> int
+{
+  int bin = static_cast<int>(gForce / G_BIN_WIDTH);
+  return (bin < 0) ? 0 : (bin >= G_BINS) ? G_BINS - 1 : bin;
+}
+
+auto StarvationHistogram::pressureBinOf(float pressure) -> int
+{
+  int bin = static_cast<int>(pressure / PRESSURE_BIN_WIDTH);
+  return (bin < 0) ? 0 : (bin >= PRESSURE_BINS) ? PRESSURE_BINS - 1 : bin;
+}
+
+void StarvationHistogram::record(float gForce, const char *direction, float pressure)
+{
+  int d = directionOf(direction);
+  if (d < 0)
+  {
+    return;
+  }
+  int g = gBinOf(gForce);
+  uint32_t &cell = counts[d][g][pressureBinOf(pressure)];
+  // 32bit が溢れるほど長いセッションでは、その列の記録を止めて割合を保つ
+  if (columnTotals[d][g] == UINT32_MAX)
+  {
+    return;
+  }
+  cell++;
+  columnTotals[d][g]++;
+  sampleCount += (sampleCount < UINT32_MAX) ? 1 : 0;
+}
+
+void StarvationHistogram::reset() { *this = StarvationHistogram(); }
+
+void StarvationHistogram::formatColumn(int direction, int gBin, char *buffer, size_t size) const
+{
+  int written = snprintf(buffer, size, "%s,%.2f", DIRECTION_LABELS[direction], static_cast<double>(gBin * G_BIN_WIDTH));
+  for (int p = 0; p < PRESSURE_BINS && written > 0 && static_cast<size_t>(written) < size; ++p)
+  {
+    written += snprintf(buffer + written, size - written, ",%lu", static_cast<unsigned long>(counts[direction][gBin][p]));
+  }
+}
+
+// ────────────────────── ヒートマップ ──────────────────────
+// 割合 [0-1] を 黒 → 青 → 赤 → 黄 の色にする
+static auto heatColor(float fraction) -> uint16_t
+{
+  float f = (fraction < 0.0F) ? 0.0F : (fraction > 1.0F) ? 1.0F : fraction;
+  if (f < 1.0F / 3.0F)
+  {
+    auto t = static_cast<uint8_t>(f * 3.0F * 255.0F);
+    return canvasColor(rgb565(0, 0, t));
+  }
+  if (f < 2.0F / 3.0F)
+  {
+    auto t = static_cast<uint8_t>((f - (1.0F / 3.0F)) * 3.0F * 255.0F);
+    return canvasColor(rgb565(t, 0, static_cast<uint8_t>(255 - t)));
+  }
+  auto t = static_cast<uint8_t>((f - (2.0F / 3.0F)) * 3.0F * 255.0F);
+  return canvasColor(rgb565(255, t, 0));
+}
+
+void drawStarvationMap(M5Canvas &canvas, const StarvationHistogram &histogram, int x, int y, int w, int h)
+{
+  constexpr int LABEL_HEIGHT = 10;
+  constexpr uint16_t EMPTY_COLOR = canvasColor(rgb565(24, 24, 24));
+  const int panelW = w / 3;
+  const int panelH = h / 3;
+  const int cellW = (panelW - 4) / StarvationHistogram::G_BINS;
+  const int cellH = (panelH - LABEL_HEIGHT - 2) / StarvationHistogram::PRESSURE_BINS;
+
+  canvas.setFont(&fonts::Font0);
+  canvas.setTextColor(canvasColor(COLOR_WHITE));
+  for (int d = 0; d < StarvationHistogram::DIRECTION_BINS; ++d)
+  {
+    // 中央の枠を飛ばして並べる
+    int slot = (d < 4) ? d : d + 1;
+    int panelX = x + ((slot % 3) * panelW);
+    int panelY = y + ((slot / 3) * panelH);
+    canvas.setCursor(panelX + 2, panelY + 1);
+    canvas.print(StarvationHistogram::directionLabel(d));
+
+    int gridBottom = panelY + LABEL_HEIGHT + (cellH * StarvationHistogram::PRESSURE_BINS);
+    for (int g = 0; g < StarvationHistogram::G_BINS; ++g)
+    {
+      uint32_t columnTotal = histogram.columnTotal(d, g);
+      for (int p = 0; p < StarvationHistogram::PRESSURE_BINS; ++p)
+      {
+        uint16_t color = EMPTY_COLOR;
+        if (columnTotal > 0)
+        {
+          color = heatColor(static_cast<float>(histogram.count(d, g, p)) / static_cast<float>(columnTotal));
+        }
+        canvas.fillRect(panelX + 2 + (g * cellW), gridBottom - ((p + 1) * cellH), cellW - 1, cellH - 1, color);
+      }
+    }
+  }
+
+  // 中央の枠: 軸の説明とサンプル数
+  int centerX = x + panelW + 4;
+  int centerY = y + panelH + 4;
+  canvas.setTextColor(canvasColor(COLOR_GRAY));
+  canvas.setCursor(centerX, centerY);
+  canvas.printf("x: G 0-%.2f+", static_cast<double>((StarvationHistogram::G_BINS - 1) * StarvationHistogram::G_BIN_WIDTH));
+  canvas.setCursor(centerX, centerY + LABEL_HEIGHT);
+  canvas.printf("y: bar 0-%d+",
+                static_cast<int>((StarvationHistogram::PRESSURE_BINS - 1) * StarvationHistogram::PRESSURE_BIN_WIDTH));
+  canvas.setCursor(centerX, centerY + (2 * LABEL_HEIGHT));
+  canvas.print("color: share");
+  canvas.setCursor(centerX, centerY + (3 * LABEL_HEIGHT));
+  canvas.printf("n=%lu", static_cast<unsigned long>(histogram.total()));
+  canvas.setTextColor(canvasColor(COLOR_WHITE));
+}
+
+// ────────────────────── 実機での出力 ──────────────────────
+#if OIL_STARVATION_MAP_ENABLED
+StarvationHistogram starvationMap;
+
+#if defined(ARDUINO)
+void printStarvationMap()
+{
+  char line[96];
+  Serial.print("[OilMap] direction,g_from");
+  for (int p = 0; p < StarvationHistogram::PRESSURE_BINS; ++p)
+  {
+    Serial.printf(",p%d", p);
+  }
+  Serial.println();
+  for (int d = 0; d < StarvationHistogram::DIRECTION_BINS; ++d)
+  {
+    for (int g = 0; g < StarvationHistogram::G_BINS; ++g)
+    {
+      starvationMap.formatColumn(d, g, line, sizeof(line));
+      Serial.println(line);
+    }
+  }
+  Serial.printf("[OilMap] samples %lu, bin %.2fG x %.1fbar\n", static_cast<unsigned long>(starvationMap.total()),
+                static_cast<double>(StarvationHistogram::G_BIN_WIDTH),
+                static_cast<double>(StarvationHistogram::PRESSURE_BIN_WIDTH));
+}
+#endif
+#endif
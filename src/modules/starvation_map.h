@@ -0,0 +1,63 @@
+#ifndef STARVATION_MAP_H
+#define STARVATION_MAP_H
+
+#include <M5GFX.h>
+
+#include <cstddef>
+#include <cstdint>
+
+#include "config.h"
+
+// ────────────────────── G と油圧の分布 ──────────────────────
+// G の向き・大きさと油圧で分類した頻度分布。ビンは固定なので、走行時間が延びても使用メモリは変わらない。
+// 向き × G の列ごとの合計も持ち、表示では「その向き・G で油圧がどこにあったか」の割合を色で示す
+class StarvationHistogram
+{
+ public:
+  // 向きは画面上の配置順（左上から FL, Front, FR, Left, Right, RL, Rear, RR）
+  static constexpr int DIRECTION_BINS = 8;
+  static constexpr int G_BINS = 6;
+  static constexpr float G_BIN_WIDTH = 0.25F;  // 最後のビンは 1.25G 以上
+  static constexpr int PRESSURE_BINS = 8;
+  static constexpr float PRESSURE_BIN_WIDTH = 1.0F;  // 最後のビンは 7bar 以上
+
+  // 1 サンプルを加える。向きが不明なサンプルは数えない
+  void record(float gForce, const char *direction, float pressure);
+  void reset();
+
+  auto count(int direction, int gBin, int pressureBin) const -> uint32_t
+  {
+    return counts[direction][gBin][pressureBin];
+  }
+  // 向き・G の列の合計
+  auto columnTotal(int direction, int gBin) const -> uint32_t { return columnTotals[direction][gBin]; }
+  auto total() const -> uint32_t { return sampleCount; }
+
+  static auto directionOf(const char *direction) -> int;
+  static auto directionLabel(int direction) -> const char *;
+  static auto gBinOf(float gForce) -> int;
+  static auto pressureBinOf(float pressure) -> int;
+
+  // 1 列分を "FL,0.25,0,3,12,40,2,0,0,0" (向き, G 下限, 油圧ビンごとの回数) 形式で書き出す
+  void formatColumn(int direction, int gBin, char *buffer, size_t size) const;
+
+ private:
+  uint32_t counts[DIRECTION_BINS][G_BINS][PRESSURE_BINS] = {};
+  uint32_t columnTotals[DIRECTION_BINS][G_BINS] = {};
+  uint32_t sampleCount = 0;
+};
+
+// ────────────────────── ヒートマップ ──────────────────────
+// 3 × 3 の枠に車両から見た向きの順で並べ、各枠の横軸を G、縦軸を油圧（下が低圧）として描く。
+// 中央の枠には軸の説明とサンプル数を描く
+void drawStarvationMap(M5Canvas &canvas, const StarvationHistogram &histogram, int x, int y, int w, int h);
+
+#if OIL_STARVATION_MAP_ENABLED
+extern StarvationHistogram starvationMap;
+#if defined(ARDUINO)
+// CSV でシリアルへ出力する
+void printStarvationMap();
+#endif
+#endif
+
+#endif  // STARVATION_MAP_H
@@ -0,0 +1,116 @@
+#ifndef STREAMING_STATS_H
+#define STREAMING_STATS_H
+
+#include <cstddef>
+
+// ────────────────────── 逐次統計 ──────────────────────
+// 容量を型で固定し、ヒープを使わずに 1 サンプルずつ更新する統計量。
+// 窓の平均と平滑化は固定小数点で行うため fixed_point.h の FixedMovingAverage / FixedEma を使う
+
+// ────────────────────── 窓内の中央値 ──────────────────────
+// 到着順のリングと、同じ値を昇順に並べた配列を持つ。
+// 追い出す値の位置から新しい値の位置まで詰めるだけなので、コピーも並べ替えもしない。
+// push() は探索が二分探索、移動量が追い出す値と新しい値の順位の差で、最悪 O(N)（最小を追い出して最大を入れるなど）。
+// ゆっくり変わる信号では順位の差が小さくほぼ定数になる。窓の長い用途には向かない
+template <typename T, size_t N>
+class SlidingMedian
+{
+  static_assert(N > 0, "サンプル数は 1 以上");
+
+ public:
+  void push(T sample)
+  {
+    if (count < N)
+    {
+      // 満杯までは末尾から挿入位置まで後ろへずらす
+      size_t i = count;
+      while (i > 0 && sample < sorted[i - 1])
+      {
+        sorted[i] = sorted[i - 1];
+        --i;
+      }
+      sorted[i] = sample;
+      ++count;
+    }
+    else
+    {
+      size_t i = lowerBound(arrival[head]);
+      if (sorted[i] < sample)
+      {
+        while (i + 1 < N && sorted[i + 1] < sample)
+        {
+          sorted[i] = sorted[i + 1];
+          ++i;
+        }
+      }
+      else
+      {
+        while (i > 0 && sample < sorted[i - 1])
+        {
+          sorted[i] = sorted[i - 1];
+          --i;
+        }
+      }
+      sorted[i] = sample;
+    }
+    arrival[head] = sample;
+    head = (head + 1 == N) ? 0 : head + 1;
+  }
+  void reset()
+  {
+    head = 0;
+    count = 0;
+  }
+
+  // 偶数個のときは上側の中央値（nth_element で N/2 番目を取るのと同じ）。空のときは T()
+  auto median() const -> T { return (count > 0) ? sorted[count / 2] : T(); }
+  // 昇順で rank 番目の値
+  auto rank(size_t r) const -> T { return sorted[r]; }
+  auto size() const -> size_t { return count; }
+  static constexpr auto capacity() -> size_t { return N; }
+
+ private:
+  auto lowerBound(T value) const -> size_t
+  {
+    size_t lo = 0;
+    size_t hi = count;
+    while (lo < hi)
+    {
+      size_t mid = (lo + hi) / 2;
+      if (sorted[mid] < value)
+      {
+        lo = mid + 1;
+      }
+      else
+      {
+        hi = mid;
+      }
+    }
+    return lo;
+  }
+
+  T arrival[N] = {};  // 到着順（次に追い出す値は head の位置）
+  T sorted[N] = {};   // 昇順
+  size_t head = 0;
+  size_t count = 0;
+};
+
+// ────────────────────── 区間最大値 ──────────────────────
+// リセットから現在までの最大値（初期値 T()）
+template <typename T>
+class PeakHold
+{
+ public:
+  auto update(T sample) -> T
+  {
+    peak = (sample > peak) ? sample : peak;
+    return peak;
+  }
+  void reset() { peak = T(); }
+  auto value() const -> T { return peak; }
+
+ private:
+  T peak = T();
+};
+
+#endif  // STREAMING_STATS_H
@@ -0,0 +1,208 @@
+#include <unity.h>
+
+#include <cstdio>
+#include <vector>
+
+#include "../../include/config.h"
+#include "../../src/modules/adc_scheduler.cpp"
+
+// ────────────────────── 疑似 I2C バス ──────────────────────
+// 全変換器が 1 本のバスを共有し、バス操作は 1 回ごとに共通の時計を進める
+static unsigned long busNowUs = 0;
+static auto busMicros() -> unsigned long { return busNowUs; }
+
+// 400kHz I2C で 3 バイト程度のレジスタアクセスに掛かる時間 [us]
+constexpr unsigned long BUS_OP_US = 100;
+// 1600SPS の変換時間に起動時間を加えた値 [us]
+constexpr unsigned long CONVERSION_US = 700;
+
+struct BusEvent
+{
+  uint8_t device;
+  char op;  // 'S':開始 'C':完了確認 'R':読み出し
+};
+static std::vector<BusEvent> busLog;
+// 別の変換器・チャンネルの値を受け取った回数
+static int mismatchedResults = 0;
+
+// 変換は各変換器の内部で進み、バスを使うのはレジスタアクセスのときだけ
+class FakeAds : public AdcDevice
+{
+ public:
+  FakeAds(uint8_t id, bool skipEarlyChecks) : id(id), skipEarlyChecks(skipEarlyChecks) {}
+
+  void startConversion(uint8_t channel) override
+  {
+    access('S');
+    mux = channel;
+    readyAtUs = busNowUs + CONVERSION_US;
+  }
+  auto isConversionReady() -> bool override
+  {
+    access('C');
+    return busNowUs >= readyAtUs;
+  }
+  auto readConversionResult() -> int16_t override
+  {
+    access('R');
+    return static_cast<int16_t>((id * 100) + mux);
+  }
+  auto minConversionUs() const -> unsigned long override { return skipEarlyChecks ? CONVERSION_US * 9 / 10 : 0; }
+
+ private:
+  void access(char op)
+  {
+    busNowUs += BUS_OP_US;
+    busLog.push_back({id, op});
+  }
+
+  uint8_t id;
+  bool skipEarlyChecks;
+  uint8_t mux = ADC_NO_CHANNEL;
+  unsigned long readyAtUs = 0;
+};
+
+// 変換器 n 台で durationUs の間 poll し続け、回収できた結果の数を返す
+static auto measureSamples(uint8_t devices, bool skipEarlyChecks, unsigned long durationUs,
+                           int (&perDevice)[ADC_MAX_DEVICES]) -> int
+{
+  std::vector<FakeAds> adcs;
+  adcs.reserve(devices);
+  AdcBank bank;
+  for (uint8_t i = 0; i < devices; ++i)
+  {
+    adcs.emplace_back(i, skipEarlyChecks);
+  }
+  for (uint8_t i = 0; i < devices; ++i)
+  {
+    bank.attach(i, adcs[i], busMicros);
+    bank.setHomeChannel(i, 2);
+  }
+
+  int total = 0;
+  unsigned long endUs = busNowUs + durationUs;
+  while (busNowUs < endUs)
+  {
+    unsigned long before = busNowUs;
+    bank.poll();
+    for (uint8_t i = 0; i < devices; ++i)
+    {
+      int16_t raw = 0;
+      if (bank.takeResult(i, 2, raw))
+      {
+        mismatchedResults += (raw == (i * 100) + 2) ? 0 : 1;
+        ++perDevice[i];
+        ++total;
+      }
+    }
+    if (busNowUs == before)
+    {
+      busNowUs += 10;  // バスが空いている間は CPU 側の処理だけ進む
+    }
+  }
+  return total;
+}
+
+void setUp()
+{
+  busNowUs = 0;
+  busLog.clear();
+  mismatchedResults = 0;
+}
+
+void tearDown()
+{
+  // テスト終了時の処理は不要
+}
+
+// 最初の poll で全変換器の変換を続けて開始し、完了を待たずに戻ることを確認
+void test_starts_all_devices_before_collecting()
+{
+  FakeAds a(0, true), b(1, true), c(2, true), d(3, true);
+  AdcBank bank;
+  bank.attach(0, a, busMicros);
+  bank.attach(1, b, busMicros);
+  bank.attach(2, c, busMicros);
+  bank.attach(3, d, busMicros);
+  for (uint8_t i = 0; i < 4; ++i)
+  {
+    bank.setHomeChannel(i, 1);
+  }
+  TEST_ASSERT_EQUAL_UINT8(4, bank.deviceCount());
+
+  bank.poll();
+  TEST_ASSERT_EQUAL_INT(4, static_cast<int>(busLog.size()));
+  for (uint8_t i = 0; i < 4; ++i)
+  {
+    TEST_ASSERT_EQUAL_UINT8(i, busLog[i].device);
+    TEST_ASSERT_EQUAL_INT('S', busLog[i].op);
+  }
+  // 変換時間が経つまでは完了確認でバスを使わない
+  bank.poll();
+  TEST_ASSERT_EQUAL_INT(4, static_cast<int>(busLog.size()));
+  TEST_ASSERT_EQUAL_UINT32(4 * BUS_OP_US, bank.consumeBusTimeUs());
+}
+
+// 回収は巡回順で、どの変換器も他より 2 回以上多く読まれないことを確認
+void test_collects_round_robin()
+{
+  int perDevice[ADC_MAX_DEVICES] = {};
+  measureSamples(4, true, 200000, perDevice);
+
+  int reads[ADC_MAX_DEVICES] = {};
+  int worstSkew = 0;
+  for (const BusEvent &event : busLog)
+  {
+    if (event.op != 'R')
+    {
+      continue;
+    }
+    ++reads[event.device];
+    int lowest = reads[0];
+    int highest = reads[0];
+    for (int r : reads)
+    {
+      lowest = (r < lowest) ? r : lowest;
+      highest = (r > highest) ? r : highest;
+    }
+    worstSkew = (highest - lowest > worstSkew) ? highest - lowest : worstSkew;
+  }
+  TEST_ASSERT_LESS_OR_EQUAL(1, worstSkew);
+  TEST_ASSERT_EQUAL_INT(0, mismatchedResults);
+}
+
+// 合計のサンプル数が変換器の数に応じて増え、モデルの値と一致することを確認
+void test_throughput_follows_model()
+{
+  constexpr unsigned long DURATION_US = 1000000;
+  int samples[ADC_MAX_DEVICES + 1] = {};
+  for (uint8_t n = 1; n <= ADC_MAX_DEVICES; ++n)
+  {
+    int perDevice[ADC_MAX_DEVICES] = {};
+    samples[n] = measureSamples(n, true, DURATION_US, perDevice);
+    float model = AdcBank::modelSamplesPerSecond(n, CONVERSION_US, BUS_OP_US);
+    TEST_ASSERT_FLOAT_WITHIN(model * 0.15F, model, static_cast<float>(samples[n]));
+
+    int noSkip[ADC_MAX_DEVICES] = {};
+    int withoutSkip = measureSamples(n, false, DURATION_US, noSkip);
+    char message[120];
+    snprintf(message, sizeof(message), "%u device(s): %d samples/s (model %.0f), %d without skipping early checks",
+             n, samples[n], model, withoutSkip);
+    TEST_MESSAGE(message);
+  }
+  TEST_ASSERT_EQUAL_INT(0, mismatchedResults);
+  TEST_ASSERT_GREATER_THAN(samples[1] * 5 / 2, samples[4]);
+  TEST_ASSERT_GREATER_THAN(samples[1], samples[2]);
+  TEST_ASSERT_GREATER_THAN(samples[2], samples[3]);
+}
+
+void setup()
+{
+  UNITY_BEGIN();
+  RUN_TEST(test_starts_all_devices_before_collecting);
+  RUN_TEST(test_collects_round_robin);
+  RUN_TEST(test_throughput_follows_model);
+  UNITY_END();
+}
+
+void loop() {}
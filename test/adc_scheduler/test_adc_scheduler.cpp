@@ -0,0 +1,251 @@
+#include <unity.h>
+
+#include <cstdio>
+
+#include "../../include/config.h"
+#include "../../src/modules/adc_scheduler.cpp"
+
+// ────────────────────── 疑似クロックと疑似 ADC ──────────────────────
+static unsigned long fakeNowUs = 0;
+static auto fakeMicros() -> unsigned long { return fakeNowUs; }
+
+// 400kHz I2C で3バイト程度のレジスタアクセスに掛かる時間 [us]
+constexpr unsigned long FAKE_I2C_OP_US = 100;
+// 1600SPS の変換時間に起動時間を加えた値 [us]
+constexpr unsigned long FAKE_CONVERSION_US = 700;
+
+// 変換時間とマルチプレクサ切替直後の誤差をモデル化した ADC
+class FakeAdc : public AdcDevice
+{
+ public:
+  int16_t inputs[ADC_CHANNEL_COUNT] = {100, 200, 300, 400};
+  int startCount = 0;
+
+  void startConversion(uint8_t channel) override
+  {
+    fakeNowUs += FAKE_I2C_OP_US;
+    switched = channel != mux;
+    mux = channel;
+    readyAtUs = fakeNowUs + FAKE_CONVERSION_US;
+    ++startCount;
+  }
+  auto isConversionReady() -> bool override
+  {
+    fakeNowUs += FAKE_I2C_OP_US;
+    return fakeNowUs >= readyAtUs;
+  }
+  auto readConversionResult() -> int16_t override
+  {
+    fakeNowUs += FAKE_I2C_OP_US;
+    // 切替直後は入力容量の充電が間に合わず半分の値になる
+    return switched ? static_cast<int16_t>(inputs[mux] / 2) : inputs[mux];
+  }
+
+ private:
+  uint8_t mux = ADC_NO_CHANNEL;
+  bool switched = true;
+  unsigned long readyAtUs = 0;
+};
+
+// 従来の readAdcWithSettling と同じ手順（捨て変換＋50us 待ち＋本変換）
+static auto blockingReadWithSettling(FakeAdc &adc, uint8_t ch) -> int16_t
+{
+  for (int i = 0; i < 2; ++i)
+  {
+    adc.startConversion(ch);
+    while (!adc.isConversionReady())
+    {
+    }
+    if (i == 0)
+    {
+      adc.readConversionResult();
+      fakeNowUs += 50;
+    }
+  }
+  return adc.readConversionResult();
+}
+
+void setUp() { fakeNowUs = 0; }
+
+void tearDown()
+{
+  // テスト終了時の処理は不要
+}
+
+// poll() は変換完了を待たずに戻ることを確認
+void test_poll_does_not_block()
+{
+  FakeAdc adc;
+  AdcScheduler scheduler(adc, fakeMicros);
+  scheduler.setHomeChannel(ADC_CH_OIL_PRESSURE);
+
+  unsigned long before = fakeNowUs;
+  scheduler.poll();
+  TEST_ASSERT_TRUE(scheduler.isBusy());
+  TEST_ASSERT_EQUAL_INT(FAKE_I2C_OP_US, fakeNowUs - before);
+
+  before = fakeNowUs;
+  scheduler.poll();  // まだ変換中
+  TEST_ASSERT_EQUAL_INT(FAKE_I2C_OP_US, fakeNowUs - before);
+  int16_t raw = 0;
+  TEST_ASSERT_FALSE(scheduler.takeResult(ADC_CH_OIL_PRESSURE, raw));
+}
+
+// 切替直後の変換は捨て、後続の tick で正しい値を返すことを確認
+void test_discards_conversion_after_mux_switch()
+{
+  FakeAdc adc;
+  AdcScheduler scheduler(adc, fakeMicros);
+  scheduler.setHomeChannel(ADC_CH_OIL_PRESSURE);
+
+  int16_t raw = 0;
+  for (int i = 0; i < 10 && !scheduler.takeResult(ADC_CH_OIL_PRESSURE, raw); ++i)
+  {
+    scheduler.poll();
+    fakeNowUs += 1000;
+  }
+  TEST_ASSERT_EQUAL_INT(adc.inputs[ADC_CH_OIL_PRESSURE], raw);
+  // 捨て変換・本変換に続き、回収と同時に次の変換を開始している
+  TEST_ASSERT_EQUAL_INT(3, adc.startCount);
+}
+
+// 要求したチャンネルを巡回してからホームチャンネルへ戻ることを確認
+void test_rotates_requested_channels_then_returns_home()
+{
+  FakeAdc adc;
+  AdcScheduler scheduler(adc, fakeMicros);
+  scheduler.setHomeChannel(ADC_CH_OIL_PRESSURE);
+  scheduler.requestChannel(ADC_CH_WATER_TEMP);
+  scheduler.requestChannel(ADC_CH_OIL_TEMP);
+
+  bool gotWater = false;
+  bool gotOil = false;
+  int pressureCount = 0;
+  for (int i = 0; i < 20; ++i)
+  {
+    scheduler.poll();
+    fakeNowUs += 1000;
+    int16_t raw = 0;
+    if (scheduler.takeResult(ADC_CH_WATER_TEMP, raw))
+    {
+      TEST_ASSERT_EQUAL_INT(adc.inputs[ADC_CH_WATER_TEMP], raw);
+      gotWater = true;
+    }
+    if (scheduler.takeResult(ADC_CH_OIL_TEMP, raw))
+    {
+      TEST_ASSERT_EQUAL_INT(adc.inputs[ADC_CH_OIL_TEMP], raw);
+      gotOil = true;
+    }
+    if (scheduler.takeResult(ADC_CH_OIL_PRESSURE, raw))
+    {
+      TEST_ASSERT_EQUAL_INT(adc.inputs[ADC_CH_OIL_PRESSURE], raw);
+      ++pressureCount;
+    }
+  }
+  TEST_ASSERT_TRUE(gotWater);
+  TEST_ASSERT_TRUE(gotOil);
+  // 同一チャンネルの連続変換では捨て変換が不要なため毎 tick 結果が得られる
+  TEST_ASSERT_GREATER_THAN(10, pressureCount);
+}
+
+// ADC が応答しない場合でも状態機械が止まらないことを確認
+void test_times_out_when_device_never_ready()
+{
+  class DeadAdc : public AdcDevice
+  {
+   public:
+    void startConversion(uint8_t) override { fakeNowUs += FAKE_I2C_OP_US; }
+    auto isConversionReady() -> bool override { return false; }
+    auto readConversionResult() -> int16_t override { return 0; }
+  } adc;
+  AdcScheduler scheduler(adc, fakeMicros);
+  scheduler.setHomeChannel(ADC_CH_OIL_PRESSURE);
+  scheduler.requestChannel(ADC_CH_WATER_TEMP);
+
+  scheduler.poll();
+  fakeNowUs += 10000;
+  scheduler.poll();  // 打ち切り後はホームチャンネルで再開
+  TEST_ASSERT_TRUE(scheduler.isBusy());
+  int16_t raw = 0;
+  TEST_ASSERT_FALSE(scheduler.takeResult(ADC_CH_WATER_TEMP, raw));
+}
+
+// 1フレームあたりの I2C 占有時間を従来方式と比較
+void test_bus_time_per_frame_before_and_after()
+{
+  constexpr int FRAMES = 600;                 // 10秒分
+  constexpr unsigned long RENDER_US = 12000;  // 描画に掛かる時間
+  constexpr int TEMP_EVERY_FRAMES = 30;       // 500ms ごとの温度取得
+  FakeAdc adc;
+
+  // 従来方式: 毎フレーム油圧、30フレームごとに水温と油温をブロッキングで取得
+  unsigned long blockingTotalUs = 0;
+  unsigned long blockingWorstUs = 0;
+  for (int frame = 0; frame < FRAMES; ++frame)
+  {
+    unsigned long start = fakeNowUs;
+    blockingReadWithSettling(adc, ADC_CH_OIL_PRESSURE);
+    if (frame % TEMP_EVERY_FRAMES == 0)
+    {
+      blockingReadWithSettling(adc, ADC_CH_WATER_TEMP);
+      blockingReadWithSettling(adc, ADC_CH_OIL_TEMP);
+    }
+    unsigned long spent = fakeNowUs - start;
+    blockingTotalUs += spent;
+    blockingWorstUs = spent > blockingWorstUs ? spent : blockingWorstUs;
+    fakeNowUs += RENDER_US;
+  }
+
+  // スケジューラ方式: 取得時と描画後に1回ずつ poll する
+  AdcScheduler scheduler(adc, fakeMicros);
+  scheduler.setHomeChannel(ADC_CH_OIL_PRESSURE);
+  unsigned long asyncTotalUs = 0;
+  unsigned long asyncWorstUs = 0;
+  int pressureSamples = 0;
+  int tempSamples = 0;
+  for (int frame = 0; frame < FRAMES; ++frame)
+  {
+    if (frame % TEMP_EVERY_FRAMES == 0)
+    {
+      scheduler.requestChannel(ADC_CH_WATER_TEMP);
+      scheduler.requestChannel(ADC_CH_OIL_TEMP);
+    }
+    scheduler.poll();
+    fakeNowUs += RENDER_US;
+    scheduler.poll();
+    unsigned long spent = scheduler.consumeBusTimeUs();
+    asyncTotalUs += spent;
+    asyncWorstUs = spent > asyncWorstUs ? spent : asyncWorstUs;
+
+    int16_t raw = 0;
+    pressureSamples += scheduler.takeResult(ADC_CH_OIL_PRESSURE, raw) ? 1 : 0;
+    tempSamples += scheduler.takeResult(ADC_CH_WATER_TEMP, raw) ? 1 : 0;
+  }
+
+  char msg[160];
+  snprintf(msg, sizeof(msg), "I2C per frame: blocking avg %lu us (worst %lu), scheduler avg %lu us (worst %lu)",
+           blockingTotalUs / FRAMES, blockingWorstUs, asyncTotalUs / FRAMES, asyncWorstUs);
+  TEST_MESSAGE(msg);
+
+  TEST_ASSERT_LESS_THAN(blockingTotalUs / 4, asyncTotalUs);
+  TEST_ASSERT_LESS_OR_EQUAL(6 * FAKE_I2C_OP_US, asyncWorstUs);
+  // 温度取得のフレームを除き油圧は毎フレーム更新される
+  TEST_ASSERT_GREATER_THAN(FRAMES * 8 / 10, pressureSamples);
+  TEST_ASSERT_EQUAL_INT(FRAMES / TEMP_EVERY_FRAMES, tempSamples);
+}
+
+void setup()
+{
+  UNITY_BEGIN();
+  RUN_TEST(test_poll_does_not_block);
+  RUN_TEST(test_discards_conversion_after_mux_switch);
+  RUN_TEST(test_rotates_requested_channels_then_returns_home);
+  RUN_TEST(test_times_out_when_device_never_ready);
+  RUN_TEST(test_bus_time_per_frame_before_and_after);
+  UNITY_END();
+}
+
+void loop()
+{
+  // ループ処理は不要
+}
@@ -0,0 +1,182 @@
+#include <unity.h>
+
+#include <chrono>
+#include <cstdio>
+
+#include "../../include/config.h"
+#include "../../src/modules/canvas_palette.h"
+
+// ────────────────────── テスト用の描画 ──────────────────────
+// 画素形式ごとのキャンバス（16: RGB565、8 / 4: パレット番号）
+static M5Canvas canvas16;
+static M5Canvas canvas8;
+static M5Canvas canvas4;
+
+// 画素形式に合わせた色の値
+static auto colorFor(const M5Canvas &canvas, uint16_t rgb) -> uint16_t
+{
+  return (canvas.getColorDepth() == 16) ? rgb : nearestPaletteIndex(rgb);
+}
+
+// メーターに近い図形と文字を描く
+static void drawScene(M5Canvas &canvas)
+{
+  canvas.fillScreen(colorFor(canvas, COLOR_BLACK));
+  canvas.fillRect(7, 3, 151, 41, colorFor(canvas, 0x18E3));
+  canvas.fillArc(160, 120, 80, 100, 135.0F, 300.0F, colorFor(canvas, COLOR_WHITE));
+  canvas.fillArc(160, 120, 80, 100, 300.0F, 405.0F, colorFor(canvas, COLOR_RED));
+  canvas.drawRect(1, 1, 317, 237, colorFor(canvas, rgb565(80, 80, 80)));
+  canvas.setFont(&fonts::Font0);
+  canvas.setTextColor(colorFor(canvas, COLOR_YELLOW));
+  canvas.setCursor(13, 201);
+  canvas.print("OIL.P 5.5");
+}
+
+static auto countMismatchedPixels(const M5Canvas &a, const M5Canvas &b) -> int
+{
+  int mismatched = 0;
+  for (int y = 0; y < LCD_HEIGHT; ++y)
+  {
+    for (int x = 0; x < LCD_WIDTH; ++x)
+    {
+      if (a.readPixel(x, y) != b.readPixel(x, y))
+      {
+        ++mismatched;
+      }
+    }
+  }
+  return mismatched;
+}
+
+void setUp()
+{
+  canvas16.setColorDepth(lgfx::rgb565_2Byte);
+  canvas8.setColorDepth(lgfx::palette_8bit);
+  canvas4.setColorDepth(lgfx::palette_4bit);
+  canvas16.createSprite(LCD_WIDTH, LCD_HEIGHT);
+  canvas8.createSprite(LCD_WIDTH, LCD_HEIGHT);
+  canvas4.createSprite(LCD_WIDTH, LCD_HEIGHT);
+  applyCanvasPalette(canvas8);
+  applyCanvasPalette(canvas4);
+}
+
+void tearDown()
+{
+  // テスト終了時の処理は不要
+}
+
+// 画面で使う色がそれぞれ自分のパレット番号へ写り、近い色は最も近い番号へ丸められることを確認
+void test_palette_maps_ui_colors_exactly()
+{
+  for (int i = 0; i < CANVAS_PALETTE_SIZE; ++i)
+  {
+    TEST_ASSERT_EQUAL_UINT8(i, nearestPaletteIndex(CANVAS_PALETTE[i]));
+  }
+  TEST_ASSERT_EQUAL_UINT8(nearestPaletteIndex(COLOR_WHITE), nearestPaletteIndex(rgb565(250, 250, 250)));
+  TEST_ASSERT_EQUAL_UINT8(nearestPaletteIndex(rgb565(24, 24, 24)), nearestPaletteIndex(rgb565(20, 20, 20)));
+  // 16bit 形式では値を変えない
+  TEST_ASSERT_EQUAL_UINT16(0x18E3, CANVAS_PALETTE_BITS ? CANVAS_PALETTE[canvasColor(0x18E3)] : canvasColor(0x18E3));
+}
+
+// 4bit の複写が、左端の偶奇の組み合わせによらず 1 画素ずつ複写した結果と一致することを確認
+void test_nibble_copy_alignment()
+{
+  using Pixels = CanvasPixels<4>;
+  uint8_t source[8];
+  for (int i = 0; i < 8; ++i)
+  {
+    source[i] = static_cast<uint8_t>((i * 0x23) + 0x10);
+  }
+  for (int sourceX = 0; sourceX < 2; ++sourceX)
+  {
+    for (int destX = 0; destX < 2; ++destX)
+    {
+      for (int count = 0; count <= 9; ++count)
+      {
+        uint8_t copied[8] = {};
+        uint8_t expected[8] = {};
+        Pixels::copy(copied, destX + 2, source, sourceX + 1, count);
+        for (int i = 0; i < count; ++i)
+        {
+          Pixels::write(expected, destX + 2 + i, Pixels::read(source, sourceX + 1 + i));
+        }
+        for (int i = 0; i < 8; ++i)
+        {
+          TEST_ASSERT_EQUAL_UINT8(expected[i], copied[i]);
+        }
+      }
+    }
+  }
+}
+
+// 同じ画面を 16 / 8 / 4bit で描き、RGB565 へ展開した結果が一致すること、バッファが 1/2・1/4 になることを確認
+void test_palette_canvas_matches_rgb565()
+{
+  drawScene(canvas16);
+  drawScene(canvas8);
+  drawScene(canvas4);
+  TEST_ASSERT_EQUAL_INT(0, countMismatchedPixels(canvas16, canvas8));
+  TEST_ASSERT_EQUAL_INT(0, countMismatchedPixels(canvas16, canvas4));
+
+  // 転送時の展開（パネルのバイト順の RGB565）も readPixel と一致する
+  lgfx::swap565_t lut[16];
+  for (int i = 0; i < CANVAS_PALETTE_SIZE; ++i)
+  {
+    lut[i] = lgfx::swap565_t(rgb565Red(CANVAS_PALETTE[i]), rgb565Green(CANVAS_PALETTE[i]), rgb565Blue(CANVAS_PALETTE[i]));
+  }
+  uint16_t row[LCD_WIDTH];
+  const uint8_t *source = static_cast<const uint8_t *>(canvas4.getBuffer());
+  CanvasPixels<4>::expand(source + (100 * CanvasPixels<4>::rowBytes(LCD_WIDTH)), 1, LCD_WIDTH - 1, lut, row);
+  for (int x = 1; x < LCD_WIDTH; ++x)
+  {
+    TEST_ASSERT_EQUAL_UINT16(canvas16.readPixel(x, 100), row[x - 1]);
+  }
+
+  TEST_ASSERT_EQUAL_UINT32(LCD_WIDTH * LCD_HEIGHT * 2, canvas16.bufferLength());
+  TEST_ASSERT_EQUAL_UINT32(LCD_WIDTH * LCD_HEIGHT, canvas8.bufferLength());
+  TEST_ASSERT_EQUAL_UINT32(LCD_WIDTH * LCD_HEIGHT / 2, canvas4.bufferLength());
+  char message[128];
+  snprintf(message, sizeof(message), "canvas buffer: 16bpp %u B, 8bpp %u B, 4bpp %u B",
+           static_cast<unsigned>(canvas16.bufferLength()), static_cast<unsigned>(canvas8.bufferLength()),
+           static_cast<unsigned>(canvas4.bufferLength()));
+  TEST_MESSAGE(message);
+}
+
+// 塗りつぶしの速さを画素形式ごとに測る（ホストでの参考値）
+void test_fill_throughput()
+{
+  constexpr int ITERATIONS = 200;
+  auto measure = [](M5Canvas &canvas)
+  {
+    uint16_t colors[2] = {colorFor(canvas, 0x18E3), colorFor(canvas, COLOR_BLACK)};
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < ITERATIONS; ++i)
+    {
+      canvas.fillRect(0, 0, LCD_WIDTH, LCD_HEIGHT, colors[i & 1]);
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    double seconds = std::chrono::duration<double>(elapsed).count();
+    return (static_cast<double>(LCD_WIDTH) * LCD_HEIGHT * ITERATIONS) / seconds / 1.0e6;
+  };
+  double mpx16 = measure(canvas16);
+  double mpx8 = measure(canvas8);
+  double mpx4 = measure(canvas4);
+  TEST_ASSERT_TRUE(mpx16 > 0.0 && mpx8 > 0.0 && mpx4 > 0.0);
+
+  char message[128];
+  snprintf(message, sizeof(message), "full-screen fillRect: 16bpp %.0f Mpx/s, 8bpp %.0f Mpx/s, 4bpp %.0f Mpx/s", mpx16,
+           mpx8, mpx4);
+  TEST_MESSAGE(message);
+}
+
+void setup()
+{
+  UNITY_BEGIN();
+  RUN_TEST(test_palette_maps_ui_colors_exactly);
+  RUN_TEST(test_nibble_copy_alignment);
+  RUN_TEST(test_palette_canvas_matches_rgb565);
+  RUN_TEST(test_fill_throughput);
+  UNITY_END();
+}
+
+void loop() {}
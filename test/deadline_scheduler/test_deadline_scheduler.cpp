@@ -0,0 +1,195 @@
+#include <unity.h>
+
+#include <cstdio>
+#include <cstring>
+#include <limits>
+
+#include "../../include/config.h"
+#include "../../src/modules/deadline_scheduler.cpp"
+
+// ────────────────────── 疑似クロックと疑似ジョブ ──────────────────────
+static unsigned long fakeNowUs = 0;
+static auto fakeMicros() -> unsigned long { return fakeNowUs; }
+
+// 実行順を 1 文字ずつ記録する
+static char runOrder[64];
+static size_t runOrderLength = 0;
+// 各ジョブの実行時間 [us]
+static unsigned long renderCostUs = 0;
+static unsigned long inputCostUs = 0;
+static unsigned long logCostUs = 0;
+// 描画ジョブの開始時刻
+static unsigned long renderStartUs[700];
+static int renderRuns = 0;
+
+static void recordRun(char tag, unsigned long costUs)
+{
+  if (runOrderLength + 1 < sizeof(runOrder))
+  {
+    runOrder[runOrderLength++] = tag;
+    runOrder[runOrderLength] = '\0';
+  }
+  fakeNowUs += costUs;
+}
+
+static void renderJob()
+{
+  if (renderRuns < 700)
+  {
+    renderStartUs[renderRuns] = fakeNowUs;
+  }
+  ++renderRuns;
+  recordRun('R', renderCostUs);
+}
+static void inputJob() { recordRun('I', inputCostUs); }
+static void logJob() { recordRun('L', logCostUs); }
+
+// 実機の loop() と同じく、実行するジョブが無ければ次の開始時刻まで眠る
+static void runFor(DeadlineScheduler &scheduler, unsigned long durationUs)
+{
+  unsigned long end = fakeNowUs + durationUs;
+  while (static_cast<long>(end - fakeNowUs) > 0)
+  {
+    if (!scheduler.runOnce())
+    {
+      fakeNowUs += scheduler.timeUntilNextReleaseUs();
+    }
+  }
+}
+
+void setUp()
+{
+  fakeNowUs = 1000;
+  runOrder[0] = '\0';
+  runOrderLength = 0;
+  renderCostUs = 5000;
+  inputCostUs = 500;
+  logCostUs = 3000;
+  renderRuns = 0;
+}
+
+void tearDown()
+{
+  // テスト終了時の処理は不要
+}
+
+// 同時に開始したジョブは締め切りが近い順に実行されることを確認
+void test_runs_earliest_deadline_first()
+{
+  DeadlineScheduler scheduler(fakeMicros);
+  scheduler.addJob("render", renderJob, FRAME_INTERVAL_US, FRAME_INTERVAL_US);
+  scheduler.addJob("input", inputJob, FRAME_INTERVAL_US, 2000);
+
+  TEST_ASSERT_TRUE(scheduler.runOnce());
+  TEST_ASSERT_TRUE(scheduler.runOnce());
+  TEST_ASSERT_FALSE(scheduler.runOnce());
+  TEST_ASSERT_EQUAL_STRING("IR", runOrder);
+  TEST_ASSERT_EQUAL_UINT32(FRAME_INTERVAL_US - 5500, scheduler.timeUntilNextReleaseUs());
+}
+
+// 描画が 60Hz の位相を保ち、処理時間に関係なく一定間隔で始まることを確認
+void test_render_period_is_deterministic()
+{
+  DeadlineScheduler scheduler(fakeMicros);
+  scheduler.addJob("input", inputJob, FRAME_INTERVAL_US, 2000);
+  int render = scheduler.addJob("render", renderJob, FRAME_INTERVAL_US, FRAME_INTERVAL_US);
+
+  unsigned long origin = fakeNowUs;
+  runFor(scheduler, 10UL * 1000000UL);
+  TEST_ASSERT_INT_WITHIN(1, 600, renderRuns);
+  for (int i = 1; i < 600; ++i)
+  {
+    // 入力ジョブの実行時間分だけ遅れて始まる
+    TEST_ASSERT_EQUAL_UINT32(origin + (i * FRAME_INTERVAL_US) + inputCostUs, renderStartUs[i]);
+  }
+  TEST_ASSERT_EQUAL_UINT32(0, scheduler.stats(render).misses);
+}
+
+// 周期を超えて処理が遅れた場合、溜まった周期をまとめて実行せず飛ばすことを確認
+void test_overrun_skips_periods_without_burst()
+{
+  DeadlineScheduler scheduler(fakeMicros);
+  int render = scheduler.addJob("render", renderJob, FRAME_INTERVAL_US, FRAME_INTERVAL_US);
+
+  renderCostUs = (FRAME_INTERVAL_US * 3) + 100;
+  TEST_ASSERT_TRUE(scheduler.runOnce());
+  TEST_ASSERT_EQUAL_UINT32(1, scheduler.stats(render).misses);
+  TEST_ASSERT_EQUAL_UINT32(2, scheduler.stats(render).skips);
+  TEST_ASSERT_EQUAL_UINT32((FRAME_INTERVAL_US * 2) + 100, scheduler.stats(render).worstLatenessUs);
+
+  // 次の周期は遅れた時刻からではなく元の位相で始まる
+  renderCostUs = 5000;
+  TEST_ASSERT_TRUE(scheduler.runOnce());
+  TEST_ASSERT_FALSE(scheduler.runOnce());
+  TEST_ASSERT_EQUAL_UINT32(FRAME_INTERVAL_US - 5000 - 100, scheduler.timeUntilNextReleaseUs());
+}
+
+// 想定実行時間を持つジョブは次の描画に食い込む場合は見送り、締め切りを過ぎたら実行されることを確認
+void test_budgeted_job_waits_for_gap()
+{
+  DeadlineScheduler scheduler(fakeMicros);
+  scheduler.addJob("render", renderJob, FRAME_INTERVAL_US, FRAME_INTERVAL_US);
+  int log = scheduler.addJob("log", logJob, FRAME_INTERVAL_US, 100000, 4000);
+
+  // 描画が 14ms かかると残り約 2.6ms しかなく、ログ書き込みは見送られる
+  renderCostUs = 14000;
+  runFor(scheduler, FRAME_INTERVAL_US * 2);
+  TEST_ASSERT_EQUAL_STRING("RR", runOrder);
+  TEST_ASSERT_EQUAL_UINT32(0, scheduler.stats(log).runs);
+
+  // 描画が軽くなれば空き時間で書き込む。見送った周期は飛ばし、現在の周期の分だけ続けて実行する
+  renderCostUs = 5000;
+  runFor(scheduler, FRAME_INTERVAL_US);
+  TEST_ASSERT_EQUAL_STRING("RRRLL", runOrder);
+  TEST_ASSERT_EQUAL_UINT32(1, scheduler.stats(log).skips);
+
+  // 空き時間が無くても締め切り (100ms) を過ぎれば取り残さずに実行する
+  renderCostUs = 14000;
+  runFor(scheduler, 150000);
+  TEST_ASSERT_EQUAL_UINT32(3, scheduler.stats(log).runs);
+  TEST_ASSERT_EQUAL_UINT32(1, scheduler.stats(log).misses);
+}
+
+// micros() の一周（約 71 分）をまたいでも周期と待ち時間が正しいことを確認
+void test_handles_clock_wraparound()
+{
+  fakeNowUs = std::numeric_limits<unsigned long>::max() - 5000;
+  DeadlineScheduler scheduler(fakeMicros);
+  scheduler.addJob("render", renderJob, FRAME_INTERVAL_US, FRAME_INTERVAL_US);
+
+  TEST_ASSERT_TRUE(scheduler.runOnce());
+  TEST_ASSERT_FALSE(scheduler.runOnce());
+  // 描画直後の時刻は一周の直前、次の開始時刻は一周した後
+  TEST_ASSERT_EQUAL_UINT32(FRAME_INTERVAL_US - 5000, scheduler.timeUntilNextReleaseUs());
+  fakeNowUs += scheduler.timeUntilNextReleaseUs();
+  TEST_ASSERT_LESS_THAN(FRAME_INTERVAL_US, fakeNowUs);
+  TEST_ASSERT_TRUE(scheduler.runOnce());
+  TEST_ASSERT_EQUAL_INT(2, renderRuns);
+}
+
+// 登録数の上限と不正な周期を拒否することを確認
+void test_rejects_invalid_jobs()
+{
+  DeadlineScheduler scheduler(fakeMicros);
+  TEST_ASSERT_EQUAL_INT(DeadlineScheduler::INVALID_JOB, scheduler.addJob("zero", inputJob, 0, 0));
+  for (int i = 0; i < DeadlineScheduler::MAX_JOBS; ++i)
+  {
+    TEST_ASSERT_EQUAL_INT(i, scheduler.addJob("input", inputJob, 1000, 1000));
+  }
+  TEST_ASSERT_EQUAL_INT(DeadlineScheduler::INVALID_JOB, scheduler.addJob("extra", inputJob, 1000, 1000));
+  TEST_ASSERT_EQUAL_STRING("input", scheduler.jobName(0));
+}
+
+void setup()
+{
+  UNITY_BEGIN();
+  RUN_TEST(test_runs_earliest_deadline_first);
+  RUN_TEST(test_render_period_is_deterministic);
+  RUN_TEST(test_overrun_skips_periods_without_burst);
+  RUN_TEST(test_budgeted_job_waits_for_gap);
+  RUN_TEST(test_handles_clock_wraparound);
+  RUN_TEST(test_rejects_invalid_jobs);
+  UNITY_END();
+}
+
+void loop() {}
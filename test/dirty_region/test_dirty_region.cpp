@@ -0,0 +1,121 @@
+#include <unity.h>
+
+#include <cstdio>
+
+#include "../../include/config.h"
+#include "../../src/modules/dirty_region.cpp"
+
+constexpr uint32_t FULL_FRAME_BYTES = LCD_WIDTH * LCD_HEIGHT * (DISPLAY_COLOR_DEPTH / 8);
+
+void setUp() { frameDirtyRegions.clear(); }
+
+void tearDown()
+{
+  // テスト終了時の処理は不要
+}
+
+// 画面外の領域は切り捨てられることを確認
+void test_mark_rect_is_clipped_to_screen()
+{
+  DirtyRegionTracker tracker(LCD_WIDTH, LCD_HEIGHT);
+  tracker.markRect(-10, -10, 20, 20);
+  tracker.markRect(LCD_WIDTH + 5, 0, 10, 10);
+  TEST_ASSERT_EQUAL_INT(1, tracker.count());
+  TEST_ASSERT_EQUAL_INT(0, tracker.rect(0).x);
+  TEST_ASSERT_EQUAL_INT(0, tracker.rect(0).y);
+  TEST_ASSERT_EQUAL_INT(10, tracker.rect(0).w);
+  TEST_ASSERT_EQUAL_INT(10, tracker.rect(0).h);
+}
+
+// 重なる矩形は1つに統合され、離れた矩形は別々に残ることを確認
+void test_overlapping_rects_are_merged()
+{
+  DirtyRegionTracker tracker(LCD_WIDTH, LCD_HEIGHT);
+  tracker.markRect(10, 10, 20, 20);
+  tracker.markRect(20, 20, 20, 20);
+  TEST_ASSERT_EQUAL_INT(1, tracker.count());
+  TEST_ASSERT_EQUAL_INT(30 * 30 * 2, tracker.byteCount());
+
+  tracker.markRect(200, 200, 10, 10);
+  TEST_ASSERT_EQUAL_INT(2, tracker.count());
+}
+
+// 上限を超えた場合も全領域を覆ったまま矩形数が制限されることを確認
+void test_rect_count_is_bounded()
+{
+  DirtyRegionTracker tracker(LCD_WIDTH, LCD_HEIGHT);
+  for (int i = 0; i < 20; ++i)
+  {
+    tracker.markRect((i % 5) * 60, (i / 5) * 55, 4, 4);
+  }
+  TEST_ASSERT_LESS_OR_EQUAL(DirtyRegionTracker::MAX_RECTS, tracker.count());
+
+  // すべての点がいずれかの矩形に含まれる
+  for (int i = 0; i < 20; ++i)
+  {
+    int px = (i % 5) * 60;
+    int py = (i / 5) * 55;
+    bool covered = false;
+    for (int r = 0; r < tracker.count(); ++r)
+    {
+      const DirtyRect &rc = tracker.rect(r);
+      covered |= px >= rc.x && px < rc.x + rc.w && py >= rc.y && py < rc.y + rc.h;
+    }
+    TEST_ASSERT_TRUE(covered);
+  }
+}
+
+// 弧の外接矩形が角度範囲に応じて求まることを確認
+void test_mark_arc_bounding_box()
+{
+  DirtyRegionTracker tracker(LCD_WIDTH, LCD_HEIGHT);
+  // 右から下への 1/4 円（0〜90度）
+  tracker.markArc(100, 100, 60, 70, 0.0F, 90.0F);
+  TEST_ASSERT_EQUAL_INT(1, tracker.count());
+  const DirtyRect &r = tracker.rect(0);
+  TEST_ASSERT_INT_WITHIN(2, 100, r.x);
+  TEST_ASSERT_INT_WITHIN(2, 100, r.y);
+  TEST_ASSERT_INT_WITHIN(3, 70, r.w);
+  TEST_ASSERT_INT_WITHIN(3, 70, r.h);
+}
+
+// 油圧値が少し変化したフレームの転送量を全画面転送と比較
+void test_pressure_update_bytes_versus_full_frame()
+{
+  // 油圧ゲージ（x=0, y=60）の中心と 3.0→3.1bar 相当の角度
+  constexpr int CENTER_X = 71;
+  constexpr int CENTER_Y = 140;
+  float prevAngle = -270.0F + (3.0F / 10.0F * 270.0F);
+  float currAngle = -270.0F + (3.1F / 10.0F * 270.0F);
+  frameDirtyRegions.markArc(CENTER_X, CENTER_Y, 60, 70, prevAngle, currAngle);
+  // 数値表示領域
+  frameDirtyRegions.markRect(85, 165, 75, 39);
+
+  uint32_t bytes = frameDirtyRegions.byteCount();
+  char msg[120];
+  snprintf(msg, sizeof(msg), "pressure update: %lu bytes (full frame %lu bytes)", static_cast<unsigned long>(bytes),
+           static_cast<unsigned long>(FULL_FRAME_BYTES));
+  TEST_MESSAGE(msg);
+  TEST_ASSERT_LESS_THAN(FULL_FRAME_BYTES / 10, bytes);
+
+  // FPS 数値のみの更新
+  frameDirtyRegions.clear();
+  frameDirtyRegions.markRect(0, LCD_HEIGHT - 8, 30, 8);
+  TEST_ASSERT_EQUAL_INT(30 * 8 * 2, frameDirtyRegions.byteCount());
+}
+
+void setup()
+{
+  UNITY_BEGIN();
+  RUN_TEST(test_mark_rect_is_clipped_to_screen);
+  RUN_TEST(test_overlapping_rects_are_merged);
+  RUN_TEST(test_rect_count_is_bounded);
+  RUN_TEST(test_mark_arc_bounding_box);
+  RUN_TEST(test_pressure_update_bytes_versus_full_frame);
+  UNITY_END();
+}
+
+void loop()
+{
+  // ループ処理は不要
+}
@@ -0,0 +1,136 @@
+#include <unity.h>
+
+#include "../../include/config.h"
+#include "../../src/modules/display_list.h"
+
+constexpr int WIDTH = 160;
+constexpr int HEIGHT = 80;
+
+static M5Canvas listCanvas;
+static M5Canvas directCanvas;
+
+static auto countMismatchedPixels() -> int
+{
+  int mismatched = 0;
+  for (int y = 0; y < HEIGHT; ++y)
+  {
+    for (int x = 0; x < WIDTH; ++x)
+    {
+      if (listCanvas.readPixel(x, y) != directCanvas.readPixel(x, y))
+      {
+        ++mismatched;
+      }
+    }
+  }
+  return mismatched;
+}
+
+void setUp()
+{
+  listCanvas.createSprite(WIDTH, HEIGHT);
+  directCanvas.createSprite(WIDTH, HEIGHT);
+}
+
+void tearDown()
+{
+  // テスト終了時の処理は不要
+}
+
+// 図形が先に並び、文字は最初に現れた順のフォントごとにまとまることを確認
+void test_seal_groups_fonts()
+{
+  DisplayList<8> list;
+  list.text(&fonts::FreeSansBold12pt7b, 0, 0, COLOR_WHITE, "A");
+  list.text(&fonts::Font0, 0, 30, COLOR_WHITE, "B");
+  list.text(&fonts::FreeSansBold12pt7b, 0, 40, COLOR_WHITE, "C");
+  list.drawRect(0, 0, WIDTH, HEIGHT, COLOR_GRAY);
+  list.field(&fonts::Font0, WIDTH, 60, COLOR_WHITE, 0);
+  TEST_ASSERT_FALSE(list.isRecorded());
+  list.seal();
+  TEST_ASSERT_TRUE(list.isRecorded());
+
+  TEST_ASSERT_EQUAL_INT(5, static_cast<int>(list.size()));
+  TEST_ASSERT_TRUE(list.op(0).kind == DisplayOp::Kind::Rect);
+  TEST_ASSERT_EQUAL_STRING("A", list.op(1).text);
+  TEST_ASSERT_EQUAL_STRING("C", list.op(2).text);
+  TEST_ASSERT_EQUAL_STRING("B", list.op(3).text);
+  TEST_ASSERT_TRUE(list.op(4).kind == DisplayOp::Kind::Field);
+}
+
+// 再生結果が同じ内容を直接描いた場合と画素単位で一致し、右揃えの位置が解決されていることを確認
+void test_replay_matches_direct_drawing()
+{
+  DisplayList<8> list;
+  list.fillScreen(COLOR_BLACK);
+  list.drawRect(0, 0, WIDTH, HEIGHT, COLOR_GRAY);
+  list.text(&fonts::FreeSansBold12pt7b, 4, 4, COLOR_WHITE, "MAX:");
+  list.rightText(listCanvas, &fonts::Font0, WIDTH - 4, 40, COLOR_YELLOW, "Disabled");
+  list.field(&fonts::FreeSansBold12pt7b, WIDTH - 4, 4, COLOR_WHITE, 0);
+  list.field(&fonts::Font0, WIDTH - 4, 60, COLOR_WHITE, 1);
+  list.seal();
+  const char *fields[] = {"98.5", nullptr};
+  list.replay(listCanvas, fields);
+
+  directCanvas.fillScreen(COLOR_BLACK);
+  directCanvas.drawRect(0, 0, WIDTH, HEIGHT, COLOR_GRAY);
+  directCanvas.setFont(&fonts::FreeSansBold12pt7b);
+  directCanvas.setTextColor(COLOR_WHITE);
+  directCanvas.setCursor(4, 4);
+  directCanvas.print("MAX:");
+  directCanvas.drawRightString("98.5", WIDTH - 4, 4);
+  directCanvas.setFont(&fonts::Font0);
+  directCanvas.setTextColor(COLOR_YELLOW);
+  directCanvas.drawRightString("Disabled", WIDTH - 4, 40);
+
+  TEST_ASSERT_EQUAL_INT(0, countMismatchedPixels());
+  // 値の無い欄（nullptr）は描かない
+  TEST_ASSERT_EQUAL_UINT32(3, listCanvas.stats.textCalls);
+}
+
+// 欄の文字列を変えて再生し直すと、その値だけが変わることを確認
+void test_replay_patches_fields()
+{
+  DisplayList<4> list;
+  list.fillScreen(COLOR_BLACK);
+  list.field(&fonts::Font0, WIDTH, 0, COLOR_WHITE, 0);
+  list.seal();
+  const char *first[] = {"1234"};
+  list.replay(listCanvas, first);
+  const char *second[] = {"7"};
+  list.replay(listCanvas, second);
+
+  directCanvas.fillScreen(COLOR_BLACK);
+  directCanvas.setFont(&fonts::Font0);
+  directCanvas.setTextColor(COLOR_WHITE);
+  directCanvas.drawRightString("7", WIDTH, 0);
+  TEST_ASSERT_EQUAL_INT(0, countMismatchedPixels());
+}
+
+// 容量を超えた命令は記録できず失敗を返し、記録し直すと封印と失敗が解けることを確認
+void test_capacity_is_fixed()
+{
+  DisplayList<2> list;
+  TEST_ASSERT_TRUE(list.fillScreen(COLOR_BLACK));
+  TEST_ASSERT_TRUE(list.drawRect(0, 0, 10, 10, COLOR_WHITE));
+  TEST_ASSERT_FALSE(list.drawRect(0, 0, 20, 20, COLOR_WHITE));
+  TEST_ASSERT_EQUAL_INT(2, static_cast<int>(list.size()));
+  TEST_ASSERT_EQUAL_INT(10, list.op(1).w);
+  TEST_ASSERT_FALSE(list.seal());
+  list.clear();
+  TEST_ASSERT_FALSE(list.isRecorded());
+  TEST_ASSERT_EQUAL_INT(0, static_cast<int>(list.size()));
+  TEST_ASSERT_TRUE(list.fillScreen(COLOR_BLACK));
+  TEST_ASSERT_TRUE(list.seal());
+}
+
+void setup()
+{
+  UNITY_BEGIN();
+  RUN_TEST(test_seal_groups_fonts);
+  RUN_TEST(test_replay_matches_direct_drawing);
+  RUN_TEST(test_replay_patches_fields);
+  RUN_TEST(test_capacity_is_fixed);
+  UNITY_END();
+}
+
+void loop() {}
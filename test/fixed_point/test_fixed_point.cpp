@@ -0,0 +1,214 @@
+#include <unity.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <limits>
+
+#include "../../include/config.h"
+#include "../../src/modules/fixed_point.h"
+
+// ────────────────────── テスト用の型と乱数 ──────────────────────
+using PressureQ = Fixed<20>;
+using TemperatureQ = Fixed<16>;
+
+// 再現性のある一様乱数 [lo, hi)
+static uint32_t rngState = 1;
+static auto nextRandom(float lo, float hi) -> float
+{
+  rngState = (rngState * 1664525U) + 1013904223U;
+  return lo + ((hi - lo) * static_cast<float>(rngState >> 8) / static_cast<float>(1U << 24));
+}
+
+// 従来の float による油圧の平均・制限・平滑化（updateGauges と同じ手順）
+struct FloatPressureChain
+{
+  float samples[PRESSURE_SAMPLE_SIZE] = {};
+  int index = 0;
+  float smooth = std::numeric_limits<float>::quiet_NaN();
+
+  auto update(float sample) -> float
+  {
+    samples[index] = sample;
+    index = (index + 1) % PRESSURE_SAMPLE_SIZE;
+    float sum = 0.0F;
+    for (float v : samples)
+    {
+      sum += v;
+    }
+    float average = std::min(sum / PRESSURE_SAMPLE_SIZE, MAX_OIL_PRESSURE_DISPLAY);
+    if (std::isnan(smooth))
+    {
+      smooth = average;
+    }
+    smooth += OIL_PRESSURE_SMOOTHING_ALPHA * (average - smooth);
+    return smooth;
+  }
+};
+
+// 固定小数点による同じ手順
+struct FixedPressureChain
+{
+  FixedMovingAverage<PressureQ, PRESSURE_SAMPLE_SIZE> average;
+  FixedEma<PressureQ> smooth{PressureQ::fromFloat(OIL_PRESSURE_SMOOTHING_ALPHA)};
+
+  auto update(float sample) -> float
+  {
+    average.push(PressureQ::fromFloat(sample));
+    PressureQ limited = std::min(average.average(), PressureQ::fromFloat(MAX_OIL_PRESSURE_DISPLAY));
+    return smooth.update(limited).toFloat();
+  }
+};
+
+void setUp() { rngState = 1; }
+
+void tearDown()
+{
+  // テスト終了時の処理は不要
+}
+
+// float との相互変換は 0.5LSB 以内で、範囲外は飽和することを確認
+void test_conversion_round_trip()
+{
+  for (int i = 0; i < 100000; ++i)
+  {
+    float v = nextRandom(-200.0F, 200.0F);
+    TemperatureQ q = TemperatureQ::fromFloat(v);
+    TEST_ASSERT_FLOAT_WITHIN(TemperatureQ::epsilon() * 0.5F + (std::fabs(v) * 1e-7F), v, q.toFloat());
+  }
+  TEST_ASSERT_EQUAL_INT32(INT32_MAX, PressureQ::fromFloat(5000.0F).raw());
+  TEST_ASSERT_EQUAL_INT32(INT32_MIN, PressureQ::fromFloat(-5000.0F).raw());
+  TEST_ASSERT_EQUAL_INT(-3, TemperatureQ::fromFloat(-3.7F).toInt());
+  TEST_ASSERT_EQUAL_INT(98, TemperatureQ::fromFloat(98.9F).toInt());
+}
+
+// 乗算は倍精度の結果から 1LSB 以内に丸められることを確認（float では桁が足りないため raw で比べる）
+void test_multiply_rounding()
+{
+  double worst = 0.0;
+  for (int i = 0; i < 100000; ++i)
+  {
+    PressureQ a = PressureQ::fromFloat(nextRandom(-40.0F, 40.0F));
+    PressureQ b = PressureQ::fromFloat(nextRandom(-1.0F, 1.0F));
+    double expected = static_cast<double>(a.raw()) * b.raw() / PressureQ::ONE;
+    worst = std::max(worst, std::fabs(static_cast<double>((a * b).raw()) - expected));
+  }
+  TEST_ASSERT_TRUE(worst <= 1.0);
+}
+
+// 移動平均は float の配列平均と 1LSB 程度で一致し、長時間でも誤差が累積しないことを確認
+void test_moving_average_matches_float()
+{
+  FixedMovingAverage<PressureQ, PRESSURE_SAMPLE_SIZE> average;
+  float samples[PRESSURE_SAMPLE_SIZE] = {};
+  float worst = 0.0F;
+  for (int i = 0; i < 1000000; ++i)
+  {
+    float v = nextRandom(0.0F, 12.0F);
+    samples[i % PRESSURE_SAMPLE_SIZE] = v;
+    average.push(PressureQ::fromFloat(v));
+    float expected = 0.0F;
+    for (float s : samples)
+    {
+      expected += s;
+    }
+    expected /= PRESSURE_SAMPLE_SIZE;
+    worst = std::max(worst, std::fabs(average.average().toFloat() - expected));
+  }
+  TEST_ASSERT_LESS_THAN_FLOAT(4e-6F, worst);
+
+  average.fill(PressureQ::fromFloat(3.25F));
+  TEST_ASSERT_EQUAL_FLOAT(3.25F, average.average().toFloat());
+}
+
+// 油圧の平均・制限・平滑化の連鎖全体が、従来の float の結果と表示分解能より十分小さい差で一致することを確認
+void test_pressure_chain_matches_float()
+{
+  FloatPressureChain floatChain;
+  FixedPressureChain fixedChain;
+  float pressure = 3.0F;
+  float worst = 0.0F;
+  // 60fps で約 1 時間分。過電圧付近 (上限 15bar 超) も通る
+  for (int frame = 0; frame < 60 * 3600; ++frame)
+  {
+    pressure = std::min(std::max(pressure + nextRandom(-0.4F, 0.4F), 0.0F), 16.0F);
+    worst = std::max(worst, std::fabs(fixedChain.update(pressure) - floatChain.update(pressure)));
+  }
+  // 表示の更新閾値 0.05bar に対して十分小さい
+  TEST_ASSERT_LESS_THAN_FLOAT(1e-4F, worst);
+
+  char message[64];
+  snprintf(message, sizeof(message), "pressure chain: max |fixed - float| = %.2e bar", worst);
+  TEST_MESSAGE(message);
+}
+
+// 温度の平滑化 (係数 0.1) も float と一致することを確認
+void test_temperature_ema_matches_float()
+{
+  FixedEma<TemperatureQ> ema(TemperatureQ::fromFloat(TEMP_SMOOTHING_ALPHA));
+  float smooth = std::numeric_limits<float>::quiet_NaN();
+  float worst = 0.0F;
+  float temp = 80.0F;
+  for (int frame = 0; frame < 60 * 3600; ++frame)
+  {
+    temp = std::min(std::max(temp + nextRandom(-0.2F, 0.2F), -40.0F), 150.0F);
+    if (std::isnan(smooth))
+    {
+      smooth = temp;
+    }
+    smooth += TEMP_SMOOTHING_ALPHA * (temp - smooth);
+    worst = std::max(worst, std::fabs(ema.update(TemperatureQ::fromFloat(temp)).toFloat() - smooth));
+  }
+  TEST_ASSERT_LESS_THAN_FLOAT(1e-3F, worst);
+}
+
+// 1 サンプルあたりの処理時間を float と固定小数点で比較する（ホストでの参考値）
+void test_microbenchmark_per_sample_cost()
+{
+  constexpr int ITERATIONS = 2000000;
+  static float inputs[1024];
+  for (float &v : inputs)
+  {
+    v = nextRandom(0.0F, 12.0F);
+  }
+
+  FloatPressureChain floatChain;
+  FixedPressureChain fixedChain;
+  volatile float sink = 0.0F;
+
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < ITERATIONS; ++i)
+  {
+    sink = floatChain.update(inputs[i & 1023]);
+  }
+  auto floatEnd = std::chrono::steady_clock::now();
+  for (int i = 0; i < ITERATIONS; ++i)
+  {
+    sink = fixedChain.update(inputs[i & 1023]);
+  }
+  auto fixedEnd = std::chrono::steady_clock::now();
+
+  (void)sink;
+
+  auto nsPerSample = [](std::chrono::steady_clock::duration d)
+  { return std::chrono::duration<double, std::nano>(d).count() / ITERATIONS; };
+  char message[128];
+  snprintf(message, sizeof(message), "per sample: float chain %.1f ns, fixed chain %.1f ns",
+           nsPerSample(floatEnd - start), nsPerSample(fixedEnd - floatEnd));
+  TEST_MESSAGE(message);
+}
+
+void setup()
+{
+  UNITY_BEGIN();
+  RUN_TEST(test_conversion_round_trip);
+  RUN_TEST(test_multiply_rounding);
+  RUN_TEST(test_moving_average_matches_float);
+  RUN_TEST(test_pressure_chain_matches_float);
+  RUN_TEST(test_temperature_ema_matches_float);
+  RUN_TEST(test_microbenchmark_per_sample_cost);
+  UNITY_END();
+}
+
+void loop() {}
@@ -0,0 +1,116 @@
+#include <unity.h>
+
+#include <cstring>
+
+#include "../../src/modules/frame_profiler.cpp"
+
+// テストから進める疑似サイクルカウンタ（1us = 240 サイクル）
+static uint32_t fakeCycles = 0;
+static auto readFakeCycles() -> uint32_t { return fakeCycles; }
+constexpr uint32_t CYCLES_PER_US = 240;
+
+void setUp() { fakeCycles = 0; }
+
+void tearDown()
+{
+  // テスト終了時の処理は不要
+}
+
+// 値は必ず自身を含むバケットへ入り、上限は隣のバケットと連続することを確認
+void test_bucket_bounds_are_contiguous()
+{
+  uint32_t previousUpper = 0;
+  for (int b = 1; b < LatencyHistogram::BUCKET_COUNT; ++b)
+  {
+    uint32_t upper = LatencyHistogram::bucketUpperBound(b);
+    TEST_ASSERT_EQUAL_INT(b, LatencyHistogram::bucketOf(previousUpper + 1));
+    TEST_ASSERT_EQUAL_INT(b, LatencyHistogram::bucketOf(upper));
+    previousUpper = upper;
+  }
+  // 範囲外の大きな値は最後のバケットにまとめる
+  TEST_ASSERT_EQUAL_INT(LatencyHistogram::BUCKET_COUNT - 1, LatencyHistogram::bucketOf(0xFFFFFFFFU));
+}
+
+// パーセンタイルが実値から 25% 以内に収まることを確認
+void test_percentiles_within_bucket_error()
+{
+  LatencyHistogram h;
+  // 1〜1000us を一様に記録
+  for (uint32_t us = 1; us <= 1000; ++us)
+  {
+    h.record(us);
+  }
+  TEST_ASSERT_EQUAL_INT(1000, h.count());
+  TEST_ASSERT_EQUAL_INT(1000, h.max());
+  uint32_t p50 = h.percentile(50);
+  uint32_t p99 = h.percentile(99);
+  TEST_ASSERT_TRUE(p50 >= 500 && p50 <= 625);
+  TEST_ASSERT_TRUE(p99 >= 990 && p99 <= 1000);
+
+  h.reset();
+  TEST_ASSERT_EQUAL_INT(0, h.percentile(50));
+  TEST_ASSERT_EQUAL_INT(0, h.count());
+  TEST_ASSERT_EQUAL_INT(0, h.max());
+
+  // リセットは次の記録時に記録する側で行われ、それ以前の値は残らない
+  h.record(40);
+  TEST_ASSERT_EQUAL_INT(1, h.count());
+  TEST_ASSERT_EQUAL_INT(40, h.max());
+  TEST_ASSERT_EQUAL_INT(40, h.percentile(99));
+}
+
+// 区間計測と締め切り超過の判定を確認
+void test_stage_timing_and_deadline_misses()
+{
+  FrameProfiler profiler(readFakeCycles, CYCLES_PER_US);
+
+  // 1 フレーム目: 描画 3ms、全体 10ms
+  profiler.beginFrame();
+  {
+    ProfileScope scope(profiler, ProfileStage::Gauge);
+    fakeCycles += 3000 * CYCLES_PER_US;
+  }
+  fakeCycles += 7000 * CYCLES_PER_US;
+  profiler.endFrame();
+
+  // 2 フレーム目: 全体 20ms で締め切り超過
+  profiler.beginFrame();
+  fakeCycles += 20000 * CYCLES_PER_US;
+  profiler.endFrame();
+
+  TEST_ASSERT_EQUAL_INT(3000, profiler.histogram(ProfileStage::Gauge).max());
+  TEST_ASSERT_EQUAL_INT(2, profiler.histogram(ProfileStage::Frame).count());
+  TEST_ASSERT_EQUAL_INT(20000, profiler.histogram(ProfileStage::Frame).max());
+  TEST_ASSERT_EQUAL_INT(1, profiler.deadlineMisses());
+
+  char text[32];
+  profiler.formatStage(ProfileStage::Gauge, text, sizeof(text));
+  TEST_ASSERT_EQUAL_STRING("GAU 3000/3000/3000", text);
+
+  profiler.reset();
+  TEST_ASSERT_EQUAL_INT(0, profiler.deadlineMisses());
+  TEST_ASSERT_EQUAL_INT(0, profiler.histogram(ProfileStage::Frame).count());
+}
+
+// サイクルカウンタが一周しても経過時間を正しく求めることを確認
+void test_cycle_counter_wraparound()
+{
+  FrameProfiler profiler(readFakeCycles, CYCLES_PER_US);
+  fakeCycles = 0xFFFFFFFFU - (100 * CYCLES_PER_US) + 1;
+  uint32_t start = profiler.cycles();
+  fakeCycles += 500 * CYCLES_PER_US;
+  profiler.recordSince(ProfileStage::Push, start);
+  TEST_ASSERT_EQUAL_INT(500, profiler.histogram(ProfileStage::Push).max());
+}
+
+void setup()
+{
+  UNITY_BEGIN();
+  RUN_TEST(test_bucket_bounds_are_contiguous);
+  RUN_TEST(test_percentiles_within_bucket_error);
+  RUN_TEST(test_stage_timing_and_deadline_misses);
+  RUN_TEST(test_cycle_counter_wraparound);
+  UNITY_END();
+}
+
+void loop() {}
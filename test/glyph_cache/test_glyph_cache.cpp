@@ -0,0 +1,144 @@
+#include <unity.h>
+
+#include <cstdio>
+
+#include "../../include/config.h"
+#include "../../src/modules/dirty_region.cpp"
+#include "../../src/modules/glyph_cache.cpp"
+
+// ホストの M5GFX は固定幅・矩形グリフの疑似フォントで、実機の FreeSansBold24pt7b とは字形も字幅も違う。
+// このテストが確かめるのはキャッシュの作成・右揃え・桁ごとの複写・更新領域の記録で、比較相手も同じ疑似フォントになる。
+// 実フォントでの字幅（プロポーショナル幅）やベースラインとの一致は確かめていない
+
+constexpr int FIELD_RIGHT = 160;
+constexpr int FIELD_TOP = 150;
+constexpr int FIELD_WIDTH = 85;
+
+static DigitGlyphCache glyphs;
+static M5Canvas fieldCanvas;
+static M5Canvas fontCanvas;
+
+// 従来の描き方（欄を黒で塗り、フォントで右揃えに描く）
+static void drawWithFont(const char *text)
+{
+  fontCanvas.fillRect(FIELD_RIGHT - FIELD_WIDTH, FIELD_TOP, FIELD_WIDTH, fontCanvas.fontHeight(), canvasColor(COLOR_BLACK));
+  fontCanvas.setCursor(FIELD_RIGHT - fontCanvas.textWidth(text), FIELD_TOP);
+  fontCanvas.print(text);
+}
+
+static auto countMismatchedPixels() -> int
+{
+  int mismatched = 0;
+  for (int y = 0; y < LCD_HEIGHT; ++y)
+  {
+    for (int x = 0; x < LCD_WIDTH; ++x)
+    {
+      if (fieldCanvas.readPixel(x, y) != fontCanvas.readPixel(x, y))
+      {
+        ++mismatched;
+      }
+    }
+  }
+  return mismatched;
+}
+
+void setUp()
+{
+  glyphs.build(&FreeSansBold24pt7b, canvasColor(COLOR_WHITE), canvasColor(COLOR_BLACK));
+  fieldCanvas.setColorDepth(CANVAS_COLOR_DEPTH);
+  fontCanvas.setColorDepth(CANVAS_COLOR_DEPTH);
+  fieldCanvas.createSprite(LCD_WIDTH, LCD_HEIGHT);
+  fontCanvas.createSprite(LCD_WIDTH, LCD_HEIGHT);
+  fontCanvas.setFont(&FreeSansBold24pt7b);
+  fontCanvas.setTextColor(canvasColor(COLOR_WHITE));
+  frameDirtyRegions.clear();
+}
+
+void tearDown()
+{
+  // テスト終了時の処理は不要
+}
+
+// 全グリフが用意され、インクの行範囲が文字セルに収まることを確認
+void test_build_rasterizes_all_glyphs()
+{
+  TEST_ASSERT_TRUE(glyphs.isReady());
+  TEST_ASSERT_EQUAL_INT(fontCanvas.fontHeight(), glyphs.cellHeight());
+  TEST_ASSERT_GREATER_THAN(0, glyphs.inkHeight());
+  TEST_ASSERT_TRUE(glyphs.inkTop() + glyphs.inkHeight() <= glyphs.cellHeight());
+  for (int i = 0; i < DigitGlyphCache::GLYPH_COUNT; ++i)
+  {
+    char text[2] = {DigitGlyphCache::GLYPHS[i], '\0'};
+    TEST_ASSERT_EQUAL_INT(i, DigitGlyphCache::indexOf(text[0]));
+    TEST_ASSERT_EQUAL_INT(fontCanvas.textWidth(text), glyphs.glyphWidth(i));
+  }
+  TEST_ASSERT_EQUAL_INT(-1, DigitGlyphCache::indexOf('e'));
+}
+
+// 桁数や小数点の位置が変わる値の列で、フォントで描いた結果と画素単位で一致することを確認
+void test_field_matches_font_rendering()
+{
+  const char *values[] = {"0.0", "3.5", "3.6", "9.9", "10", "12", "120", "95", "-3", "7.5", "7.5", "118"};
+  GlyphField field(glyphs, FIELD_RIGHT, FIELD_TOP, FIELD_WIDTH);
+  for (const char *value : values)
+  {
+    TEST_ASSERT_TRUE(field.draw(fieldCanvas, value));
+    drawWithFont(value);
+    TEST_ASSERT_EQUAL_INT(0, countMismatchedPixels());
+  }
+}
+
+// 1 桁だけ変わった場合はその桁だけを複写し、フォント描画も塗りつぶしも行わないことを確認
+void test_only_changed_glyph_is_copied()
+{
+  GlyphField field(glyphs, FIELD_RIGHT, FIELD_TOP, FIELD_WIDTH);
+  field.draw(fieldCanvas, "9.5");
+  frameDirtyRegions.clear();
+  fieldCanvas.stats.reset();
+
+  TEST_ASSERT_TRUE(field.draw(fieldCanvas, "9.6"));
+  TEST_ASSERT_EQUAL_INT(0, fieldCanvas.stats.textCalls);
+  TEST_ASSERT_EQUAL_INT(0, fieldCanvas.stats.fillCalls);
+  uint32_t expected = glyphs.glyphWidth(DigitGlyphCache::indexOf('6')) * glyphs.inkHeight() * sizeof(uint16_t);
+  TEST_ASSERT_EQUAL_UINT32(expected, frameDirtyRegions.byteCount());
+
+  // 同じ値では何も描かない
+  frameDirtyRegions.clear();
+  TEST_ASSERT_TRUE(field.draw(fieldCanvas, "9.6"));
+  TEST_ASSERT_TRUE(frameDirtyRegions.isEmpty());
+
+  char message[64];
+  snprintf(message, sizeof(message), "one digit: %u bytes copied", static_cast<unsigned>(expected));
+  TEST_MESSAGE(message);
+}
+
+// キャッシュに無い文字や欄に収まらない文字列は描かずに false を返し、次回は欄全体を描き直すことを確認
+void test_unsupported_text_is_rejected()
+{
+  GlyphField field(glyphs, FIELD_RIGHT, FIELD_TOP, FIELD_WIDTH);
+  field.draw(fieldCanvas, "12");
+  fieldCanvas.stats.reset();
+  TEST_ASSERT_FALSE(field.draw(fieldCanvas, "1e5"));
+  TEST_ASSERT_FALSE(field.draw(fieldCanvas, "12345"));
+  TEST_ASSERT_EQUAL_INT(0, fieldCanvas.stats.fillCalls);
+
+  TEST_ASSERT_TRUE(field.draw(fieldCanvas, "12"));
+  TEST_ASSERT_EQUAL_INT(1, fieldCanvas.stats.fillCalls);
+
+  // 未構築のキャッシュでは常にフォントへ任せる
+  DigitGlyphCache empty;
+  GlyphField unready(empty, FIELD_RIGHT, FIELD_TOP, FIELD_WIDTH);
+  TEST_ASSERT_FALSE(unready.draw(fieldCanvas, "12"));
+}
+
+void setup()
+{
+  UNITY_BEGIN();
+  RUN_TEST(test_build_rasterizes_all_glyphs);
+  RUN_TEST(test_field_matches_font_rendering);
+  RUN_TEST(test_only_changed_glyph_is_copied);
+  RUN_TEST(test_unsupported_text_is_rejected);
+  UNITY_END();
+}
+
+void loop() {}
@@ -0,0 +1,34 @@
+#ifndef HEADLESS_ADAFRUIT_ADS1X15_H
+#define HEADLESS_ADAFRUIT_ADS1X15_H
+
+// ────────────────────── ホスト用 ADS1x15 代替 ──────────────────────
+// 実デバイスは接続しない。ホストでの変換結果は AdcDevice の差し替え（トレース再生など）で与える
+
+#include <cstdint>
+
+constexpr uint16_t ADS1X15_REG_CONFIG_MUX_SINGLE_0 = 0x4000;
+constexpr uint16_t ADS1X15_REG_CONFIG_MUX_SINGLE_1 = 0x5000;
+constexpr uint16_t ADS1X15_REG_CONFIG_MUX_SINGLE_2 = 0x6000;
+constexpr uint16_t ADS1X15_REG_CONFIG_MUX_SINGLE_3 = 0x7000;
+constexpr uint16_t RATE_ADS1015_1600SPS = 0x0080;
+constexpr uint16_t RATE_ADS1115_860SPS = 0x00E0;
+
+class Adafruit_ADS1X15
+{
+ public:
+  auto begin(uint8_t /*address*/ = 0x48) -> bool { return false; }
+  void setDataRate(uint16_t /*rate*/) {}
+  void startADCReading(uint16_t /*mux*/, bool /*continuous*/) {}
+  auto conversionComplete() -> bool { return true; }
+  auto getLastConversionResults() -> int16_t { return 0; }
+};
+
+class Adafruit_ADS1015 : public Adafruit_ADS1X15
+{
+};
+
+class Adafruit_ADS1115 : public Adafruit_ADS1X15
+{
+};
+
+#endif  // HEADLESS_ADAFRUIT_ADS1X15_H
@@ -0,0 +1,58 @@
+#ifndef HEADLESS_ARDUINO_H
+#define HEADLESS_ARDUINO_H
+
+// ────────────────────── ホスト用 Arduino 代替 ──────────────────────
+// 描画経路とセンサー取得をネイティブ環境でビルドするための最小限の代替。
+// 時刻はテストから headlessNowUs を進めて制御する
+
+#include <cstdarg>
+#include <cstdint>
+#include <cstdio>
+
+#ifndef F_CPU
+#define F_CPU 240000000UL
+#endif
+
+inline unsigned long headlessNowUs = 0;
+
+inline auto millis() -> unsigned long { return headlessNowUs / 1000UL; }
+inline auto micros() -> unsigned long { return headlessNowUs; }
+inline void delay(unsigned long ms) { headlessNowUs += ms * 1000UL; }
+inline void delayMicroseconds(unsigned long us) { headlessNowUs += us; }
+
+// シリアル出力は捨てる（テスト結果の出力を汚さない）
+class HeadlessSerial
+{
+ public:
+  void begin(unsigned long /*baud*/) {}
+  void print(const char * /*text*/) {}
+  void println(const char * /*text*/ = "") {}
+  auto printf(const char * /*format*/, ...) -> int { return 0; }
+  auto available() -> int { return 0; }
+  auto read() -> int { return -1; }
+};
+
+inline HeadlessSerial Serial;
+
+// ────────────────────── FreeRTOS の代替 ──────────────────────
+// 単一スレッドで実行するため、ミューテックスは常に取得できタスクは生成しない
+using SemaphoreHandle_t = void *;
+using TickType_t = uint32_t;
+using TaskFunction_t = void (*)(void *);
+using TaskHandle_t = void *;
+constexpr TickType_t portMAX_DELAY = 0xFFFFFFFFU;
+
+inline auto xSemaphoreCreateMutex() -> SemaphoreHandle_t { return nullptr; }
+inline auto xSemaphoreTake(SemaphoreHandle_t /*mutex*/, TickType_t /*ticks*/) -> int { return 1; }
+inline auto xSemaphoreGive(SemaphoreHandle_t /*mutex*/) -> int { return 1; }
+inline auto xTaskGetTickCount() -> TickType_t { return static_cast<TickType_t>(millis()); }
+inline void vTaskDelayUntil(TickType_t *lastWake, TickType_t ticks) { *lastWake += ticks; }
+inline constexpr auto pdMS_TO_TICKS(uint32_t ms) -> TickType_t { return ms; }
+inline auto xTaskCreatePinnedToCore(TaskFunction_t /*task*/, const char * /*name*/, uint32_t /*stack*/,
+                                    void * /*param*/, unsigned /*priority*/, TaskHandle_t * /*handle*/,
+                                    int /*core*/) -> int
+{
+  return 1;
+}
+
+#endif  // HEADLESS_ARDUINO_H
@@ -0,0 +1,69 @@
+#ifndef HEADLESS_M5CORES3_H
+#define HEADLESS_M5CORES3_H
+
+// 描画経路 (fps_display.cpp / backlight.cpp) とセンサー取得 (sensor.cpp) が参照する範囲のみの代替
+
+#include <Arduino.h>
+#include <M5GFX.h>
+
+struct HeadlessLtr553
+{
+  int alsValue = 0;  // テストから設定する照度
+  auto getAlsValue() -> int { return alsValue; }
+};
+
+struct HeadlessCoreS3
+{
+  HeadlessLtr553 Ltr553;
+};
+
+inline HeadlessCoreS3 CoreS3;
+
+namespace m5
+{
+enum imu_t
+{
+  imu_none,
+  imu_unknown,
+  imu_bmi270,
+};
+}  // namespace m5
+
+struct HeadlessImu
+{
+  float accel[3] = {0.0F, 0.0F, 1.0F};  // テストから設定する加速度 [G]
+  // FIFO を持たない IMU として振る舞う
+  auto getType() const -> m5::imu_t { return m5::imu_t::imu_none; }
+  auto getAccelData(float *ax, float *ay, float *az) -> bool
+  {
+    *ax = accel[0];
+    *ay = accel[1];
+    *az = accel[2];
+    return true;
+  }
+};
+
+// 内部 I2C。接続されたデバイスは無い
+struct HeadlessI2c
+{
+  auto readRegister(uint8_t /*address*/, uint8_t /*reg*/, uint8_t * /*data*/, size_t /*length*/,
+                    uint32_t /*freq*/) -> bool
+  {
+    return false;
+  }
+  auto readRegister8(uint8_t /*address*/, uint8_t /*reg*/, uint32_t /*freq*/) -> uint8_t { return 0; }
+  auto writeRegister8(uint8_t /*address*/, uint8_t /*reg*/, uint8_t /*value*/, uint32_t /*freq*/) -> bool
+  {
+    return false;
+  }
+};
+
+struct HeadlessM5
+{
+  HeadlessImu Imu;
+  HeadlessI2c In_I2C;
+};
+
+inline HeadlessM5 M5;
+
+#endif  // HEADLESS_M5CORES3_H
@@ -0,0 +1,521 @@
+#ifndef HEADLESS_M5GFX_H
+#define HEADLESS_M5GFX_H
+
+// ────────────────────── ホスト用 M5GFX 代替 ──────────────────────
+// メモリ上のバッファへ描画し、塗り回数・書き込み画素数・転送バイト数を数える。
+// スプライトは RGB565 (16bit) のほか 8bit / 4bit のパレット形式に対応し、実機と同じく行を詰めて保持する。
+// 文字はフォントごとの固定セルに決定的な疑似グリフを描くため、画素数の比較に使える
+
+#include <Arduino.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdarg>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+namespace lgfx
+{
+// パネルと同じバイト順の RGB565（ホストではバイト順を入れ替えない）
+struct swap565_t
+{
+  uint16_t raw;
+
+  swap565_t() = default;
+  constexpr swap565_t(uint8_t r, uint8_t g, uint8_t b)
+      : raw(static_cast<uint16_t>(((r & 0xF8) << 8) | ((g & 0xFC) << 3) | (b >> 3)))
+  {
+  }
+};
+
+// パレット形式の色深度（下位 8bit が 1 画素のビット数）
+enum color_depth_t : uint16_t
+{
+  palette_4bit = 4 | 0x0800,
+  palette_8bit = 8 | 0x0800,
+  rgb565_2Byte = 16,
+};
+}  // namespace lgfx
+
+namespace m5gfx
+{
+enum class textdatum_t : uint8_t
+{
+  top_left,
+  top_center,
+  top_right,
+  middle_left,
+  middle_center,
+  middle_right,
+  bottom_left,
+  bottom_center,
+  bottom_right,
+};
+
+// 固定幅の疑似フォント（実フォントの平均的な字幅・行送りと、数字の描画高さ）
+struct HeadlessFont
+{
+  int glyphWidth;
+  int glyphHeight;
+  int inkHeight;
+};
+
+namespace fonts
+{
+inline constexpr HeadlessFont Font0 = {6, 8, 8};
+inline constexpr HeadlessFont FreeSansBold12pt7b = {14, 29, 19};
+inline constexpr HeadlessFont FreeSansBold24pt7b = {27, 56, 36};
+}  // namespace fonts
+}  // namespace m5gfx
+
+namespace lgfx
+{
+using IFont = m5gfx::HeadlessFont;
+}  // namespace lgfx
+
+using namespace m5gfx;
+using namespace m5gfx::fonts;
+
+// 描画・転送の計測値
+struct HeadlessStats
+{
+  uint32_t fillCalls = 0;      // 塗りつぶし系の呼び出し回数
+  uint32_t textCalls = 0;      // 文字列描画の呼び出し回数
+  uint64_t pixelsTouched = 0;  // 書き込んだ画素数
+  uint32_t pushCalls = 0;      // パネルへの転送回数
+  uint64_t bytesPushed = 0;    // パネルへ転送したバイト数
+  uint32_t dmaWaits = 0;       // DMA 転送の完了待ちの回数
+
+  void reset() { *this = HeadlessStats(); }
+};
+
+// ────────────────────── 描画面 ──────────────────────
+class HeadlessSurface
+{
+ public:
+  auto width() const -> int { return surfaceWidth; }
+  auto height() const -> int { return surfaceHeight; }
+  // 実機と同様、未確保（deleteSprite 後を含む）なら nullptr
+  auto getBuffer() -> void * { return bytes.empty() ? nullptr : bytes.data(); }
+  auto getBuffer() const -> const void * { return bytes.empty() ? nullptr : bytes.data(); }
+  auto bufferLength() const -> size_t { return bytes.size(); }
+  // パレット形式では画素のパレット番号を RGB565 へ展開して返す
+  auto readPixel(int x, int y) const -> uint16_t
+  {
+    uint16_t raw = loadRaw(x, y);
+    return isPalette() ? palette[raw] : raw;
+  }
+
+  // 16 以外はパレット形式（createSprite の前に呼ぶ）
+  void setColorDepth(int depth) { bitsPerPixel = depth & 0xFF; }
+  auto getColorDepth() const -> int { return bitsPerPixel; }
+  void createPalette() { palette.assign(static_cast<size_t>(1) << bitsPerPixel, 0); }
+  void setPaletteColor(size_t index, uint8_t r, uint8_t g, uint8_t b)
+  {
+    palette[index] = lgfx::swap565_t(r, g, b).raw;
+  }
+  void initDMA() {}
+
+  void setClipRect(int x, int y, int w, int h)
+  {
+    clipLeft = std::max(x, 0);
+    clipTop = std::max(y, 0);
+    clipRight = std::min(x + w, surfaceWidth);
+    clipBottom = std::min(y + h, surfaceHeight);
+  }
+  void clearClipRect() { setClipRect(0, 0, surfaceWidth, surfaceHeight); }
+
+  // ── 図形 ──
+  void drawPixel(int x, int y, uint16_t color) { writePixel(x, y, color); }
+
+  void fillRect(int x, int y, int w, int h, uint16_t color)
+  {
+    stats.fillCalls++;
+    fillSpan(x, y, w, h, color);
+  }
+
+  void fillScreen(uint16_t color) { fillRect(0, 0, surfaceWidth, surfaceHeight, color); }
+
+  void drawRect(int x, int y, int w, int h, uint16_t color)
+  {
+    fillSpan(x, y, w, 1, color);
+    fillSpan(x, y + h - 1, w, 1, color);
+    fillSpan(x, y + 1, 1, h - 2, color);
+    fillSpan(x + w - 1, y + 1, 1, h - 2, color);
+  }
+
+  void drawLine(int x0, int y0, int x1, int y1, uint16_t color)
+  {
+    int dx = std::abs(x1 - x0);
+    int dy = -std::abs(y1 - y0);
+    int sx = (x0 < x1) ? 1 : -1;
+    int sy = (y0 < y1) ? 1 : -1;
+    int err = dx + dy;
+    for (;;)
+    {
+      writePixel(x0, y0, color);
+      if (x0 == x1 && y0 == y1)
+      {
+        break;
+      }
+      int e2 = 2 * err;
+      if (e2 >= dy)
+      {
+        err += dy;
+        x0 += sx;
+      }
+      if (e2 <= dx)
+      {
+        err += dx;
+        y0 += sy;
+      }
+    }
+  }
+
+  // 角度は度、0 度が 3 時方向で時計回り（LovyanGFX と同じ）
+  void fillArc(int x, int y, int r0, int r1, float angle0, float angle1, uint16_t color)
+  {
+    stats.fillCalls++;
+    int inner = std::min(r0, r1);
+    int outer = std::max(r0, r1);
+    float start = std::fmod(angle0, 360.0F);
+    if (start < 0.0F)
+    {
+      start += 360.0F;
+    }
+    float span = angle1 - angle0;
+    for (int py = y - outer; py <= y + outer; ++py)
+    {
+      for (int px = x - outer; px <= x + outer; ++px)
+      {
+        int dx = px - x;
+        int dy = py - y;
+        int d2 = (dx * dx) + (dy * dy);
+        if (d2 < inner * inner || d2 > outer * outer)
+        {
+          continue;
+        }
+        float angle = std::atan2(static_cast<float>(dy), static_cast<float>(dx)) * 180.0F / static_cast<float>(M_PI);
+        float offset = std::fmod(angle - start + 720.0F, 360.0F);
+        if (span >= 360.0F || offset <= span)
+        {
+          writePixel(px, py, color);
+        }
+      }
+    }
+  }
+
+  // ── 文字 ──
+  void setFont(const HeadlessFont *newFont) { font = newFont; }
+  void setTextFont(int /*fontId*/) { font = &fonts::Font0; }
+  void setTextSize(float size) { textScale = (size < 1.0F) ? 1 : static_cast<int>(size); }
+  void setTextColor(uint16_t fg)
+  {
+    textColor = fg;
+    hasTextBackground = false;
+  }
+  void setTextColor(uint16_t fg, uint16_t bg)
+  {
+    textColor = fg;
+    textBackground = bg;
+    hasTextBackground = true;
+  }
+  void setTextDatum(textdatum_t datum) { textDatum = datum; }
+  void setTextWrap(bool /*wrap*/) {}
+  void setCursor(int x, int y)
+  {
+    cursorX = x;
+    cursorY = y;
+  }
+
+  auto textWidth(const char *text) const -> int
+  {
+    int width = 0;
+    for (const char *c = text; *c != '\0'; ++c)
+    {
+      width += glyphAdvance(*c);
+    }
+    return width;
+  }
+  auto fontHeight() const -> int { return font->glyphHeight * textScale; }
+
+  auto print(const char *text) -> size_t
+  {
+    stats.textCalls++;
+    drawText(text, cursorX, cursorY);
+    cursorX += textWidth(text);
+    return strlen(text);
+  }
+
+  auto printf(const char *format, ...) -> size_t
+  {
+    char text[128];
+    va_list args;
+    va_start(args, format);
+    vsnprintf(text, sizeof(text), format, args);
+    va_end(args);
+    return print(text);
+  }
+
+  void drawString(const char *text, int x, int y)
+  {
+    stats.textCalls++;
+    int w = textWidth(text);
+    int h = fontHeight();
+    int column = static_cast<int>(textDatum) % 3;  // 0:左 1:中央 2:右
+    int row = static_cast<int>(textDatum) / 3;     // 0:上 1:中央 2:下
+    drawText(text, x - ((w * column) / 2), y - ((h * row) / 2));
+  }
+
+  void drawRightString(const char *text, int x, int y)
+  {
+    stats.textCalls++;
+    drawText(text, x - textWidth(text), y);
+  }
+
+  HeadlessStats stats;
+
+ protected:
+  void allocate(int w, int h)
+  {
+    surfaceWidth = w;
+    surfaceHeight = h;
+    rowBytes = ((w * bitsPerPixel) + 7) / 8;
+    bytes.assign(static_cast<size_t>(rowBytes) * h, 0);
+    if (isPalette())
+    {
+      createPalette();
+    }
+    clearClipRect();
+  }
+
+  auto isPalette() const -> bool { return bitsPerPixel < 16; }
+
+  // 4bit は 1 バイトに 2 画素（左の画素が上位）
+  auto loadRaw(int x, int y) const -> uint16_t
+  {
+    const uint8_t *row = bytes.data() + (static_cast<size_t>(y) * rowBytes);
+    if (bitsPerPixel == 16)
+    {
+      uint16_t value;
+      memcpy(&value, row + (x * 2), sizeof(value));
+      return value;
+    }
+    if (bitsPerPixel == 8)
+    {
+      return row[x];
+    }
+    return (x & 1) ? (row[x / 2] & 0x0F) : (row[x / 2] >> 4);
+  }
+
+  void storeRaw(int x, int y, uint16_t value)
+  {
+    uint8_t *row = bytes.data() + (static_cast<size_t>(y) * rowBytes);
+    if (bitsPerPixel == 16)
+    {
+      memcpy(row + (x * 2), &value, sizeof(value));
+    }
+    else if (bitsPerPixel == 8)
+    {
+      row[x] = static_cast<uint8_t>(value);
+    }
+    else
+    {
+      uint8_t &b = row[x / 2];
+      b = (x & 1) ? static_cast<uint8_t>((b & 0xF0) | (value & 0x0F)) : static_cast<uint8_t>((b & 0x0F) | (value << 4));
+    }
+  }
+
+  void writePixel(int x, int y, uint16_t color)
+  {
+    if (x < clipLeft || x >= clipRight || y < clipTop || y >= clipBottom)
+    {
+      return;
+    }
+    storeRaw(x, y, color);
+    stats.pixelsTouched++;
+  }
+
+  // 実機のスプライトと同じく、行ごとに詰めた形式のまま塗る（8bit・4bit は memset）
+  void fillSpan(int x, int y, int w, int h, uint16_t color)
+  {
+    int left = std::max(x, clipLeft);
+    int right = std::min(x + w, clipRight);
+    int top = std::max(y, clipTop);
+    int bottom = std::min(y + h, clipBottom);
+    if (left >= right || top >= bottom)
+    {
+      return;
+    }
+    for (int py = top; py < bottom; ++py)
+    {
+      uint8_t *row = bytes.data() + (static_cast<size_t>(py) * rowBytes);
+      if (bitsPerPixel == 16)
+      {
+        for (int px = left; px < right; ++px)
+        {
+          memcpy(row + (px * 2), &color, sizeof(color));
+        }
+      }
+      else if (bitsPerPixel == 8)
+      {
+        memset(row + left, color & 0xFF, right - left);
+      }
+      else
+      {
+        int px = left;
+        if (px & 1)
+        {
+          storeRaw(px++, py, color);
+        }
+        int pairs = (right - px) / 2;
+        memset(row + (px / 2), ((color & 0x0F) << 4) | (color & 0x0F), pairs);
+        px += pairs * 2;
+        if (px < right)
+        {
+          storeRaw(px, py, color);
+        }
+      }
+    }
+    stats.pixelsTouched += static_cast<uint64_t>(right - left) * (bottom - top);
+  }
+
+  // 区切り記号は実フォントと同様に半分の幅で送る
+  auto glyphAdvance(char c) const -> int
+  {
+    bool isNarrow = (c == '.' || c == ',' || c == ':');
+    return (isNarrow ? font->glyphWidth / 2 : font->glyphWidth) * textScale;
+  }
+
+  // 文字コードから決まる縞模様を各セルに描く
+  void drawText(const char *text, int x, int y)
+  {
+    int cellH = font->glyphHeight * textScale;
+    int inkH = font->inkHeight * textScale;
+    for (const char *c = text; *c != '\0'; x += glyphAdvance(*c), ++c)
+    {
+      int cellW = glyphAdvance(*c);
+      if (hasTextBackground)
+      {
+        fillSpan(x, y, cellW, cellH, textBackground);
+      }
+      if (*c == ' ')
+      {
+        continue;
+      }
+      for (int row = 1; row < inkH - 1; ++row)
+      {
+        for (int col = 1; col < cellW - 1; ++col)
+        {
+          if (((static_cast<unsigned char>(*c) * 7) + (row * 3) + col) % 4 == 0)
+          {
+            writePixel(x + col, y + row, textColor);
+          }
+        }
+      }
+    }
+  }
+
+  int surfaceWidth = 0;
+  int surfaceHeight = 0;
+  int bitsPerPixel = 16;
+  int rowBytes = 0;
+  std::vector<uint8_t> bytes;
+  std::vector<uint16_t> palette;  // パレット番号 → RGB565
+  int clipLeft = 0;
+  int clipTop = 0;
+  int clipRight = 0;
+  int clipBottom = 0;
+
+  const HeadlessFont *font = &fonts::Font0;
+  int textScale = 1;
+  uint16_t textColor = 0xFFFF;
+  uint16_t textBackground = 0;
+  bool hasTextBackground = false;
+  textdatum_t textDatum = textdatum_t::top_left;
+  int cursorX = 0;
+  int cursorY = 0;
+};
+
+// ────────────────────── パネル ──────────────────────
+class M5GFX : public HeadlessSurface
+{
+ public:
+  static constexpr int PANEL_WIDTH = 320;
+  static constexpr int PANEL_HEIGHT = 240;
+
+  void init() { allocate(PANEL_WIDTH, PANEL_HEIGHT); }
+  void setRotation(int /*rotation*/) {}
+  void setBrightness(uint8_t level) { brightness = level; }
+  void startWrite() { writeDepth++; }
+  void endWrite() { writeDepth--; }
+  void waitDMA() { stats.dmaWaits++; }
+
+  void pushImageDMA(int x, int y, int w, int h, const lgfx::swap565_t *data)
+  {
+    stats.pushCalls++;
+    for (int row = 0; row < h; ++row)
+    {
+      for (int col = 0; col < w; ++col)
+      {
+        receivePixel(x + col, y + row, data[(row * w) + col].raw);
+      }
+    }
+  }
+
+  // スプライト全体をクリップ範囲に限って受け取る
+  void pushSurface(const HeadlessSurface &source, int x, int y)
+  {
+    stats.pushCalls++;
+    for (int row = 0; row < source.height(); ++row)
+    {
+      for (int col = 0; col < source.width(); ++col)
+      {
+        receivePixel(x + col, y + row, source.readPixel(col, row));
+      }
+    }
+  }
+
+  uint8_t brightness = 0;
+  int writeDepth = 0;
+
+ private:
+  void receivePixel(int x, int y, uint16_t color)
+  {
+    if (x < clipLeft || x >= clipRight || y < clipTop || y >= clipBottom)
+    {
+      return;
+    }
+    storeRaw(x, y, color);
+    stats.bytesPushed += sizeof(uint16_t);
+  }
+};
+
+// ────────────────────── スプライト ──────────────────────
+class M5Canvas : public HeadlessSurface
+{
+ public:
+  explicit M5Canvas(M5GFX *parent = nullptr) : parent(parent) {}
+
+  void setPsram(bool /*usePsram*/) {}
+  auto createSprite(int w, int h) -> void *
+  {
+    allocate(w, h);
+    return getBuffer();
+  }
+  void deleteSprite() { allocate(0, 0); }
+  void pushSprite(int x, int y)
+  {
+    if (parent != nullptr)
+    {
+      parent->pushSurface(*this, x, y);
+    }
+  }
+
+ private:
+  M5GFX *parent;
+};
+
+#endif  // HEADLESS_M5GFX_H
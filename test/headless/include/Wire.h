@@ -0,0 +1,6 @@
+#ifndef HEADLESS_WIRE_H
+#define HEADLESS_WIRE_H
+
+// ホストでは I2C バスを使わないため空のヘッダを置く
+
+#endif  // HEADLESS_WIRE_H
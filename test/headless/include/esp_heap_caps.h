@@ -0,0 +1,14 @@
+#ifndef HEADLESS_ESP_HEAP_CAPS_H
+#define HEADLESS_ESP_HEAP_CAPS_H
+
+#include <cstdint>
+#include <cstdlib>
+
+// ホストでは確保先の区別をしない
+#define MALLOC_CAP_DMA (1 << 3)
+#define MALLOC_CAP_8BIT (1 << 2)
+
+inline auto heap_caps_malloc(size_t size, uint32_t /*caps*/) -> void * { return malloc(size); }
+inline void heap_caps_free(void *ptr) { free(ptr); }
+
+#endif  // HEADLESS_ESP_HEAP_CAPS_H
@@ -0,0 +1,189 @@
+#include <unity.h>
+
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+#include "../../include/config.h"
+#include "../../src/modules/imu_batch.cpp"
+
+// ────────────────────── 疑似 FIFO ──────────────────────
+// ±8G レンジの BMI270 と同じ 1LSB あたりの G
+constexpr float ACCEL_SCALE = 8.0F / 32768.0F;
+constexpr float ODR_HZ = IMU_FIFO_ODR_HZ;
+// 60fps の 1 フレームに届くサンプル数
+constexpr size_t SAMPLES_PER_FRAME = static_cast<size_t>(ODR_HZ / 60.0F);
+
+static uint8_t fifoBytes[IMU_BATCH_MAX_SAMPLES * IMU_FIFO_FRAME_BYTES];
+static size_t fifoLength = 0;
+
+static void pushFifoRaw(int16_t x, int16_t y, int16_t z)
+{
+  const int16_t axes[3] = {x, y, z};
+  for (int16_t v : axes)
+  {
+    fifoBytes[fifoLength++] = static_cast<uint8_t>(v & 0xFF);
+    fifoBytes[fifoLength++] = static_cast<uint8_t>((v >> 8) & 0xFF);
+  }
+}
+
+// 前後 (X)・左右 (Y) の加速度と重力 (Z) を FIFO へ積む
+static void pushFifoSample(float longitudinal, float lateral)
+{
+  pushFifoRaw(static_cast<int16_t>(std::lround(longitudinal / ACCEL_SCALE)),
+              static_cast<int16_t>(std::lround(lateral / ACCEL_SCALE)), static_cast<int16_t>(1.0F / ACCEL_SCALE));
+}
+
+// 積んだ FIFO を実機と同じ手順で解析し、フィルタへ渡す
+static auto drainFifo(GForceFilter &filter) -> GForceSummary
+{
+  AccelSample batch[IMU_BATCH_MAX_SAMPLES];
+  size_t count = parseAccelFifo(fifoBytes, fifoLength, ACCEL_SCALE, batch, IMU_BATCH_MAX_SAMPLES);
+  fifoLength = 0;
+  return filter.processBatch(batch, count);
+}
+
+// 静止状態でオフセット補正を済ませる
+static void calibrate(GForceFilter &filter)
+{
+  for (int i = 0; i < GForceFilter::OFFSET_SAMPLE_COUNT; ++i)
+  {
+    pushFifoSample(0.0F, 0.0F);
+  }
+  drainFifo(filter);
+}
+
+void setUp() { fifoLength = 0; }
+
+void tearDown()
+{
+  // テスト終了時の処理は不要
+}
+
+// FIFO のバイト列を G へ変換し、無効フレームと端数を読み飛ばすことを確認
+void test_parse_fifo_frames()
+{
+  pushFifoRaw(4096, -4096, 1024);
+  pushFifoRaw(static_cast<int16_t>(0x8000), static_cast<int16_t>(0x8000), static_cast<int16_t>(0x8000));
+  pushFifoRaw(0, 2048, 0);
+  AccelSample out[4];
+  size_t count = parseAccelFifo(fifoBytes, fifoLength - 1, ACCEL_SCALE, out, 4);
+  // 最後のフレームは 1 バイト欠けているため読まない
+  TEST_ASSERT_EQUAL_size_t(1, count);
+  TEST_ASSERT_FLOAT_WITHIN(0.0001F, 1.0F, out[0].x);
+  TEST_ASSERT_FLOAT_WITHIN(0.0001F, -1.0F, out[0].y);
+  TEST_ASSERT_FLOAT_WITHIN(0.0001F, 0.25F, out[0].z);
+
+  count = parseAccelFifo(fifoBytes, fifoLength, ACCEL_SCALE, out, 4);
+  TEST_ASSERT_EQUAL_size_t(2, count);
+  TEST_ASSERT_FLOAT_WITHIN(0.0001F, 0.5F, out[1].y);
+  // 格納先の上限を超えて書き込まない
+  TEST_ASSERT_EQUAL_size_t(1, parseAccelFifo(fifoBytes, fifoLength, ACCEL_SCALE, out, 1));
+}
+
+// 前後・左右の成分から向きを判定することを確認
+void test_classify_direction()
+{
+  TEST_ASSERT_EQUAL_STRING("Front", classifyGDirection(0.05F, 1.0F));
+  TEST_ASSERT_EQUAL_STRING("Rear", classifyGDirection(0.0F, -0.8F));
+  TEST_ASSERT_EQUAL_STRING("Right", classifyGDirection(1.2F, 0.1F));
+  TEST_ASSERT_EQUAL_STRING("Left", classifyGDirection(-1.2F, 0.0F));
+  TEST_ASSERT_EQUAL_STRING("FR", classifyGDirection(0.7F, 0.7F));
+  TEST_ASSERT_EQUAL_STRING("RL", classifyGDirection(-0.5F, -0.6F));
+}
+
+// 補正前のサンプルは 0G とし、静止時の傾きをオフセットとして差し引くことを確認
+void test_offset_calibration()
+{
+  GForceFilter filter(G_FILTER_CUTOFF_HZ, ODR_HZ);
+  for (int i = 0; i < GForceFilter::OFFSET_SAMPLE_COUNT; ++i)
+  {
+    pushFifoSample(0.1F, -0.05F);  // 取り付け角による傾き
+  }
+  GForceSummary summary = drainFifo(filter);
+  TEST_ASSERT_TRUE(filter.isCalibrated());
+  TEST_ASSERT_EQUAL_FLOAT(0.0F, summary.peak);
+  TEST_ASSERT_EQUAL_UINT16(GForceFilter::OFFSET_SAMPLE_COUNT, summary.count);
+
+  for (size_t i = 0; i < SAMPLES_PER_FRAME; ++i)
+  {
+    pushFifoSample(0.1F, -0.05F);
+  }
+  summary = drainFifo(filter);
+  TEST_ASSERT_FLOAT_WITHIN(0.001F, 0.0F, summary.peak);
+}
+
+// フレーム境界の 1 回読みでは見逃す数 ms のピークを、バッチの最大値で捉えることを確認
+void test_captures_sub_frame_peak()
+{
+  GForceFilter filter(G_FILTER_CUTOFF_HZ, ODR_HZ);
+  calibrate(filter);
+
+  // 1 フレーム (約 13 サンプル) の中央に 5ms だけ 1.5G の横 G が掛かる
+  const size_t pulseStart = SAMPLES_PER_FRAME / 2 - 2;
+  const size_t pulseLength = static_cast<size_t>(ODR_HZ * 0.005F);
+  float lastSample = 0.0F;
+  for (size_t i = 0; i < SAMPLES_PER_FRAME; ++i)
+  {
+    lastSample = (i >= pulseStart && i < pulseStart + pulseLength) ? 1.5F : 0.0F;
+    pushFifoSample(0.0F, lastSample);
+  }
+  GForceSummary summary = drainFifo(filter);
+
+  // 従来のフレームごとの 1 回読みは最後のサンプルしか見ない
+  TEST_ASSERT_EQUAL_FLOAT(0.0F, lastSample);
+  TEST_ASSERT_GREATER_THAN_FLOAT(0.5F, summary.peak);
+  TEST_ASSERT_LESS_THAN_FLOAT(summary.peak, summary.mean);
+  TEST_ASSERT_EQUAL_STRING("Right", summary.direction);
+  TEST_ASSERT_EQUAL_UINT16(SAMPLES_PER_FRAME, summary.count);
+}
+
+// 車体振動 (120Hz, ±0.5G) を重ねた定常コーナリングで、平均と最大がほぼ実際の G に収まることを確認
+void test_rejects_vibration()
+{
+  GForceFilter filter(G_FILTER_CUTOFF_HZ, ODR_HZ);
+  calibrate(filter);
+
+  constexpr float CORNER_G = 0.8F;
+  constexpr float VIBRATION_HZ = 120.0F;
+  constexpr float VIBRATION_G = 0.5F;
+  float rawMin = 10.0F;
+  float rawMax = 0.0F;
+  GForceSummary summary = {};
+  size_t sampleIndex = 0;
+  for (int frame = 0; frame < 60; ++frame)
+  {
+    for (size_t i = 0; i < SAMPLES_PER_FRAME; ++i, ++sampleIndex)
+    {
+      float t = static_cast<float>(sampleIndex) / ODR_HZ;
+      float lateral = CORNER_G + (VIBRATION_G * std::sin(2.0F * static_cast<float>(M_PI) * VIBRATION_HZ * t));
+      rawMin = std::min(rawMin, lateral);
+      rawMax = std::max(rawMax, lateral);
+      pushFifoSample(0.0F, lateral);
+    }
+    summary = drainFifo(filter);
+  }
+
+  // 生の 1 サンプルは 0.3〜1.3G の間で揺れる
+  TEST_ASSERT_GREATER_THAN_FLOAT(0.9F, rawMax - rawMin);
+  TEST_ASSERT_FLOAT_WITHIN(0.05F, CORNER_G, summary.mean);
+  TEST_ASSERT_LESS_THAN_FLOAT(0.15F, summary.peak - summary.mean);
+
+  char message[96];
+  snprintf(message, sizeof(message), "vibration: raw %.2f-%.2f G, filtered mean %.3f peak %.3f G", rawMin, rawMax,
+           summary.mean, summary.peak);
+  TEST_MESSAGE(message);
+}
+
+void setup()
+{
+  UNITY_BEGIN();
+  RUN_TEST(test_parse_fifo_frames);
+  RUN_TEST(test_classify_direction);
+  RUN_TEST(test_offset_calibration);
+  RUN_TEST(test_captures_sub_frame_peak);
+  RUN_TEST(test_rejects_vibration);
+  UNITY_END();
+}
+
+void loop() {}
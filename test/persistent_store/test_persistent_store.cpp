@@ -0,0 +1,265 @@
+#include <unity.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+
+#include "../../src/modules/persistent_store.cpp"
+
+constexpr size_t SECTOR_COUNT = 4;
+constexpr size_t REGION_SIZE = SECTOR_COUNT * STORE_SECTOR_SIZE;
+
+// ファイルで模したフラッシュに、操作回数の記録と書き込み失敗の注入を加えたもの
+class CountingFlashRegion : public FileFlashRegion
+{
+ public:
+  explicit CountingFlashRegion(FILE *file) : FileFlashRegion(file, REGION_SIZE) {}
+
+  auto write(size_t offset, const void *data, size_t length) -> bool override
+  {
+    ++writeCount;
+    if (failNext)
+    {
+      // 途中まで書けたところで電源が切れた状態を模す
+      failNext = false;
+      FileFlashRegion::write(offset, data, length / 2);
+      return false;
+    }
+    return FileFlashRegion::write(offset, data, length);
+  }
+
+  auto eraseSector(size_t offset) -> bool override
+  {
+    ++eraseCount[offset / STORE_SECTOR_SIZE];
+    return FileFlashRegion::eraseSector(offset);
+  }
+
+  int writeCount = 0;
+  int eraseCount[SECTOR_COUNT] = {};
+  bool failNext = false;
+};
+
+static FILE *flashFile = nullptr;
+
+static auto stateWithOilTemp(int maxOilTemp) -> PersistentState
+{
+  return makePersistentState(6.5F, 98.0F, maxOilTemp, 1.25F, "Left", 0.8F, 1.5F);
+}
+
+// 書き込み待ちが無くなるまで service() を呼び、呼んだ回数を返す
+static auto drain(PersistentStore &store) -> int
+{
+  int calls = 0;
+  while (store.isDirty() && calls < 8)
+  {
+    store.service(true);
+    ++calls;
+  }
+  return calls;
+}
+
+void setUp()
+{
+  flashFile = tmpfile();
+}
+
+void tearDown()
+{
+  fclose(flashFile);
+}
+
+// 工学値が固定小数点へ丸められ、向きが添字で保存されることを確認
+void test_state_conversion()
+{
+  PersistentState state = makePersistentState(7.236F, 102.54F, 131, 1.2345F, "RL", 2.345F, 0.999F);
+  TEST_ASSERT_EQUAL_UINT16(724, state.maxOilPressureCbar);
+  TEST_ASSERT_EQUAL_INT16(1025, state.maxWaterTempDeci);
+  TEST_ASSERT_EQUAL_INT16(131, state.maxOilTemp);
+  TEST_ASSERT_EQUAL_UINT16(1235, state.lowEventGMilli);
+  TEST_ASSERT_EQUAL_UINT16(235, state.lowEventDurationCentisec);
+  TEST_ASSERT_EQUAL_UINT16(100, state.lowEventPressureCbar);
+  TEST_ASSERT_EQUAL_STRING("RL", persistentDirectionName(state, "Right"));
+
+  state = makePersistentState(0.0F, 0.0F, 0, 0.0F, "Up", 0.0F, 0.0F);
+  TEST_ASSERT_EQUAL_STRING("Right", persistentDirectionName(state, "Right"));
+}
+
+// update() はフラッシュに触れず、service() は 1 回に 1 操作だけ行い、再起動後に同じ値が復元されることを確認
+void test_write_behind_and_restore()
+{
+  CountingFlashRegion flash(flashFile);
+  PersistentStore store(flash);
+  TEST_ASSERT_FALSE(store.restore());
+
+  store.update(stateWithOilTemp(120));
+  TEST_ASSERT_TRUE(store.isDirty());
+  TEST_ASSERT_EQUAL_INT(0, flash.writeCount);
+  // 空のフラッシュでは先頭セクタの消去と記録の書き込みを別々の呼び出しで行う
+  TEST_ASSERT_TRUE(store.service(true));
+  TEST_ASSERT_EQUAL_INT(1, flash.eraseCount[0]);
+  TEST_ASSERT_EQUAL_INT(0, flash.writeCount);
+  TEST_ASSERT_TRUE(store.service(true));
+  TEST_ASSERT_EQUAL_INT(1, flash.writeCount);
+  TEST_ASSERT_FALSE(store.isDirty());
+
+  // 同じ値では書き込み待ちにならない
+  store.update(stateWithOilTemp(120));
+  TEST_ASSERT_FALSE(store.service(true));
+  store.update(stateWithOilTemp(125));
+  TEST_ASSERT_EQUAL_INT(1, drain(store));
+  TEST_ASSERT_EQUAL_INT(2, flash.writeCount);
+
+  PersistentStore rebooted(flash);
+  TEST_ASSERT_TRUE(rebooted.restore());
+  TEST_ASSERT_EQUAL_INT16(125, rebooted.state().maxOilTemp);
+  TEST_ASSERT_EQUAL_INT16(980, rebooted.state().maxWaterTempDeci);
+  TEST_ASSERT_EQUAL_STRING("Left", persistentDirectionName(rebooted.state(), "Right"));
+  // 続きの位置へ追記する（消去せずに書ける）
+  rebooted.update(stateWithOilTemp(130));
+  TEST_ASSERT_EQUAL_INT(1, drain(rebooted));
+  TEST_ASSERT_EQUAL_INT(1, flash.eraseCount[0]);
+}
+
+// 領域を何周も追記しても各セクタの消去回数が均等で、常に最新の値が復元されることを確認
+void test_wear_leveling_wraps_around()
+{
+  CountingFlashRegion flash(flashFile);
+  PersistentStore store(flash);
+  store.restore();
+  constexpr int LAPS = 3;
+  const int updates = static_cast<int>(LAPS * SECTOR_COUNT * STORE_RECORDS_PER_SECTOR);
+  for (int i = 0; i < updates; ++i)
+  {
+    store.update(stateWithOilTemp(i));
+    TEST_ASSERT_LESS_OR_EQUAL(2, drain(store));
+  }
+  for (size_t sector = 0; sector < SECTOR_COUNT; ++sector)
+  {
+    TEST_ASSERT_EQUAL_INT(LAPS, flash.eraseCount[sector]);
+  }
+
+  PersistentStore rebooted(flash);
+  TEST_ASSERT_TRUE(rebooted.restore());
+  TEST_ASSERT_EQUAL_INT16(updates - 1, rebooted.state().maxOilTemp);
+  // 最後のセクタが埋まっているので、次の書き込みは先頭セクタの消去から始まる
+  rebooted.update(stateWithOilTemp(9999));
+  TEST_ASSERT_EQUAL_INT(2, drain(rebooted));
+  TEST_ASSERT_EQUAL_INT(LAPS + 1, flash.eraseCount[0]);
+  PersistentStore again(flash);
+  TEST_ASSERT_TRUE(again.restore());
+  TEST_ASSERT_EQUAL_INT16(9999, again.state().maxOilTemp);
+}
+
+// 書き込み途中で電源が切れた記録は読み飛ばし、直前の記録を復元することを確認
+void test_torn_write_falls_back()
+{
+  CountingFlashRegion flash(flashFile);
+  PersistentStore store(flash);
+  store.restore();
+  store.update(stateWithOilTemp(110));
+  drain(store);
+  flash.failNext = true;
+  store.update(stateWithOilTemp(140));
+  drain(store);
+  TEST_ASSERT_EQUAL_UINT32(1, store.failedWrites());
+  // 失敗した位置は飛ばして次の位置へ書き直している
+  TEST_ASSERT_EQUAL_UINT32(2, store.writtenRecords());
+
+  PersistentStore rebooted(flash);
+  TEST_ASSERT_TRUE(rebooted.restore());
+  TEST_ASSERT_EQUAL_INT16(140, rebooted.state().maxOilTemp);
+
+  // 最後の記録が壊れていれば、その前の記録を使う
+  flash.failNext = true;
+  rebooted.update(stateWithOilTemp(150));
+  rebooted.service(true);
+  PersistentStore afterPowerLoss(flash);
+  TEST_ASSERT_TRUE(afterPowerLoss.restore());
+  TEST_ASSERT_EQUAL_INT16(140, afterPowerLoss.state().maxOilTemp);
+}
+
+// 消去が許されない間は、消去が必要な書き込みを見送って RAM に保持することを確認
+void test_erase_is_deferred()
+{
+  CountingFlashRegion flash(flashFile);
+  PersistentStore store(flash);
+  store.restore();
+  store.update(stateWithOilTemp(100));
+  TEST_ASSERT_FALSE(store.service(false));
+  TEST_ASSERT_EQUAL_INT(0, flash.eraseCount[0]);
+  TEST_ASSERT_TRUE(store.isDirty());
+  TEST_ASSERT_EQUAL_INT16(100, store.state().maxOilTemp);
+  TEST_ASSERT_TRUE(store.service(true));
+  // 消去済みのセクタへの追記は許可が無くても行う
+  TEST_ASSERT_TRUE(store.service(false));
+  TEST_ASSERT_FALSE(store.isDirty());
+}
+
+// 書き込み待ちが無くても次のセクタを先に消去でき、その後は消去の許可無しで 1 セクタ分を書けることを確認
+void test_erase_ahead_while_stopped()
+{
+  CountingFlashRegion flash(flashFile);
+  PersistentStore store(flash);
+  store.restore();
+  // 起動時の先行消去
+  TEST_ASSERT_TRUE(store.eraseAhead());
+  TEST_ASSERT_EQUAL_INT(1, flash.eraseCount[0]);
+  TEST_ASSERT_FALSE(store.eraseAhead());
+
+  // 走行中（消去不可）でもセクタが埋まるまでは書ける
+  for (size_t i = 0; i < STORE_RECORDS_PER_SECTOR; ++i)
+  {
+    store.update(stateWithOilTemp(static_cast<int>(i)));
+    TEST_ASSERT_TRUE(store.service(false));
+  }
+  store.update(stateWithOilTemp(1000));
+  TEST_ASSERT_FALSE(store.service(false));
+  TEST_ASSERT_EQUAL_INT(0, flash.eraseCount[1]);
+
+  // 停車したら消去して、保持していた値を書く
+  TEST_ASSERT_TRUE(store.service(true));
+  TEST_ASSERT_EQUAL_INT(1, flash.eraseCount[1]);
+  TEST_ASSERT_TRUE(store.service(false));
+  PersistentStore rebooted(flash);
+  TEST_ASSERT_TRUE(rebooted.restore());
+  TEST_ASSERT_EQUAL_INT16(1000, rebooted.state().maxOilTemp);
+}
+
+// 埋まった領域からの復元にかかる時間を測る（ホストでの参考値）
+void test_restore_time()
+{
+  CountingFlashRegion flash(flashFile);
+  PersistentStore store(flash);
+  store.restore();
+  for (size_t i = 0; i + 1 < SECTOR_COUNT * STORE_RECORDS_PER_SECTOR; ++i)
+  {
+    store.update(stateWithOilTemp(static_cast<int>(i)));
+    drain(store);
+  }
+
+  auto start = std::chrono::steady_clock::now();
+  PersistentStore rebooted(flash);
+  TEST_ASSERT_TRUE(rebooted.restore());
+  double us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+  TEST_ASSERT_EQUAL_INT16(SECTOR_COUNT * STORE_RECORDS_PER_SECTOR - 2, rebooted.state().maxOilTemp);
+
+  char message[96];
+  snprintf(message, sizeof(message), "restore: %.0f us (%u records in %u sectors)", us,
+           static_cast<unsigned>(store.writtenRecords()), static_cast<unsigned>(SECTOR_COUNT));
+  TEST_MESSAGE(message);
+}
+
+void setup()
+{
+  UNITY_BEGIN();
+  RUN_TEST(test_state_conversion);
+  RUN_TEST(test_write_behind_and_restore);
+  RUN_TEST(test_wear_leveling_wraps_around);
+  RUN_TEST(test_torn_write_falls_back);
+  RUN_TEST(test_erase_is_deferred);
+  RUN_TEST(test_erase_ahead_while_stopped);
+  RUN_TEST(test_restore_time);
+  UNITY_END();
+}
+
+void loop() {}
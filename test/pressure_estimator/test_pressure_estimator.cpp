@@ -0,0 +1,278 @@
+#include <unity.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+#include "../../include/config.h"
+#include "../../src/modules/sensor_channels.h"
+
+// ────────────────────── 比較する 2 つの推定段 ──────────────────────
+constexpr size_t PRESSURE_INDEX = sensorChannelIndex(SensorChannelId::OilPressure);
+using TwoStageChain = SensorEstimator<PRESSURE_INDEX, SensorFilter::AverageEma>;
+using KalmanStage = SensorEstimator<PRESSURE_INDEX, SensorFilter::Kalman>;
+using PressureQ = TwoStageChain::Q;
+
+// ────────────────────── 記録相当のトレース ──────────────────────
+constexpr float SAMPLE_PERIOD_MS = static_cast<float>(SENSOR_TASK_INTERVAL_MS);
+constexpr float FRAME_PERIOD_MS = static_cast<float>(FRAME_INTERVAL_US) / 1000.0F;
+constexpr uint32_t LAP_MS = 6000;
+constexpr int LAP_COUNT = 20;
+// 段差の後、この時間が過ぎたら定常区間としてばらつきを数える
+constexpr float SETTLE_MS = 400.0F;
+
+// 再現性のある標準正規乱数（Box-Muller）
+static uint32_t rngState = 1;
+static auto nextUniform() -> float
+{
+  rngState = (rngState * 1664525U) + 1013904223U;
+  return (static_cast<float>(rngState >> 8) + 0.5F) / static_cast<float>(1U << 24);
+}
+static auto nextGaussian() -> float
+{
+  float u1 = nextUniform();
+  float u2 = nextUniform();
+  return std::sqrt(-2.0F * std::log(u1)) * std::cos(2.0F * static_cast<float>(M_PI) * u2);
+}
+
+// 油圧 [bar] を ADC コードへ（convertVoltageToOilPressure の逆変換）
+static auto pressureToCode(float bar) -> int16_t
+{
+  float voltage = ((bar / 2.5F) + 0.5F) / CORRECTION_FACTOR;
+  return static_cast<int16_t>(std::lround(voltage * ADC_MAX_CODE / ADC_FULL_SCALE_VOLTAGE));
+}
+
+// 1 周の真値: 直線 4.5bar → 制動で 2.0bar へ段差 → 立ち上がりは 1 秒で 6.0bar まで直線的に上昇 → 4.5bar へ段差
+static auto truePressure(float ms) -> float
+{
+  float lap = std::fmod(ms, static_cast<float>(LAP_MS));
+  if (lap < 2000.0F)
+  {
+    return 4.5F;
+  }
+  if (lap < 3000.0F)
+  {
+    return 2.0F;
+  }
+  if (lap < 4000.0F)
+  {
+    return 2.0F + (4.0F * (lap - 3000.0F) / 1000.0F);
+  }
+  if (lap < 5000.0F)
+  {
+    return 6.0F;
+  }
+  return 4.5F;
+}
+
+// 段差の時刻（周内）と前後の値
+struct StepEdge
+{
+  float lapMs;
+  float from;
+  float to;
+};
+constexpr StepEdge STEP_EDGES[] = {{2000.0F, 4.5F, 2.0F}, {5000.0F, 6.0F, 4.5F}};
+
+// 雑音と量子化を加えた取得値 [bar]（取得周期ごと）
+static auto makeRecordedSamples() -> std::vector<float>
+{
+  std::vector<float> samples;
+  int count = static_cast<int>(LAP_COUNT * LAP_MS / SAMPLE_PERIOD_MS);
+  samples.reserve(count);
+  for (int i = 0; i < count; ++i)
+  {
+    float bar = truePressure(i * SAMPLE_PERIOD_MS) + (OIL_PRESSURE_NOISE_BAR * nextGaussian());
+    samples.push_back(convertAdcToOilPressure(pressureToCode(bar)));
+  }
+  return samples;
+}
+
+// ────────────────────── 評価 ──────────────────────
+struct ChainResult
+{
+  float stepLatencyMs = 0.0F;  // 段差から表示が段差の 90% に達するまでの平均時間
+  float worstLatencyMs = 0.0F;
+  float overshootBar = 0.0F;   // 段差後の行き過ぎの最大値
+  float noiseBar = 0.0F;       // 一定区間の表示の標準偏差
+  float rampErrorBar = 0.0F;   // 直線上昇中の表示と真値の差の最大値
+  double nsPerSample = 0.0;
+};
+
+// 取得周期ごとに push し、描画周期ごとに表示値を求める（updateGauges と同じ順序）
+template <typename Chain>
+static auto runChain(const std::vector<float> &samples) -> ChainResult
+{
+  Chain chain;
+  chain.fill(PressureQ::fromFloat(samples[0]));
+  std::vector<float> frameTimes;
+  std::vector<float> shown;
+  float nextFrameMs = 0.0F;
+  auto start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < samples.size(); ++i)
+  {
+    chain.push(PressureQ::fromFloat(samples[i]));
+    float nowMs = static_cast<float>(i + 1) * SAMPLE_PERIOD_MS;
+    while (nextFrameMs < nowMs)
+    {
+      frameTimes.push_back(nextFrameMs);
+      shown.push_back(chain.smooth(chain.estimate()).toFloat());
+      nextFrameMs += FRAME_PERIOD_MS;
+    }
+  }
+  auto end = std::chrono::steady_clock::now();
+
+  ChainResult result;
+  result.nsPerSample = std::chrono::duration<double, std::nano>(end - start).count() / samples.size();
+
+  // 段差への追従（最初の周は起動直後なので除く）
+  int latencyCount = 0;
+  for (int lap = 1; lap < LAP_COUNT; ++lap)
+  {
+    for (const StepEdge &edge : STEP_EDGES)
+    {
+      float edgeMs = (static_cast<float>(lap) * LAP_MS) + edge.lapMs;
+      float threshold = edge.from + (0.9F * (edge.to - edge.from));
+      bool isFalling = edge.to < edge.from;
+      for (size_t f = 0; f < frameTimes.size(); ++f)
+      {
+        if (frameTimes[f] < edgeMs)
+        {
+          continue;
+        }
+        if (isFalling ? shown[f] <= threshold : shown[f] >= threshold)
+        {
+          float latency = frameTimes[f] - edgeMs;
+          result.stepLatencyMs += latency;
+          result.worstLatencyMs = std::max(result.worstLatencyMs, latency);
+          latencyCount++;
+          break;
+        }
+      }
+      for (size_t f = 0; f < frameTimes.size(); ++f)
+      {
+        if (frameTimes[f] >= edgeMs && frameTimes[f] < edgeMs + SETTLE_MS)
+        {
+          float beyond = isFalling ? edge.to - shown[f] : shown[f] - edge.to;
+          result.overshootBar = std::max(result.overshootBar, beyond);
+        }
+      }
+    }
+  }
+  result.stepLatencyMs /= static_cast<float>(latencyCount > 0 ? latencyCount : 1);
+
+  // 一定区間のばらつきと直線上昇中の誤差
+  double sum = 0.0;
+  double sumSquares = 0.0;
+  int steadyCount = 0;
+  for (size_t f = 0; f < frameTimes.size(); ++f)
+  {
+    if (frameTimes[f] < LAP_MS)
+    {
+      continue;
+    }
+    float lap = std::fmod(frameTimes[f], static_cast<float>(LAP_MS));
+    float error = shown[f] - truePressure(frameTimes[f]);
+    bool isSteady = (lap >= SETTLE_MS && lap < 2000.0F) || (lap >= 2000.0F + SETTLE_MS && lap < 3000.0F) ||
+                    (lap >= 5000.0F + SETTLE_MS);
+    if (isSteady)
+    {
+      sum += error;
+      sumSquares += static_cast<double>(error) * error;
+      steadyCount++;
+    }
+    if (lap >= 3100.0F && lap < 4000.0F)
+    {
+      result.rampErrorBar = std::max(result.rampErrorBar, std::fabs(error));
+    }
+  }
+  double mean = sum / steadyCount;
+  result.noiseBar = static_cast<float>(std::sqrt((sumSquares / steadyCount) - (mean * mean)));
+  return result;
+}
+
+static void reportChain(const char *name, const ChainResult &r, float groupDelayMs)
+{
+  char message[192];
+  snprintf(message, sizeof(message),
+           "%s: group delay %.1f ms, step 90%% %.1f ms (worst %.1f), overshoot %.3f bar, noise %.4f bar, "
+           "ramp error %.3f bar, %.1f ns/sample",
+           name, groupDelayMs, r.stepLatencyMs, r.worstLatencyMs, r.overshootBar, r.noiseBar, r.rampErrorBar,
+           r.nsPerSample);
+  TEST_MESSAGE(message);
+}
+
+void setUp() { rngState = 1; }
+
+void tearDown()
+{
+  // テスト終了時の処理は不要
+}
+
+// ゲイン列が 1 から定常ゲインへ単調に減り、群遅延が定常ゲインと一致することを確認
+void test_gain_schedule()
+{
+  const auto &gains = KalmanStage::GAINS;
+  TEST_ASSERT_TRUE(gains.isConverged);
+  TEST_ASSERT_FLOAT_WITHIN(1e-4F, 1.0F, gains.gains[0].toFloat());
+  for (size_t k = 1; k < SENSOR_KALMAN_GAIN_STEPS; ++k)
+  {
+    TEST_ASSERT_TRUE(gains.gains[k] <= gains.gains[k - 1]);
+  }
+  TEST_ASSERT_FLOAT_WITHIN(1e-5F, gains.steadyGain, gains.gains[SENSOR_KALMAN_GAIN_STEPS - 1].toFloat());
+  TEST_ASSERT_FLOAT_WITHIN(1e-3F, (1.0F - gains.steadyGain) / gains.steadyGain * SAMPLE_PERIOD_MS,
+                           KalmanStage::groupDelayMs());
+  // 2 段構成: 移動平均 (N-1)/2 サンプル + EMA (1-α)/α フレーム
+  float expected = ((PRESSURE_SAMPLE_SIZE - 1) / 2.0F * SAMPLE_PERIOD_MS) +
+                   ((1.0F - OIL_PRESSURE_SMOOTHING_ALPHA) / OIL_PRESSURE_SMOOTHING_ALPHA * FRAME_PERIOD_MS);
+  TEST_ASSERT_FLOAT_WITHIN(1e-3F, expected, TwoStageChain::groupDelayMs());
+}
+
+// 1 回だけの外れ値では段差とみなさず、同じ向きに続いたら累積平均へ切り替わることを確認
+void test_step_detection_needs_confirmation()
+{
+  KalmanStage stage;
+  stage.fill(PressureQ::fromFloat(4.0F));
+  stage.push(PressureQ::fromFloat(6.0F));
+  float afterSpike = stage.estimate().toFloat();
+  TEST_ASSERT_LESS_THAN_FLOAT(4.0F + (2.0F * 0.2F), afterSpike);
+  stage.push(PressureQ::fromFloat(4.0F));
+  stage.push(PressureQ::fromFloat(4.0F));
+
+  stage.push(PressureQ::fromFloat(2.0F));
+  stage.push(PressureQ::fromFloat(2.0F));
+  // 2 回目でゲインがほぼ 1 になり、段差後の値に移る
+  TEST_ASSERT_FLOAT_WITHIN(0.01F, 2.0F, stage.estimate().toFloat());
+}
+
+// 記録相当のトレースで、段差への追従が従来の 2 段より速く、ばらつきは同等以下であることを確認
+void test_recorded_trace_latency_and_noise()
+{
+  std::vector<float> samples = makeRecordedSamples();
+  ChainResult twoStage = runChain<TwoStageChain>(samples);
+  ChainResult kalman = runChain<KalmanStage>(samples);
+  reportChain("moving average + EMA", twoStage, TwoStageChain::groupDelayMs());
+  reportChain("kalman (1 stage)    ", kalman, KalmanStage::groupDelayMs());
+
+  // 定常時の群遅延は従来と同程度に設計している
+  TEST_ASSERT_TRUE(KalmanStage::groupDelayMs() <= TwoStageChain::groupDelayMs());
+  TEST_ASSERT_LESS_THAN_FLOAT(twoStage.stepLatencyMs * 0.5F, kalman.stepLatencyMs);
+  TEST_ASSERT_LESS_THAN_FLOAT(twoStage.worstLatencyMs, kalman.worstLatencyMs);
+  TEST_ASSERT_LESS_THAN_FLOAT(twoStage.noiseBar * 1.05F, kalman.noiseBar);
+  TEST_ASSERT_LESS_THAN_FLOAT(twoStage.rampErrorBar, kalman.rampErrorBar);
+  // 段差の検出後は累積平均なので、行き過ぎは雑音程度に収まる
+  TEST_ASSERT_LESS_THAN_FLOAT(3.0F * OIL_PRESSURE_NOISE_BAR, kalman.overshootBar);
+}
+
+void setup()
+{
+  UNITY_BEGIN();
+  RUN_TEST(test_gain_schedule);
+  RUN_TEST(test_step_detection_needs_confirmation);
+  RUN_TEST(test_recorded_trace_latency_and_noise);
+  UNITY_END();
+}
+
+void loop() {}
@@ -0,0 +1,430 @@
+#include <unity.h>
+
+#include <cstdio>
+#include <vector>
+
+#include "../../include/config.h"
+#include "../../src/modules/sensor.h"
+
+// ────────────────────── テスト用スタブ ──────────────────────
+// センサー取得 (sensor.cpp) と main.cpp が持つ値は描画経路の入力として直接与える
+SensorChannelBank sensorChannels;
+float currentGForce = 0.0F;
+float currentGForcePeak = 0.0F;
+const char *currentGDirection = "Right";
+int currentFps = 0;
+
+#include "../../src/modules/backlight.cpp"
+#include "../../src/modules/dirty_region.cpp"
+#include "../../src/modules/display.cpp"
+#include "../../src/modules/fps_display.cpp"
+#include "../../src/modules/glyph_cache.cpp"
+#include "../../src/modules/low_warning.cpp"
+#include "../../src/modules/racing_indicator.cpp"
+#include "../../src/modules/starvation_map.cpp"
+
+constexpr uint32_t FULL_FRAME_BYTES = LCD_WIDTH * LCD_HEIGHT * (DISPLAY_COLOR_DEPTH / 8);
+constexpr unsigned long FRAME_US = FRAME_INTERVAL_US;
+
+static void setSensorValues(float pressure, float waterTemp, float oilTemp)
+{
+  sensorChannel<SensorChannelId::OilPressure>().fill(pressure);
+  sensorChannel<SensorChannelId::WaterTemp>().fill(waterTemp);
+  sensorChannel<SensorChannelId::OilTemp>().fill(oilTemp);
+}
+
+// 1 フレーム分時間を進めて描画する
+static void renderFrame()
+{
+  headlessNowUs += FRAME_US;
+  updateGauges();
+}
+
+// ゲージ画面で (x, y) に見えるべき色（ウィジェットの無い余白は黒）
+static auto gaugeScreenPixel(int x, int y) -> uint16_t
+{
+  for (const Widget *widget : gaugeScreenWidgets)
+  {
+    if (widget->canvas.width() > 0 && x >= widget->x && x < widget->x + widget->w && y >= widget->y &&
+        y < widget->y + widget->h)
+    {
+      return widget->canvas.readPixel(x - widget->x, y - widget->y);
+    }
+  }
+  return COLOR_BLACK;
+}
+
+// パネルの内容がゲージ画面のウィジェット、または mainCanvas と一致しているか（更新領域の漏れがないか）
+static auto countMismatchedPixels(bool isMenu = false) -> int
+{
+  int mismatched = 0;
+  for (int y = 0; y < LCD_HEIGHT; ++y)
+  {
+    for (int x = 0; x < LCD_WIDTH; ++x)
+    {
+      uint16_t expected = isMenu ? mainCanvas.readPixel(x, y) : gaugeScreenPixel(x, y);
+      if (display.readPixel(x, y) != expected)
+      {
+        ++mismatched;
+      }
+    }
+  }
+  return mismatched;
+}
+
+// ゲージ画面のウィジェットへの描画量
+static auto widgetStats() -> HeadlessStats
+{
+  HeadlessStats total;
+  for (const Widget *widget : gaugeScreenWidgets)
+  {
+    total.fillCalls += widget->canvas.stats.fillCalls;
+    total.pixelsTouched += widget->canvas.stats.pixelsTouched;
+  }
+  return total;
+}
+
+static void resetWidgetStats()
+{
+  for (Widget *widget : gaugeScreenWidgets)
+  {
+    widget->canvas.stats.reset();
+  }
+}
+
+void setUp()
+{
+  // 実機の setup() と同じ順序で初期化する
+  headlessNowUs = 1000000UL;
+  display.init();
+  mainCanvas.setColorDepth(CANVAS_COLOR_DEPTH);
+  initDisplayBuffers();
+  setSensorValues(3.0F, 90.0F, 95.0F);
+  resetGaugeState();
+  display.stats.reset();
+  resetWidgetStats();
+}
+
+void tearDown()
+{
+  // テスト終了時の処理は不要
+}
+
+// 初回フレームでゲージ全体が描かれ、パネルとキャンバスが一致することを確認
+void test_first_frame_draws_full_gauges()
+{
+  renderFrame();
+  HeadlessStats drawn = widgetStats();
+  TEST_ASSERT_GREATER_THAN(0, drawn.fillCalls);
+  TEST_ASSERT_GREATER_THAN(0, display.stats.bytesPushed);
+  TEST_ASSERT_EQUAL_INT(0, countMismatchedPixels());
+
+  char message[96];
+  snprintf(message, sizeof(message), "first frame: %u fills, %llu px drawn, %llu bytes pushed", drawn.fillCalls,
+           static_cast<unsigned long long>(drawn.pixelsTouched),
+           static_cast<unsigned long long>(display.stats.bytesPushed));
+  TEST_MESSAGE(message);
+}
+
+// 値が変わらないフレームでは何も描かず何も転送しないことを確認
+void test_steady_frame_pushes_nothing()
+{
+  for (int i = 0; i < 60; ++i)
+  {
+    renderFrame();
+  }
+  display.stats.reset();
+  resetWidgetStats();
+
+  renderFrame();
+  TEST_ASSERT_EQUAL_INT(0, widgetStats().pixelsTouched);
+  TEST_ASSERT_EQUAL_INT(0, display.stats.bytesPushed);
+  TEST_ASSERT_EQUAL_INT(0, lastFramePushedBytes);
+}
+
+// 油圧だけが変化した場合、転送量が全画面より十分小さく表示の漏れもないことを確認
+void test_pressure_change_pushes_small_region()
+{
+  for (int i = 0; i < 60; ++i)
+  {
+    renderFrame();
+  }
+
+  uint64_t totalBytes = 0;
+  constexpr int FRAMES = 30;
+  for (int i = 0; i < FRAMES; ++i)
+  {
+    // 0〜6bar を往復させる
+    float pressure = 3.0F + (3.0F * std::sin(i * 0.3F));
+    setSensorValues(pressure, 90.0F, 95.0F);
+    display.stats.reset();
+    renderFrame();
+    totalBytes += display.stats.bytesPushed;
+    TEST_ASSERT_EQUAL_INT(0, countMismatchedPixels());
+  }
+  uint64_t averageBytes = totalBytes / FRAMES;
+  TEST_ASSERT_LESS_THAN(FULL_FRAME_BYTES / 4, averageBytes);
+
+  char message[96];
+  snprintf(message, sizeof(message), "pressure sweep: %llu bytes/frame (full frame %u)",
+           static_cast<unsigned long long>(averageBytes), FULL_FRAME_BYTES);
+  TEST_MESSAGE(message);
+}
+
+// 油温の変化では上部バーの伸び縮みした範囲と変わった数字だけを描き、全体を描き直した結果と一致することを確認
+void test_oil_temp_change_updates_top_bar_incrementally()
+{
+  for (int i = 0; i < 60; ++i)
+  {
+    renderFrame();
+  }
+  M5Canvas &topBar = topBarWidget.canvas;
+
+  // 帯全体を描き直した場合の描画量（以前は油温が変わるたびにこれを描いていた）
+  topBarState = {};
+  topBar.stats.reset();
+  drawOilTemperatureTopBar(topBar, displayCache.oilTemp, displayCache.maxOilTemp);
+  uint64_t fullRedrawPixels = topBar.stats.pixelsTouched;
+  frameDirtyRegions.clear();
+  renderFrame();
+
+  // 95〜125℃ を往復させる（警告色への切り替えと MAX の更新を含む）
+  uint64_t totalPixels = 0;
+  int updates = 0;
+  constexpr int FRAMES = 120;
+  for (int i = 0; i < FRAMES; ++i)
+  {
+    float oilTemp = 110.0F + (15.0F * std::sin(i * 0.1F));
+    setSensorValues(3.0F, 90.0F, oilTemp);
+    topBar.stats.reset();
+    renderFrame();
+    if (topBar.stats.pixelsTouched > 0)
+    {
+      totalPixels += topBar.stats.pixelsTouched;
+      ++updates;
+    }
+    TEST_ASSERT_EQUAL_INT(0, countMismatchedPixels());
+  }
+  TEST_ASSERT_GREATER_THAN(0, updates);
+  uint64_t averagePixels = totalPixels / updates;
+#if VALUE_GLYPH_CACHE_ENABLED
+  // 数字グリフのキャッシュが無いと数値欄はフォントで全体を描き直すため、比較はキャッシュがある場合だけ
+  TEST_ASSERT_LESS_THAN(fullRedrawPixels / 10, averagePixels);
+#endif
+
+  // 差分で描いた結果が、同じ値で全体を描き直した結果と一致する
+  std::vector<uint16_t> incremental;
+  for (int y = 0; y < topBar.height(); ++y)
+  {
+    for (int x = 0; x < topBar.width(); ++x)
+    {
+      incremental.push_back(topBar.readPixel(x, y));
+    }
+  }
+  topBarState = {};
+  drawOilTemperatureTopBar(topBar, displayCache.oilTemp, displayCache.maxOilTemp);
+  int mismatched = 0;
+  for (int y = 0; y < topBar.height(); ++y)
+  {
+    for (int x = 0; x < topBar.width(); ++x)
+    {
+      mismatched += (topBar.readPixel(x, y) != incremental[(y * topBar.width()) + x]) ? 1 : 0;
+    }
+  }
+  TEST_ASSERT_EQUAL_INT(0, mismatched);
+
+  char message[96];
+  snprintf(message, sizeof(message), "oil temp sweep: %llu px/update (full top bar redraw %llu px)",
+           static_cast<unsigned long long>(averagePixels), static_cast<unsigned long long>(fullRedrawPixels));
+  TEST_MESSAGE(message);
+}
+
+// メニュー画面は全画面を描いて転送し、戻ると再びゲージが描かれることを確認
+void test_menu_round_trip()
+{
+  renderFrame();
+  display.stats.reset();
+
+  drawMenuScreen();
+  TEST_ASSERT_EQUAL_INT(FULL_FRAME_BYTES, display.stats.bytesPushed);
+  TEST_ASSERT_EQUAL_INT(0, countMismatchedPixels(true));
+  // 全画面のバッファとゲージ画面の部品は行き来しても確保し直さない
+  const void *menuBuffer = mainCanvas.getBuffer();
+  const void *pressureBuffer = pressureWidget.canvas.getBuffer();
+  TEST_ASSERT_NOT_NULL(menuBuffer);
+  TEST_ASSERT_NOT_NULL(pressureBuffer);
+
+  resetGaugeState();
+  renderFrame();
+  TEST_ASSERT_EQUAL_INT(0, countMismatchedPixels());
+  drawMenuScreen();
+  resetGaugeState();
+  TEST_ASSERT_TRUE(menuBuffer == mainCanvas.getBuffer());
+  TEST_ASSERT_TRUE(pressureBuffer == pressureWidget.canvas.getBuffer());
+}
+
+// メニューの命令数が MENU_LAYOUT_OPS と一致し、容量を超えずに記録できていることを確認
+void test_menu_layout_fits_capacity()
+{
+  drawMenuScreen();
+  TEST_ASSERT_TRUE(menuLayout.isRecorded());
+  TEST_ASSERT_FALSE(isMenuLayoutTruncated);
+  TEST_ASSERT_EQUAL_INT(MENU_LAYOUT_OPS, menuLayout.size());
+}
+
+// 確保できなかったウィジェットは更新領域を捨てて転送せず、部品が揃わなければゲージ画面を描かないことを確認
+void test_missing_widget_sprite_is_not_pushed()
+{
+  renderFrame();
+  pressureWidget.canvas.deleteSprite();
+  display.stats.reset();
+  setSensorValues(5.0F, 95.0F, 100.0F);
+  renderFrame();
+  TEST_ASSERT_GREATER_THAN(0, display.stats.bytesPushed);
+  TEST_ASSERT_TRUE(frameDirtyRegions.isEmpty());
+
+  areWidgetSpritesReady = false;
+  display.stats.reset();
+  setSensorValues(2.0F, 80.0F, 90.0F);
+  renderFrame();
+  TEST_ASSERT_EQUAL_INT(0, display.stats.bytesPushed);
+}
+
+// 背景レイヤーからの複写で戻したゲージが静的な部分を描き直した場合と一致し、
+// レーシング中表示の消去でも目盛などが元に戻ることを確認
+void test_background_layer_matches_static_redraw()
+{
+  const M5Canvas *face = gaugeBackground(pressureBackground);
+#if GAUGE_BACKGROUND_LAYER_ENABLED
+  TEST_ASSERT_NOT_NULL(face);
+#endif
+  M5Canvas layered;
+  M5Canvas redrawn;
+  for (M5Canvas *canvas : {&layered, &redrawn})
+  {
+    canvas->setColorDepth(CANVAS_COLOR_DEPTH);
+    canvas->createSprite(GAUGE_W, GAUGE_H);
+#if CANVAS_PALETTE_BITS
+    applyCanvasPalette(*canvas);
+#endif
+  }
+  float layeredPrevious = std::numeric_limits<float>::quiet_NaN();
+  float redrawnPrevious = std::numeric_limits<float>::quiet_NaN();
+  drawFillArcMeter(layered, pressureGaugeSpec, 5.5F, layeredPrevious, true, true, nullptr, face);
+  drawFillArcMeter(redrawn, pressureGaugeSpec, 5.5F, redrawnPrevious, true, true, nullptr, nullptr);
+
+  isRacingMode = true;
+  drawRacingIndicator(layered, face);
+  isRacingMode = false;
+  drawRacingIndicator(layered, face);
+  frameDirtyRegions.clear();
+
+  int mismatched = 0;
+  for (int y = 0; y < GAUGE_H; ++y)
+  {
+    for (int x = 0; x < GAUGE_W; ++x)
+    {
+      mismatched += (layered.readPixel(x, y) != redrawn.readPixel(x, y)) ? 1 : 0;
+    }
+  }
+  TEST_ASSERT_EQUAL_INT(0, mismatched);
+
+  char message[96];
+  snprintf(message, sizeof(message), "static gauge restore: %llu px drawn with layer, %llu px without",
+           static_cast<unsigned long long>(layered.stats.pixelsTouched),
+           static_cast<unsigned long long>(redrawn.stats.pixelsTouched));
+  TEST_MESSAGE(message);
+}
+
+// 低油圧警告の表示中も、値が変わらないフレームでは警告の枠を描き直さず何も転送しないことを確認
+void test_steady_warning_pushes_nothing()
+{
+  setSensorValues(2.0F, 90.0F, 95.0F);
+  currentGForce = 1.5F;
+  currentGForcePeak = 1.5F;
+  for (int i = 0; i < 120; ++i)
+  {
+    renderFrame();
+  }
+  display.stats.reset();
+  resetWidgetStats();
+
+  renderFrame();
+  TEST_ASSERT_EQUAL_INT(0, widgetStats().pixelsTouched);
+  TEST_ASSERT_EQUAL_INT(0, display.stats.bytesPushed);
+  TEST_ASSERT_EQUAL_INT(0, countMismatchedPixels());
+
+  // 警告の表示継続時間を過ぎるまで進め、次のテストへ状態を残さない
+  currentGForce = 0.0F;
+  currentGForcePeak = 0.0F;
+  for (int i = 0; i < 240; ++i)
+  {
+    renderFrame();
+  }
+  TEST_ASSERT_EQUAL_INT(0, countMismatchedPixels());
+}
+
+// 1 フレームで複数のウィジェットが変化しても、第2バッファに空きがある間は前の転送の完了を待たないことを確認
+void test_widget_pushes_do_not_wait_for_each_other()
+{
+  for (int i = 0; i < 60; ++i)
+  {
+    renderFrame();
+  }
+  waitDisplayTransfer();
+  display.stats.reset();
+
+  // 上部バー・油圧・水温のウィジェットがそれぞれ転送する
+  setSensorValues(3.5F, 92.0F, 101.0F);
+  renderFrame();
+  TEST_ASSERT_GREATER_OR_EQUAL(3, display.stats.pushCalls);
+  TEST_ASSERT_EQUAL_INT(0, display.stats.dmaWaits);
+  TEST_ASSERT_EQUAL_INT(1, display.writeDepth);
+  waitDisplayTransfer();
+  TEST_ASSERT_EQUAL_INT(1, display.stats.dmaWaits);
+  TEST_ASSERT_EQUAL_INT(0, display.writeDepth);
+  TEST_ASSERT_EQUAL_INT(0, countMismatchedPixels());
+}
+
+// ウィジェットのスプライトと第2バッファが、全画面のキャンバスと全画面の第2バッファより小さいことを確認
+void test_widget_buffers_fit_layout()
+{
+  size_t widgetBytes = 0;
+  for (const Widget *widget : gaugeScreenWidgets)
+  {
+    widgetBytes += widget->canvas.bufferLength();
+  }
+  constexpr size_t FULL_CANVAS_BYTES = CanvasFormat::rowBytes(LCD_WIDTH) * LCD_HEIGHT;
+  size_t expectedBytes = (CanvasFormat::rowBytes(LCD_WIDTH) * TOPBAR_H) + (2 * CanvasFormat::rowBytes(GAUGE_W) * GAUGE_H);
+#if FPS_DISPLAY_ENABLED
+  expectedBytes += CanvasFormat::rowBytes(FPS_W) * FPS_H;
+#endif
+  TEST_ASSERT_EQUAL_UINT32(expectedBytes, widgetBytes);
+  TEST_ASSERT_LESS_THAN(FULL_CANVAS_BYTES, widgetBytes);
+  TEST_ASSERT_LESS_THAN(FULL_FRAME_BYTES / 2, TRANSFER_BUFFER_PIXELS * sizeof(uint16_t));
+
+  char message[128];
+  snprintf(message, sizeof(message), "widget sprites %u B (full canvas %u B), transfer buffer %u B (full frame %u B)",
+           static_cast<unsigned>(widgetBytes), static_cast<unsigned>(FULL_CANVAS_BYTES),
+           static_cast<unsigned>(TRANSFER_BUFFER_PIXELS * sizeof(uint16_t)), FULL_FRAME_BYTES);
+  TEST_MESSAGE(message);
+}
+
+void setup()
+{
+  UNITY_BEGIN();
+  RUN_TEST(test_first_frame_draws_full_gauges);
+  RUN_TEST(test_steady_frame_pushes_nothing);
+  RUN_TEST(test_pressure_change_pushes_small_region);
+  RUN_TEST(test_oil_temp_change_updates_top_bar_incrementally);
+  RUN_TEST(test_menu_round_trip);
+  RUN_TEST(test_missing_widget_sprite_is_not_pushed);
+  RUN_TEST(test_menu_layout_fits_capacity);
+  RUN_TEST(test_background_layer_matches_static_redraw);
+  RUN_TEST(test_steady_warning_pushes_nothing);
+  RUN_TEST(test_widget_pushes_do_not_wait_for_each_other);
+  RUN_TEST(test_widget_buffers_fit_layout);
+  UNITY_END();
+}
+
+void loop() {}
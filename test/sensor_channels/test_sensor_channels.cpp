@@ -0,0 +1,148 @@
+#include <unity.h>
+
+#include <type_traits>
+#include <vector>
+
+#include "../../include/config.h"
+#include "../../src/modules/sensor.h"
+
+// ────────────────────── テスト用スタブ ──────────────────────
+// SD へ記録する代わりに、描画側へ届いたサンプルを保持する
+static std::vector<SensorSample> recordedSamples;
+void recordSensorSample(const SensorSample &sample) { recordedSamples.push_back(sample); }
+
+#include "../../src/modules/adc_scheduler.cpp"
+#include "../../src/modules/imu_batch.cpp"
+#include "../../src/modules/sensor.cpp"
+#include "../../src/modules/sensor_trace.cpp"
+
+// 記述子から決まる型と配列長
+static_assert(std::is_same<SensorChannelState<0>::Q, Fixed<20>>::value, "油圧は Q20");
+static_assert(std::is_same<SensorChannelState<1>::Q, Fixed<16>>::value, "温度は Q16");
+static_assert(sensorHomeAdcChannel(ADC_DEVICE_MAIN) == ADC_CH_OIL_PRESSURE, "油圧を常時変換する");
+
+constexpr int16_t PRESSURE_CODE = 700;
+constexpr int16_t WATER_CODE = 600;
+constexpr int16_t OIL_CODE = 500;
+
+// 一定の ADC コードを duration [ms] 分並べたトレース
+static auto makeConstantTrace(uint32_t startMs, uint32_t durationMs, int16_t pressureCode)
+    -> std::vector<SensorTraceFrame>
+{
+  std::vector<SensorTraceFrame> frames;
+  for (uint32_t t = 0; t <= durationMs; t += 10)
+  {
+    SensorTraceFrame frame = {};
+    frame.timestampMs = startMs + t;
+    frame.adc[ADC_CH_OIL_PRESSURE] = pressureCode;
+    frame.adc[ADC_CH_WATER_TEMP] = WATER_CODE;
+    frame.adc[ADC_CH_OIL_TEMP] = OIL_CODE;
+    frame.accelZ = 1.0F;
+    frames.push_back(frame);
+  }
+  return frames;
+}
+
+// 取得周期ごとに取得と反映を行う
+static void replayTrace(std::vector<SensorTraceFrame> &frames)
+{
+  SensorTraceReplay replay(frames.data(), frames.size());
+  attachSensorTraceReplay(replay);
+  initAdcScheduler();
+  while (!replay.isFinished())
+  {
+    acquireSensorData();
+    replay.advanceUs(SENSOR_TASK_INTERVAL_MS * 1000UL);
+    drainSensorSamples();
+  }
+}
+
+static auto countFresh(SensorChannelId id) -> int
+{
+  int count = 0;
+  for (const SensorSample &sample : recordedSamples)
+  {
+    count += sample.isFresh(id) ? 1 : 0;
+  }
+  return count;
+}
+
+void setUp() { recordedSamples.clear(); }
+
+void tearDown()
+{
+  // テスト終了時の処理は不要
+}
+
+// 表に従い、油圧は毎回・温度は 500ms ごとに取得され、各チャンネルの平均がテーブル値になることを確認
+void test_acquisition_follows_channel_table()
+{
+  std::vector<SensorTraceFrame> frames = makeConstantTrace(1000, 3000, PRESSURE_CODE);
+  replayTrace(frames);
+
+  int pressureCount = countFresh(SensorChannelId::OilPressure);
+  int waterCount = countFresh(SensorChannelId::WaterTemp);
+  int oilCount = countFresh(SensorChannelId::OilTemp);
+  // 油圧は温度の変換を挟む回以外は毎回届く
+  TEST_ASSERT_GREATER_THAN(static_cast<int>(recordedSamples.size() * 3 / 4), pressureCount);
+  // 温度は 3 秒間に 500ms ごと
+  TEST_ASSERT_INT_WITHIN(1, 6, waterCount);
+  TEST_ASSERT_INT_WITHIN(1, 6, oilCount);
+
+  TEST_ASSERT_FLOAT_WITHIN(1e-4F, convertAdcToOilPressure(PRESSURE_CODE),
+                           sensorChannel<SensorChannelId::OilPressure>().estimate().toFloat());
+  TEST_ASSERT_FLOAT_WITHIN(1e-3F, convertAdcToTemp(WATER_CODE),
+                           sensorChannel<SensorChannelId::WaterTemp>().estimate().toFloat());
+  TEST_ASSERT_FLOAT_WITHIN(1e-3F, convertAdcToTemp(OIL_CODE),
+                           sensorChannel<SensorChannelId::OilTemp>().estimate().toFloat());
+  TEST_ASSERT_FALSE(sensorChannel<SensorChannelId::OilPressure>().isShorted());
+}
+
+// 過電圧のコードはそのチャンネルだけショートとして扱い、表示値が 0 になることを確認
+void test_over_voltage_marks_only_that_channel()
+{
+  std::vector<SensorTraceFrame> frames = makeConstantTrace(10000, 200, OIL_PRESSURE_OVER_VOLTAGE_CODE);
+  replayTrace(frames);
+
+  bool sawShorted = false;
+  for (const SensorSample &sample : recordedSamples)
+  {
+    sawShorted |= sample.isShorted(SensorChannelId::OilPressure);
+    TEST_ASSERT_FALSE(sample.isShorted(SensorChannelId::WaterTemp));
+  }
+  TEST_ASSERT_TRUE(sawShorted);
+
+  bool hasFault = false;
+  auto target = sensorChannel<SensorChannelId::OilPressure>().displayTarget(hasFault);
+  TEST_ASSERT_TRUE(hasFault);
+  TEST_ASSERT_EQUAL_INT32(0, target.raw());
+}
+
+// 最初の値で窓全体を埋め、異常閾値以上は 0 として扱うことを確認
+void test_channel_state_fill_and_fault()
+{
+  SensorChannelState<sensorChannelIndex(SensorChannelId::WaterTemp)> water;
+  water.apply(90.0F, false);
+  TEST_ASSERT_FLOAT_WITHIN(1e-3F, 90.0F, water.estimate().toFloat());
+  water.apply(100.0F, false);
+  TEST_ASSERT_FLOAT_WITHIN(1e-3F, 95.0F, water.estimate().toFloat());
+
+  bool hasFault = true;
+  TEST_ASSERT_FLOAT_WITHIN(1e-3F, 95.0F, water.displayTarget(hasFault).toFloat());
+  TEST_ASSERT_FALSE(hasFault);
+
+  water.fill(TEMPERATURE_SENSOR_ERROR);
+  TEST_ASSERT_EQUAL_INT32(0, water.displayTarget(hasFault).raw());
+  TEST_ASSERT_TRUE(hasFault);
+}
+
+void setup()
+{
+  UNITY_BEGIN();
+  RUN_TEST(test_acquisition_follows_channel_table);
+  RUN_TEST(test_over_voltage_marks_only_that_channel);
+  RUN_TEST(test_channel_state_fill_and_fault);
+  UNITY_END();
+}
+
+void loop() {}
@@ -0,0 +1,72 @@
+#include <unity.h>
+
+#include <cstdio>
+
+#include "../../src/modules/sensor_conversion.h"
+
+// テーブルがコンパイル時に確定していることを確認
+static_assert(TEMPERATURE_LUT.values[0] == TEMPERATURE_SENSOR_ERROR, "0V は温度センサー異常");
+static_assert(OIL_PRESSURE_LUT.values[0] == 0.0F, "0V は油圧 0");
+static_assert(OIL_PRESSURE_LUT.values[ADC_MAX_CODE] == 0.0F, "過電圧は油圧 0");
+
+void setUp()
+{
+  // テスト前の処理は不要
+}
+
+void tearDown()
+{
+  // テスト終了時の処理は不要
+}
+
+// 全コードで温度テーブルが浮動小数点の変換結果と一致することを確認
+void test_temperature_table_matches_float_conversion()
+{
+  float worstError = 0.0F;
+  for (int code = 0; code <= ADC_MAX_CODE; ++code)
+  {
+    auto raw = static_cast<int16_t>(code);
+    float expected = convertVoltageToTemp(convertAdcToVoltage(raw));
+    float actual = convertAdcToTemp(raw);
+    float error = fabsf(expected - actual);
+    worstError = error > worstError ? error : worstError;
+    TEST_ASSERT_FLOAT_WITHIN(0.01F, expected, actual);
+  }
+  char msg[64];
+  snprintf(msg, sizeof(msg), "temperature LUT worst error: %.6f C", static_cast<double>(worstError));
+  TEST_MESSAGE(msg);
+}
+
+// 全コードで油圧テーブルが浮動小数点の変換結果と一致することを確認
+void test_oil_pressure_table_matches_float_conversion()
+{
+  for (int code = 0; code <= ADC_MAX_CODE; ++code)
+  {
+    auto raw = static_cast<int16_t>(code);
+    float voltage = convertAdcToVoltage(raw);
+    TEST_ASSERT_FLOAT_WITHIN(1e-6F, convertVoltageToOilPressure(voltage), convertAdcToOilPressure(raw));
+    TEST_ASSERT_EQUAL(voltage >= OIL_PRESSURE_OVER_VOLTAGE, isOilPressureOverVoltage(raw));
+  }
+}
+
+// 範囲外のコードは端の値として扱うことを確認
+void test_out_of_range_codes_are_clamped()
+{
+  TEST_ASSERT_FLOAT_WITHIN(1e-6F, TEMPERATURE_SENSOR_ERROR, convertAdcToTemp(-5));
+  TEST_ASSERT_FLOAT_WITHIN(1e-6F, 0.0F, convertAdcToOilPressure(-5));
+  TEST_ASSERT_FALSE(isOilPressureOverVoltage(-5));
+}
+
+void setup()
+{
+  UNITY_BEGIN();
+  RUN_TEST(test_temperature_table_matches_float_conversion);
+  RUN_TEST(test_oil_pressure_table_matches_float_conversion);
+  RUN_TEST(test_out_of_range_codes_are_clamped);
+  UNITY_END();
+}
+
+void loop()
+{
+  // ループ処理は不要
+}
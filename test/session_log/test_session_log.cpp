@@ -0,0 +1,215 @@
+#include <unity.h>
+
+#include <cstdio>
+#include <cstring>
+
+#include "../../src/modules/session_log.cpp"
+
+// 書き込まれたブロックをメモリに保持する保存先
+class MemoryLogStorage : public LogStorage
+{
+ public:
+  auto writeBlock(const uint8_t *data, size_t size) -> bool override
+  {
+    // ブロック単位以外の書き込みは失敗扱い
+    if (failNext || size != LOG_BLOCK_SIZE)
+    {
+      failNext = false;
+      return false;
+    }
+    memcpy(&lastBlock, data, size);
+    ++blockCount;
+    return true;
+  }
+  auto sync() -> bool override
+  {
+    syncedBlockCount = blockCount;
+    return true;
+  }
+
+  LogBlock lastBlock = {};
+  int blockCount = 0;
+  int syncedBlockCount = 0;  // 最後に同期した時点で書き込み済みだったブロック数
+  bool failNext = false;
+};
+
+void setUp()
+{
+  // テスト開始時の処理は不要
+}
+
+void tearDown()
+{
+  // テスト終了時の処理は不要
+}
+
+// 工学値が固定小数点へ丸められ、範囲外は飽和することを確認
+void test_make_record_scales_and_clamps()
+{
+  LogRecord r = makeLogRecord(1234, 4.567F, 95.44F, -12.36F, 1.2345F, "RL", LOG_FLAG_OIL_PRESSURE);
+  TEST_ASSERT_EQUAL_INT(1234, r.timestampMs);
+  TEST_ASSERT_EQUAL_INT(457, r.oilPressureCbar);
+  TEST_ASSERT_EQUAL_INT(954, r.waterTempDeci);
+  TEST_ASSERT_EQUAL_INT(-124, r.oilTempDeci);
+  TEST_ASSERT_EQUAL_INT(1235, r.gForceMilli);
+  TEST_ASSERT_EQUAL_STRING("RL", LOG_G_DIRECTIONS[r.gDirection]);
+
+  LogRecord saturated = makeLogRecord(0, -1.0F, 5000.0F, 0.0F, 100.0F, "unknown", 0);
+  TEST_ASSERT_EQUAL_INT(0, saturated.oilPressureCbar);
+  TEST_ASSERT_EQUAL_INT(32767, saturated.waterTempDeci);
+  TEST_ASSERT_EQUAL_INT(65535, saturated.gForceMilli);
+  TEST_ASSERT_EQUAL_INT(LOG_G_DIRECTION_COUNT, saturated.gDirection);
+}
+
+// ブロックが満杯になるまで書き込まれず、満杯で書き込み待ちになることを確認
+void test_blocks_are_written_only_when_full()
+{
+  MemoryLogStorage storage;
+  SessionLogger logger(storage);
+
+  for (size_t i = 0; i < LOG_RECORDS_PER_BLOCK - 1; ++i)
+  {
+    logger.append(makeLogRecord(i, 1.0F, 80.0F, 90.0F, 0.5F, "Front", 0));
+  }
+  TEST_ASSERT_FALSE(logger.hasPendingBlock());
+  TEST_ASSERT_FALSE(logger.flushOneBlock());
+
+  logger.append(makeLogRecord(99, 1.0F, 80.0F, 90.0F, 0.5F, "Front", 0));
+  TEST_ASSERT_TRUE(logger.hasPendingBlock());
+  TEST_ASSERT_TRUE(logger.flushOneBlock());
+  TEST_ASSERT_EQUAL_INT(1, storage.blockCount);
+  TEST_ASSERT_EQUAL_INT(LOG_BLOCK_MAGIC, storage.lastBlock.header.magic);
+  TEST_ASSERT_EQUAL_INT(LOG_RECORDS_PER_BLOCK, storage.lastBlock.header.recordCount);
+  TEST_ASSERT_EQUAL_INT(99, storage.lastBlock.records[LOG_RECORDS_PER_BLOCK - 1].timestampMs);
+}
+
+// 書き込みが追いつかない場合は古いデータを守って新しいレコードを捨てることを確認
+void test_records_are_dropped_when_all_blocks_pending()
+{
+  MemoryLogStorage storage;
+  SessionLogger logger(storage);
+  const size_t capacity = LOG_RECORDS_PER_BLOCK * SessionLogger::BLOCK_COUNT;
+  for (size_t i = 0; i < capacity + 5; ++i)
+  {
+    logger.append(makeLogRecord(i, 0.0F, 0.0F, 0.0F, 0.0F, "Front", 0));
+  }
+  TEST_ASSERT_EQUAL_INT(5, logger.droppedRecords());
+
+  // 1 ブロック書き込めば再び記録できる
+  TEST_ASSERT_TRUE(logger.flushOneBlock());
+  TEST_ASSERT_EQUAL_INT(0, storage.lastBlock.records[0].timestampMs);
+  TEST_ASSERT_TRUE(logger.append(makeLogRecord(0, 0.0F, 0.0F, 0.0F, 0.0F, "Front", 0)));
+}
+
+// 書き込み失敗したブロックは破棄して次へ進むことを確認
+void test_failed_write_is_counted_and_skipped()
+{
+  MemoryLogStorage storage;
+  SessionLogger logger(storage);
+  logger.append(makeLogRecord(1, 0.0F, 0.0F, 0.0F, 0.0F, "Front", 0));
+  logger.sealActiveBlock();
+  logger.append(makeLogRecord(2, 0.0F, 0.0F, 0.0F, 0.0F, "Front", 0));
+  logger.sealActiveBlock();
+
+  storage.failNext = true;
+  TEST_ASSERT_TRUE(logger.flushOneBlock());
+  TEST_ASSERT_TRUE(logger.flushOneBlock());
+  TEST_ASSERT_EQUAL_INT(1, logger.failedWrites());
+  TEST_ASSERT_EQUAL_INT(1, logger.writtenBlocks());
+  TEST_ASSERT_EQUAL_INT(2, storage.lastBlock.records[0].timestampMs);
+}
+
+// 同期の要求で書き込み途中のブロックも書き出され、その後の別の呼び出しで保存先が同期されることを確認
+void test_sync_request_flushes_partial_block()
+{
+  MemoryLogStorage storage;
+  SessionLogger logger(storage, 4);
+  for (uint32_t i = 0; i < 3; ++i)
+  {
+    logger.append(makeLogRecord(i, 0.0F, 0.0F, 0.0F, 0.0F, "Front", 0));
+  }
+  TEST_ASSERT_FALSE(logger.hasPendingBlock());
+
+  logger.requestSync();
+  TEST_ASSERT_TRUE(logger.hasPendingBlock());
+  // 対象のブロックを書き終えるまでは同期しない
+  TEST_ASSERT_FALSE(logger.isSyncDue());
+  TEST_ASSERT_TRUE(logger.flushOneBlock());
+  TEST_ASSERT_EQUAL_INT(3, storage.lastBlock.header.recordCount);
+  // ブロックの書き込みと同じ呼び出しでは同期しない
+  TEST_ASSERT_EQUAL_UINT32(0, logger.syncCount());
+  TEST_ASSERT_FALSE(logger.hasPendingBlock());
+  TEST_ASSERT_TRUE(logger.isSyncDue());
+  TEST_ASSERT_TRUE(logger.syncIfDue());
+  TEST_ASSERT_EQUAL_INT(1, storage.syncedBlockCount);
+  TEST_ASSERT_EQUAL_UINT32(1, logger.syncCount());
+  TEST_ASSERT_FALSE(logger.syncIfDue());
+
+  // 同期していない内容が無ければ要求しても何もしない
+  logger.requestSync();
+  TEST_ASSERT_FALSE(logger.hasPendingBlock());
+  TEST_ASSERT_FALSE(logger.isSyncDue());
+
+  // 要求が無くても syncBlocks ブロックごとに同期する
+  for (size_t i = 0; i < LOG_RECORDS_PER_BLOCK * 4; ++i)
+  {
+    logger.append(makeLogRecord(i, 0.0F, 0.0F, 0.0F, 0.0F, "Front", 0));
+    logger.flushOneBlock();
+    logger.syncIfDue();
+  }
+  TEST_ASSERT_EQUAL_INT(5, storage.syncedBlockCount);
+  TEST_ASSERT_EQUAL_UINT32(2, logger.syncCount());
+}
+
+// ファイルへ書いたログを CSV に戻せることを確認
+void test_file_log_round_trip_to_csv()
+{
+  FILE *logFile = tmpfile();
+  FILE *csvFile = tmpfile();
+  TEST_ASSERT_NOT_NULL(logFile);
+  TEST_ASSERT_NOT_NULL(csvFile);
+
+  FileLogStorage storage(logFile);
+  SessionLogger logger(storage);
+  const size_t recordCount = (LOG_RECORDS_PER_BLOCK * 2) + 3;
+  for (size_t i = 0; i < recordCount; ++i)
+  {
+    uint8_t flags = LOG_FLAG_OIL_PRESSURE | ((i == 0) ? LOG_FLAG_WATER_TEMP : 0);
+    logger.append(makeLogRecord(i * 4, 2.5F, 90.0F, 100.5F, 0.25F, (i % 2) ? "FR" : "Rear", flags));
+  }
+  // 最後の途中ブロックも締めて書き出す
+  logger.sealActiveBlock();
+  while (logger.flushOneBlock())
+  {
+  }
+  TEST_ASSERT_EQUAL_INT(3 * LOG_BLOCK_SIZE, ftell(logFile));
+
+  rewind(logFile);
+  TEST_ASSERT_EQUAL_INT(recordCount, decodeSessionLog(logFile, csvFile));
+
+  rewind(csvFile);
+  char line[160];
+  TEST_ASSERT_NOT_NULL(fgets(line, sizeof(line), csvFile));
+  TEST_ASSERT_EQUAL_INT(0, strncmp(line, "time_ms,oil_pressure_bar", 24));
+  TEST_ASSERT_NOT_NULL(fgets(line, sizeof(line), csvFile));
+  TEST_ASSERT_EQUAL_STRING("0,2.50,90.0,100.5,0.250,Rear,1,1,0,0\n", line);
+  TEST_ASSERT_NOT_NULL(fgets(line, sizeof(line), csvFile));
+  TEST_ASSERT_EQUAL_STRING("4,2.50,90.0,100.5,0.250,FR,1,0,0,0\n", line);
+
+  fclose(logFile);
+  fclose(csvFile);
+}
+
+void setup()
+{
+  UNITY_BEGIN();
+  RUN_TEST(test_make_record_scales_and_clamps);
+  RUN_TEST(test_blocks_are_written_only_when_full);
+  RUN_TEST(test_records_are_dropped_when_all_blocks_pending);
+  RUN_TEST(test_failed_write_is_counted_and_skipped);
+  RUN_TEST(test_sync_request_flushes_partial_block);
+  RUN_TEST(test_file_log_round_trip_to_csv);
+  UNITY_END();
+}
+
+void loop() {}
@@ -0,0 +1,128 @@
+#include <unity.h>
+
+#include <cstdint>
+#include <thread>
+
+#include "../../src/modules/spsc_ring.h"
+
+void setUp()
+{
+  // テスト開始時の処理は不要
+}
+
+void tearDown()
+{
+  // テスト終了時の処理は不要
+}
+
+// 積んだ順に取り出せることを確認
+void test_push_pop_keeps_order()
+{
+  SpscRing<int, 4> ring;
+  int value = 0;
+  TEST_ASSERT_FALSE(ring.pop(value));
+
+  TEST_ASSERT_TRUE(ring.push(1));
+  TEST_ASSERT_TRUE(ring.push(2));
+  TEST_ASSERT_EQUAL_INT(2, static_cast<int>(ring.size()));
+
+  TEST_ASSERT_TRUE(ring.pop(value));
+  TEST_ASSERT_EQUAL_INT(1, value);
+  TEST_ASSERT_TRUE(ring.pop(value));
+  TEST_ASSERT_EQUAL_INT(2, value);
+  TEST_ASSERT_FALSE(ring.pop(value));
+}
+
+// 満杯時は書き込みを拒否し、既存のデータは上書きされないことを確認
+void test_push_fails_when_full()
+{
+  SpscRing<int, 4> ring;
+  for (int i = 0; i < 4; ++i)
+  {
+    TEST_ASSERT_TRUE(ring.push(i));
+  }
+  TEST_ASSERT_FALSE(ring.push(99));
+  TEST_ASSERT_EQUAL_INT(1, static_cast<int>(ring.dropped()));
+
+  int value = -1;
+  TEST_ASSERT_TRUE(ring.pop(value));
+  TEST_ASSERT_EQUAL_INT(0, value);
+  // 空きができれば再び書き込める
+  TEST_ASSERT_TRUE(ring.push(4));
+}
+
+// 添字が容量を何周しても正しく動作することを確認
+void test_indices_wrap_around()
+{
+  SpscRing<int, 4> ring;
+  int value = 0;
+  for (int i = 0; i < 1000; ++i)
+  {
+    TEST_ASSERT_TRUE(ring.push(i));
+    TEST_ASSERT_TRUE(ring.pop(value));
+    TEST_ASSERT_EQUAL_INT(i, value);
+  }
+  TEST_ASSERT_EQUAL_INT(0, static_cast<int>(ring.size()));
+}
+
+// 生産者と消費者を別スレッドで動かし、欠落・重複・順序入れ替わりがないことを確認
+void test_concurrent_producer_consumer()
+{
+  // 取得タスクのサンプルを模した複数フィールドの要素（片方だけ更新された状態を検出する）
+  struct Item
+  {
+    uint32_t sequence;
+    uint32_t check;
+  };
+  constexpr uint32_t ITEM_COUNT = 1000000;
+  static SpscRing<Item, 64> ring;
+
+  std::thread producer(
+      [&]()
+      {
+        for (uint32_t i = 0; i < ITEM_COUNT;)
+        {
+          if (ring.push({i, ~i}))
+          {
+            ++i;
+          }
+          else
+          {
+            std::this_thread::yield();
+          }
+        }
+      });
+
+  uint32_t expected = 0;
+  uint32_t errors = 0;
+  Item item = {};
+  while (expected < ITEM_COUNT)
+  {
+    if (!ring.pop(item))
+    {
+      std::this_thread::yield();
+      continue;
+    }
+    if (item.sequence != expected || item.check != ~expected)
+    {
+      ++errors;
+    }
+    ++expected;
+  }
+  producer.join();
+
+  TEST_ASSERT_EQUAL_INT(0, static_cast<int>(errors));
+  TEST_ASSERT_EQUAL_INT(0, static_cast<int>(ring.size()));
+}
+
+void setup()
+{
+  UNITY_BEGIN();
+  RUN_TEST(test_push_pop_keeps_order);
+  RUN_TEST(test_push_fails_when_full);
+  RUN_TEST(test_indices_wrap_around);
+  RUN_TEST(test_concurrent_producer_consumer);
+  UNITY_END();
+}
+
+void loop() {}
@@ -0,0 +1,137 @@
+#include <unity.h>
+
+#include <cstring>
+
+#include "../../include/config.h"
+#include "../../src/modules/starvation_map.cpp"
+
+using Map = StarvationHistogram;
+
+// ビンの数だけで大きさが決まり、記録の回数には依存しない
+static_assert(sizeof(Map) == sizeof(uint32_t) * ((Map::DIRECTION_BINS * Map::G_BINS * Map::PRESSURE_BINS) +
+                                                 (Map::DIRECTION_BINS * Map::G_BINS) + 1),
+              "固定メモリ");
+
+void setUp()
+{
+  // テスト開始時の処理は不要
+}
+
+void tearDown()
+{
+  // テスト終了時の処理は不要
+}
+
+// G・油圧のビン分けと、範囲外の値が端のビンに入ることを確認
+void test_binning()
+{
+  TEST_ASSERT_EQUAL_INT(0, Map::gBinOf(-0.1F));
+  TEST_ASSERT_EQUAL_INT(0, Map::gBinOf(0.24F));
+  TEST_ASSERT_EQUAL_INT(1, Map::gBinOf(0.25F));
+  TEST_ASSERT_EQUAL_INT(4, Map::gBinOf(1.1F));
+  TEST_ASSERT_EQUAL_INT(Map::G_BINS - 1, Map::gBinOf(3.0F));
+
+  TEST_ASSERT_EQUAL_INT(0, Map::pressureBinOf(0.0F));
+  TEST_ASSERT_EQUAL_INT(2, Map::pressureBinOf(2.5F));
+  TEST_ASSERT_EQUAL_INT(Map::PRESSURE_BINS - 1, Map::pressureBinOf(12.0F));
+
+  TEST_ASSERT_EQUAL_INT(0, Map::directionOf("FL"));
+  TEST_ASSERT_EQUAL_INT(4, Map::directionOf("Right"));
+  TEST_ASSERT_EQUAL_INT(7, Map::directionOf("RR"));
+  TEST_ASSERT_EQUAL_INT(-1, Map::directionOf("Up"));
+  TEST_ASSERT_EQUAL_INT(-1, Map::directionOf(nullptr));
+}
+
+// 記録と列ごとの合計、向き不明のサンプルを数えないことを確認
+void test_record_and_columns()
+{
+  Map map;
+  for (int i = 0; i < 30; ++i)
+  {
+    map.record(1.1F, "Right", 2.4F);
+  }
+  for (int i = 0; i < 10; ++i)
+  {
+    map.record(1.1F, "Right", 5.0F);
+  }
+  map.record(0.1F, "Front", 4.0F);
+  map.record(1.0F, "Sideways", 4.0F);
+
+  int right = Map::directionOf("Right");
+  TEST_ASSERT_EQUAL_UINT32(30, map.count(right, 4, 2));
+  TEST_ASSERT_EQUAL_UINT32(10, map.count(right, 4, 5));
+  TEST_ASSERT_EQUAL_UINT32(40, map.columnTotal(right, 4));
+  TEST_ASSERT_EQUAL_UINT32(1, map.columnTotal(Map::directionOf("Front"), 0));
+  TEST_ASSERT_EQUAL_UINT32(41, map.total());
+
+  map.reset();
+  TEST_ASSERT_EQUAL_UINT32(0, map.total());
+  TEST_ASSERT_EQUAL_UINT32(0, map.count(right, 4, 2));
+}
+
+// シリアル出力の 1 列分の書式を確認
+void test_format_column()
+{
+  Map map;
+  map.record(0.6F, "FL", 1.5F);
+  map.record(0.6F, "FL", 1.5F);
+  map.record(0.6F, "FL", 7.5F);
+  char line[96];
+  map.formatColumn(Map::directionOf("FL"), 2, line, sizeof(line));
+  TEST_ASSERT_EQUAL_STRING("FL,0.50,0,2,0,0,0,0,0,1", line);
+
+  // バッファが短くても終端を越えて書かない
+  char shortLine[12];
+  memset(shortLine, 'x', sizeof(shortLine));
+  map.formatColumn(Map::directionOf("FL"), 2, shortLine, sizeof(shortLine));
+  TEST_ASSERT_EQUAL_INT(static_cast<int>(sizeof(shortLine)) - 1, static_cast<int>(strlen(shortLine)));
+}
+
+// ヒートマップで、列の中で最も多い油圧のセルが最も熱い色、記録の無い列が空の色になることを確認
+void test_heat_map_colors()
+{
+  constexpr int WIDTH = 320;
+  constexpr int HEIGHT = 228;
+  M5Canvas canvas;
+  canvas.setColorDepth(CANVAS_COLOR_DEPTH);
+  canvas.createSprite(WIDTH, HEIGHT);
+#if CANVAS_PALETTE_BITS
+  applyCanvasPalette(canvas);
+#endif
+
+  Map map;
+  for (int i = 0; i < 100; ++i)
+  {
+    map.record(1.1F, "Right", 2.4F);
+  }
+  drawStarvationMap(canvas, map, 0, 0, WIDTH, HEIGHT);
+
+  // 描画側と同じ配置計算（Right は中段の右の枠）
+  const int panelW = WIDTH / 3;
+  const int panelH = HEIGHT / 3;
+  const int cellW = (panelW - 4) / Map::G_BINS;
+  const int cellH = (panelH - 10 - 2) / Map::PRESSURE_BINS;
+  auto cellPixel = [&](int slot, int g, int p)
+  {
+    int panelX = (slot % 3) * panelW;
+    int panelY = (slot / 3) * panelH;
+    int gridBottom = panelY + 10 + (cellH * Map::PRESSURE_BINS);
+    return canvas.readPixel(panelX + 2 + (g * cellW) + 1, gridBottom - ((p + 1) * cellH) + 1);
+  };
+  constexpr int RIGHT_SLOT = 5;
+  TEST_ASSERT_EQUAL_UINT32(rgb565(255, 255, 0), cellPixel(RIGHT_SLOT, 4, 2));
+  TEST_ASSERT_EQUAL_UINT32(rgb565(0, 0, 0), cellPixel(RIGHT_SLOT, 4, 5));
+  TEST_ASSERT_EQUAL_UINT32(rgb565(24, 24, 24), cellPixel(RIGHT_SLOT, 0, 0));
+}
+
+void setup()
+{
+  UNITY_BEGIN();
+  RUN_TEST(test_binning);
+  RUN_TEST(test_record_and_columns);
+  RUN_TEST(test_format_column);
+  RUN_TEST(test_heat_map_colors);
+  UNITY_END();
+}
+
+void loop() {}
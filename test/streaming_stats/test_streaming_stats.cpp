@@ -0,0 +1,141 @@
+#include <unity.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+#include "../../src/modules/streaming_stats.h"
+
+// ────────────────────── 比較用の素朴な実装 ──────────────────────
+// 再現性のある整数乱数 [0, range)
+static uint32_t rngState = 1;
+static auto nextRandom(uint32_t range) -> int
+{
+  rngState = (rngState * 1664525U) + 1013904223U;
+  return static_cast<int>((rngState >> 8) % range);
+}
+
+// 直近 window 個を取り出す
+static auto lastSamples(const std::vector<int> &history, size_t window) -> std::vector<int>
+{
+  size_t begin = (history.size() > window) ? history.size() - window : 0;
+  return std::vector<int>(history.begin() + static_cast<long>(begin), history.end());
+}
+
+// 旧 calculateMedian と同じく nth_element で N/2 番目を取る
+static auto referenceMedian(std::vector<int> samples) -> int
+{
+  std::nth_element(samples.begin(), samples.begin() + static_cast<long>(samples.size() / 2), samples.end());
+  return samples[samples.size() / 2];
+}
+
+void setUp() { rngState = 1; }
+
+void tearDown()
+{
+  // テスト終了時の処理は不要
+}
+
+// 中央値が満杯前・満杯後とも nth_element の結果と一致することを確認
+void test_sliding_median_matches_nth_element()
+{
+  SlidingMedian<int, 6> median;
+  SlidingMedian<int, 31> wideMedian;
+  std::vector<int> history;
+  for (int i = 0; i < 5000; ++i)
+  {
+    int sample = nextRandom(100);
+    history.push_back(sample);
+    median.push(sample);
+    wideMedian.push(sample);
+    TEST_ASSERT_EQUAL_INT(referenceMedian(lastSamples(history, 6)), median.median());
+    TEST_ASSERT_EQUAL_INT(referenceMedian(lastSamples(history, 31)), wideMedian.median());
+  }
+  median.reset();
+  TEST_ASSERT_EQUAL_INT(0, static_cast<int>(median.size()));
+}
+
+// 両極端の値を交互に入れ、追い出す値と新しい値の順位が窓の端から端まで動く場合も nth_element と一致することを確認。
+// 窓が奇数なら毎回最小と最大が入れ替わり（最悪の移動量）、偶数なら同じ値が入れ替わる
+void test_sliding_median_alternating_extremes()
+{
+  SlidingMedian<int, 6> median;
+  SlidingMedian<int, 31> wideMedian;
+  std::vector<int> history;
+  for (int i = 0; i < 500; ++i)
+  {
+    // 両端の値に、途中から中間の値を時々混ぜる
+    int sample = ((i % 2) == 0) ? -100000 : 100000;
+    if (i > 200 && (i % 7) == 0)
+    {
+      sample = nextRandom(100);
+    }
+    history.push_back(sample);
+    median.push(sample);
+    wideMedian.push(sample);
+    TEST_ASSERT_EQUAL_INT(referenceMedian(lastSamples(history, 6)), median.median());
+    TEST_ASSERT_EQUAL_INT(referenceMedian(lastSamples(history, 31)), wideMedian.median());
+    std::vector<int> recent = lastSamples(history, 31);
+    std::sort(recent.begin(), recent.end());
+    TEST_ASSERT_EQUAL_INT(recent.front(), wideMedian.rank(0));
+    TEST_ASSERT_EQUAL_INT(recent.back(), wideMedian.rank(recent.size() - 1));
+  }
+}
+
+// 最大値保持とリセットを確認
+void test_peak_hold()
+{
+  PeakHold<float> peak;
+  peak.update(1.5F);
+  peak.update(0.5F);
+  TEST_ASSERT_EQUAL_FLOAT(1.5F, peak.value());
+  peak.reset();
+  TEST_ASSERT_EQUAL_FLOAT(0.0F, peak.value());
+  TEST_ASSERT_EQUAL_FLOAT(0.7F, peak.update(0.7F));
+}
+
+// 窓の長さごとの中央値の 1 サンプルあたりの時間を計測する（判定はしない）。
+// 値の移動量は順位の変化分なので、窓が長いほど遅くなる
+constexpr int BENCH_ITERATIONS = 200000;
+
+// ALS のようにゆっくり変わる信号
+static auto benchSample(int i) -> int { return 500 + ((i / 64) % 200) + nextRandom(8); }
+
+template <size_t N>
+static void reportMedianCost(long &sink)
+{
+  SlidingMedian<int, N> median;
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < BENCH_ITERATIONS; ++i)
+  {
+    median.push(benchSample(i));
+    sink += median.median();
+  }
+  auto end = std::chrono::steady_clock::now();
+  double medianNs = std::chrono::duration<double, std::nano>(end - start).count() / BENCH_ITERATIONS;
+  char message[96];
+  snprintf(message, sizeof(message), "N=%u: median %.1f ns per sample", static_cast<unsigned>(N), medianNs);
+  TEST_MESSAGE(message);
+}
+
+void test_microbenchmark_window_size()
+{
+  long sink = 0;
+  reportMedianCost<6>(sink);
+  reportMedianCost<64>(sink);
+  reportMedianCost<512>(sink);
+  TEST_ASSERT_GREATER_THAN(0, sink);
+}
+
+void setup()
+{
+  UNITY_BEGIN();
+  RUN_TEST(test_sliding_median_matches_nth_element);
+  RUN_TEST(test_sliding_median_alternating_extremes);
+  RUN_TEST(test_peak_hold);
+  RUN_TEST(test_microbenchmark_window_size);
+  UNITY_END();
+}
+
+void loop() {}
@@ -51,13 +51,11 @@ void test_calculate_average()
 // サンプルバッファ更新のテスト
 void test_update_sample_buffer()
 {
-  float buffer[3] = {};
-  int index = 0;
-  bool first = true;
-  updateSampleBuffer(1.0f, buffer, index, first);
-  updateSampleBuffer(2.0f, buffer, index, first);
+  SensorChannelState<sensorChannelIndex(SensorChannelId::WaterTemp)> buffer;
+  buffer.apply(1.0f, false);
+  buffer.apply(2.0f, false);
   // 初期化後は先頭要素から更新されるため buffer[0] は2になる
-  TEST_ASSERT_FLOAT_WITHIN(0.01f, 2.0f, buffer[0]);
+  TEST_ASSERT_FLOAT_WITHIN(0.01f, 2.0f, buffer.sample(0).toFloat());
 }
 
 // テスト実行
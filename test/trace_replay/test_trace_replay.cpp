@@ -0,0 +1,231 @@
+#include <unity.h>
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+#include "../../include/config.h"
+
+// ────────────────────── テスト用スタブ ──────────────────────
+// SD への記録と FPS 計測は対象外
+int currentFps = 0;
+struct SensorSample;
+void recordSensorSample(const SensorSample & /*sample*/) {}
+
+#include "../../src/modules/adc_scheduler.cpp"
+#include "../../src/modules/backlight.cpp"
+#include "../../src/modules/dirty_region.cpp"
+#include "../../src/modules/display.cpp"
+#include "../../src/modules/fps_display.cpp"
+#include "../../src/modules/glyph_cache.cpp"
+#include "../../src/modules/imu_batch.cpp"
+#include "../../src/modules/low_warning.cpp"
+#include "../../src/modules/racing_indicator.cpp"
+#include "../../src/modules/racing_mode.cpp"
+#include "../../src/modules/sensor.cpp"
+#include "../../src/modules/sensor_trace.cpp"
+#include "../../src/modules/starvation_map.cpp"
+
+// ────────────────────── 合成トレース ──────────────────────
+constexpr uint32_t TRACE_START_MS = 1000;
+constexpr uint32_t TRACE_PERIOD_MS = 10;               // 100Hz で記録した想定
+constexpr uint32_t SESSION_MS = 30UL * 60UL * 1000UL;  // 30 分
+constexpr uint32_t LAP_MS = 90000;                     // 1 周 90 秒
+constexpr unsigned long ACQUIRE_US = SENSOR_TASK_INTERVAL_MS * 1000UL;
+
+// 油圧 [bar] を ADC コードへ（convertVoltageToOilPressure の逆変換）
+static auto pressureToCode(float bar) -> int16_t
+{
+  float voltage = ((bar / 2.5F) + 0.5F) / CORRECTION_FACTOR;
+  return static_cast<int16_t>(std::lround(voltage * ADC_MAX_CODE / ADC_FULL_SCALE_VOLTAGE));
+}
+
+// 温度 [℃] に最も近い ADC コード
+static auto temperatureToCode(float celsius) -> int16_t
+{
+  int best = 0;
+  for (int code = 1; code < ADC_CODE_COUNT; ++code)
+  {
+    if (std::fabs(convertAdcToTemp(static_cast<int16_t>(code)) - celsius) <
+        std::fabs(convertAdcToTemp(static_cast<int16_t>(best)) - celsius))
+    {
+      best = code;
+    }
+  }
+  return static_cast<int16_t>(best);
+}
+
+// 停車 10 秒の後、1 周ごとに「直線→制動→右コーナー（途中で油圧低下）→直線→左コーナー」を繰り返す
+static auto makeTrackSession() -> std::vector<SensorTraceFrame>
+{
+  const int16_t waterCode = temperatureToCode(85.0F);
+  const int16_t oilCode = temperatureToCode(100.0F);
+  std::vector<SensorTraceFrame> frames;
+  frames.reserve(SESSION_MS / TRACE_PERIOD_MS + 1);
+  for (uint32_t t = 0; t <= SESSION_MS; t += TRACE_PERIOD_MS)
+  {
+    float lateral = 0.0F;
+    float longitudinal = 0.0F;
+    float pressure = 4.5F;
+    if (t >= 10000)
+    {
+      uint32_t lap = (t - 10000) % LAP_MS;
+      if (lap >= 20000 && lap < 21500)
+      {
+        longitudinal = -0.9F;  // 制動
+      }
+      else if (lap >= 22000 && lap < 26000)
+      {
+        lateral = 1.2F;
+        // コーナー中盤で 1 秒間だけ油圧が抜ける
+        pressure = (lap >= 23000 && lap < 24000) ? 2.0F : 4.0F;
+      }
+      else if (lap >= 60000 && lap < 63000)
+      {
+        lateral = -1.1F;
+      }
+    }
+
+    SensorTraceFrame frame = {};
+    frame.timestampMs = TRACE_START_MS + t;
+    frame.adc[ADC_CH_OIL_PRESSURE] = pressureToCode(pressure);
+    frame.adc[ADC_CH_WATER_TEMP] = waterCode;
+    frame.adc[ADC_CH_OIL_TEMP] = oilCode;
+    frame.accelX = longitudinal;
+    frame.accelY = lateral;
+    frame.accelZ = 1.0F;
+    frames.push_back(frame);
+  }
+  return frames;
+}
+
+void setUp()
+{
+  // テストごとの初期化は不要
+}
+
+void tearDown()
+{
+  // テスト終了時の処理は不要
+}
+
+// CSV の 1 行を解析し、見出し行や欠けた行は拒否することを確認
+void test_parse_trace_line()
+{
+  SensorTraceFrame frame = {};
+  TEST_ASSERT_TRUE(parseSensorTraceLine("1500,812,700,1024,650,0.05,-1.20,0.98", frame));
+  TEST_ASSERT_EQUAL_UINT32(1500, frame.timestampMs);
+  TEST_ASSERT_EQUAL_INT16(812, frame.adc[0]);
+  TEST_ASSERT_EQUAL_INT16(650, frame.adc[3]);
+  TEST_ASSERT_FLOAT_WITHIN(0.001F, -1.2F, frame.accelY);
+
+  TEST_ASSERT_FALSE(parseSensorTraceLine("time_ms,ch0,ch1,ch2,ch3,ax,ay,az", frame));
+  TEST_ASSERT_FALSE(parseSensorTraceLine("1500,812,700", frame));
+}
+
+// 仮想時計に合わせてフレームが進み、変換完了まで時間がかかることを確認
+void test_replay_follows_virtual_clock()
+{
+  SensorTraceFrame frames[2] = {};
+  frames[0].timestampMs = 100;
+  frames[0].adc[2] = 500;
+  frames[1].timestampMs = 110;
+  frames[1].adc[2] = 900;
+  SensorTraceReplay replay(frames, 2);
+
+  replay.startConversion(2);
+  TEST_ASSERT_FALSE(replay.isConversionReady());
+  replay.advanceUs(SensorTraceReplay::CONVERSION_US);
+  TEST_ASSERT_TRUE(replay.isConversionReady());
+  TEST_ASSERT_EQUAL_INT16(500, replay.readConversionResult());
+
+  replay.advanceUs(10000);
+  TEST_ASSERT_EQUAL_UINT32(110, replay.nowMs());
+  TEST_ASSERT_EQUAL_INT16(900, replay.readConversionResult());
+  TEST_ASSERT_FALSE(replay.isFinished());
+  replay.advanceUs(1000);
+  TEST_ASSERT_TRUE(replay.isFinished());
+}
+
+// 30 分のセッションを取得・反映・描画の実経路で実時間より速く再生し、
+// レーシングモードと低油圧警告が想定どおり発生することを確認
+void test_replay_track_session()
+{
+  std::vector<SensorTraceFrame> frames = makeTrackSession();
+  SensorTraceReplay replay(frames.data(), frames.size());
+  attachSensorTraceReplay(replay);
+  initAdcScheduler();
+
+  headlessNowUs = replay.nowUs();
+  display.init();
+  mainCanvas.setColorDepth(CANVAS_COLOR_DEPTH);
+  mainCanvas.createSprite(LCD_WIDTH, LCD_HEIGHT);
+  initDisplayBuffers();
+  resetGaugeState();
+
+  int racingStarts = 0;
+  int lowEvents = 0;
+  bool wasRacing = false;
+  float peakG = 0.0F;
+  unsigned long nextFrameUs = replay.nowUs() + FRAME_INTERVAL_US;
+
+  auto wallStart = std::chrono::steady_clock::now();
+  while (!replay.isFinished())
+  {
+    // 取得タスク相当（4ms 周期）
+    acquireSensorData();
+    replay.advanceUs(ACQUIRE_US);
+
+    // 描画ループ相当（60fps）
+    if (replay.nowUs() >= nextFrameUs)
+    {
+      nextFrameUs += FRAME_INTERVAL_US;
+      headlessNowUs = replay.nowUs();
+      drainSensorSamples();
+      updateRacingMode(replay.nowMs(), currentGForcePeak);
+      updateGauges();
+
+      peakG = std::max(peakG, currentGForcePeak);
+      if (isRacingMode && !wasRacing)
+      {
+        ++racingStarts;
+      }
+      wasRacing = isRacingMode;
+      // 警告の解除時に直近イベントが更新されるため、数えたら消しておく
+      if (lastLowEventDuration > 0.0F)
+      {
+        ++lowEvents;
+        lastLowEventDuration = 0.0F;
+      }
+    }
+  }
+  double wallSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - wallStart).count();
+  double sessionSeconds = (frames.back().timestampMs - frames.front().timestampMs) / 1000.0;
+
+  TEST_ASSERT_EQUAL_size_t(0, sensorQueueDropCount());
+  TEST_ASSERT_FLOAT_WITHIN(0.05F, 1.2F, peakG);
+  // 90 秒周期で 180 秒継続するため、セッション中に複数回開始する
+  TEST_ASSERT_GREATER_THAN(3, racingStarts);
+  // 油圧低下は各周の右コーナーで 1 回ずつ
+  TEST_ASSERT_INT_WITHIN(1, static_cast<int>((SESSION_MS - 10000) / LAP_MS), lowEvents);
+  TEST_ASSERT_LESS_OR_EQUAL_FLOAT(3.0F, lastLowEventPressure);
+  TEST_ASSERT_GREATER_THAN_FLOAT(1.0F, lastLowEventG);
+  TEST_ASSERT_TRUE(wallSeconds < sessionSeconds);
+
+  char message[128];
+  snprintf(message, sizeof(message), "%.0f s session replayed in %.2f s (%.0fx), %d racing starts, %d low events",
+           sessionSeconds, wallSeconds, sessionSeconds / wallSeconds, racingStarts, lowEvents);
+  TEST_MESSAGE(message);
+}
+
+void setup()
+{
+  UNITY_BEGIN();
+  RUN_TEST(test_parse_trace_line);
+  RUN_TEST(test_replay_follows_virtual_clock);
+  RUN_TEST(test_replay_track_session);
+  UNITY_END();
+}
+
+void loop() {}
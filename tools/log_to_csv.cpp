@@ -0,0 +1,39 @@
+// SD カードのセッションログ (session_XXX.bin) を CSV へ変換するホスト用ツール
+//   g++ -std=gnu++17 -I include tools/log_to_csv.cpp -o log_to_csv
+//   ./log_to_csv session_000.bin > session_000.csv
+#include <cstdio>
+
+#include "../src/modules/session_log.cpp"
+
+int main(int argc, char **argv)
+{
+  if (argc < 2)
+  {
+    fprintf(stderr, "usage: %s <session.bin> [out.csv]\n", argv[0]);
+    return 1;
+  }
+
+  FILE *in = fopen(argv[1], "rb");
+  if (in == nullptr)
+  {
+    perror(argv[1]);
+    return 1;
+  }
+  FILE *out = (argc >= 3) ? fopen(argv[2], "w") : stdout;
+  if (out == nullptr)
+  {
+    perror(argv[2]);
+    fclose(in);
+    return 1;
+  }
+
+  size_t count = decodeSessionLog(in, out);
+  fprintf(stderr, "%zu records\n", count);
+
+  fclose(in);
+  if (out != stdout)
+  {
+    fclose(out);
+  }
+  return 0;
+}